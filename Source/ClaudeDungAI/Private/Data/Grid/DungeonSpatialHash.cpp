@@ -0,0 +1,29 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/DungeonSpatialHash.h"
+
+void FDungeonSpatialHash::Reset(int32 InBucketSize)
+{
+	BucketSize = FMath::Max(InBucketSize, 1);
+	Entries.Reset();
+	Tags.Reset();
+	Buckets.Reset();
+	EntryStamps.Reset();
+	QueryStamp = 0;
+}
+
+int32 FDungeonSpatialHash::Add(const FIntRect& Rect, int32 Tag)
+{
+	const int32 EntryId = Entries.Add(Rect);
+	Tags.Add(Tag);
+	EntryStamps.Add(0);
+	if (Rect.Min.X >= Rect.Max.X || Rect.Min.Y >= Rect.Max.Y) return EntryId;
+
+	const FIntPoint MinBucket = ToBucket(Rect.Min);
+	const FIntPoint MaxBucket = ToBucket(Rect.Max - FIntPoint(1, 1));
+	for (int32 BX = MinBucket.X; BX <= MaxBucket.X; ++BX)
+	{
+		for (int32 BY = MinBucket.Y; BY <= MaxBucket.Y; ++BY) { Buckets.FindOrAdd(FIntPoint(BX, BY)).Add(EntryId); }
+	}
+	return EntryId;
+}
@@ -0,0 +1,182 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/FreeRectIndex.h"
+#include "Data/Grid/GridOccupancy.h"
+
+namespace FreeRectIndex
+{
+	static bool Overlaps(const FIntRect& A, const FIntRect& B)
+	{
+		return A.Min.X < B.Max.X && B.Min.X < A.Max.X && A.Min.Y < B.Max.Y && B.Min.Y < A.Max.Y;
+	}
+
+	static bool Contains(const FIntRect& Outer, const FIntRect& Inner)
+	{
+		return Outer.Min.X <= Inner.Min.X && Outer.Min.Y <= Inner.Min.Y && Inner.Max.X <= Outer.Max.X && Inner.Max.Y <= Outer.Max.Y;
+	}
+
+	static uint64 MakeSpanMask(int32 BitOffset, int32 BitCount)
+	{
+		const uint64 Bits = (BitCount >= 64) ? ~0ull : ((1ull << BitCount) - 1);
+		return Bits << BitOffset;
+	}
+}
+
+void FFreeRectIndex::Build(const FGridOccupancy& Occupancy)
+{
+	GridSize = Occupancy.GetGridSize();
+	Rects.Reset();
+	bValid = true;
+	if (GridSize.X <= 0 || GridSize.Y <= 0) return;
+
+	// Row-by-row histogram of free cells above each column; every maximal rectangle is the widest
+	// rectangle of some column's height on its bottom row that cannot grow one row further down
+	FMemMark ScratchMark(FMemStack::Get());
+	TArray<int32, TMemStackAllocator<>> Heights;
+	TArray<int32, TMemStackAllocator<>> LeftBound;
+	TArray<int32, TMemStackAllocator<>> LeftBoundEqual;
+	TArray<int32, TMemStackAllocator<>> RightBound;
+	TArray<int32, TMemStackAllocator<>> Stack;
+	Heights.SetNumZeroed(GridSize.X);
+	LeftBound.SetNumUninitialized(GridSize.X);
+	LeftBoundEqual.SetNumUninitialized(GridSize.X);
+	RightBound.SetNumUninitialized(GridSize.X);
+	Stack.Reserve(GridSize.X);
+
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			Heights[X] = Occupancy.IsCellOccupied(FIntPoint(X, Y)) ? 0 : Heights[X] + 1;
+		}
+
+		// First column of the run with height >= Heights[X]
+		Stack.Reset();
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			while (Stack.Num() > 0 && Heights[Stack.Last()] >= Heights[X]) { Stack.Pop(EAllowShrinking::No); }
+			LeftBound[X] = Stack.Num() > 0 ? Stack.Last() + 1 : 0;
+			Stack.Add(X);
+		}
+
+		// First column of the run with height > Heights[X]; equals LeftBound only for the leftmost column of that height
+		Stack.Reset();
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			while (Stack.Num() > 0 && Heights[Stack.Last()] > Heights[X]) { Stack.Pop(EAllowShrinking::No); }
+			LeftBoundEqual[X] = Stack.Num() > 0 ? Stack.Last() + 1 : 0;
+			Stack.Add(X);
+		}
+
+		// One past the last column of the run with height >= Heights[X]
+		Stack.Reset();
+		for (int32 X = GridSize.X - 1; X >= 0; --X)
+		{
+			while (Stack.Num() > 0 && Heights[Stack.Last()] >= Heights[X]) { Stack.Pop(EAllowShrinking::No); }
+			RightBound[X] = Stack.Num() > 0 ? Stack.Last() : GridSize.X;
+			Stack.Add(X);
+		}
+
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			const int32 Height = Heights[X];
+			if (Height == 0 || LeftBoundEqual[X] != LeftBound[X]) continue;
+
+			const int32 Width = RightBound[X] - LeftBound[X];
+
+			// Not maximal if the row below is free across the whole span
+			if (Y + 1 < GridSize.Y && Occupancy.IsRectFree(FIntPoint(LeftBound[X], Y + 1), FIntPoint(Width, 1))) continue;
+
+			Rects.Add(FIntRect(LeftBound[X], Y - Height + 1, RightBound[X], Y + 1));
+		}
+	}
+}
+
+void FFreeRectIndex::Invalidate()
+{
+	Rects.Reset();
+	bValid = false;
+}
+
+void FFreeRectIndex::Occupy(FIntPoint StartCoord, FIntPoint Size)
+{
+	if (!bValid) return;
+
+	const FIntRect Used(
+		FMath::Max(StartCoord.X, 0), FMath::Max(StartCoord.Y, 0),
+		FMath::Min(StartCoord.X + Size.X, GridSize.X), FMath::Min(StartCoord.Y + Size.Y, GridSize.Y));
+	if (Used.Min.X >= Used.Max.X || Used.Min.Y >= Used.Max.Y) return;
+
+	// Replace each overlapped rectangle with up to four maximal pieces around the used area (runs per placement: no heap)
+	TArray<FIntRect, TInlineAllocator<16>> Split;
+	for (int32 i = Rects.Num() - 1; i >= 0; --i)
+	{
+		const FIntRect Free = Rects[i];
+		if (!FreeRectIndex::Overlaps(Free, Used)) continue;
+
+		Rects.RemoveAtSwap(i, EAllowShrinking::No);
+		if (Used.Min.X > Free.Min.X) Split.Add(FIntRect(Free.Min.X, Free.Min.Y, Used.Min.X, Free.Max.Y));
+		if (Used.Max.X < Free.Max.X) Split.Add(FIntRect(Used.Max.X, Free.Min.Y, Free.Max.X, Free.Max.Y));
+		if (Used.Min.Y > Free.Min.Y) Split.Add(FIntRect(Free.Min.X, Free.Min.Y, Free.Max.X, Used.Min.Y));
+		if (Used.Max.Y < Free.Max.Y) Split.Add(FIntRect(Free.Min.X, Used.Max.Y, Free.Max.X, Free.Max.Y));
+	}
+
+	// Pieces are subsets of removed rectangles, so only they can be redundant
+	for (int32 i = 0; i < Split.Num(); ++i)
+	{
+		bool bRedundant = false;
+		for (const FIntRect& Kept : Rects)
+		{
+			if (FreeRectIndex::Contains(Kept, Split[i])) { bRedundant = true; break; }
+		}
+		for (int32 j = 0; j < Split.Num() && !bRedundant; ++j)
+		{
+			if (i == j || !FreeRectIndex::Contains(Split[j], Split[i])) continue;
+
+			// Identical pieces: keep the first one only
+			bRedundant = Split[j] != Split[i] || j < i;
+		}
+		if (!bRedundant) Rects.Add(Split[i]);
+	}
+}
+
+void FFreeRectIndex::GatherAnchors(FIntPoint Size, TArray<FIntPoint, TMemStackAllocator<>>& OutAnchors) const
+{
+	OutAnchors.Reset();
+	if (Size.X <= 0 || Size.Y <= 0) return;
+
+	if (GridSize.X <= 0 || GridSize.Y <= 0) return;
+
+	// One bit per cell marks anchors already emitted; overlapping rectangles are masked off a word at a time,
+	// so each anchor is written once and shared spans cost one AND per row instead of one visit per cell
+	const int32 WordsPerRow = (GridSize.X + 63) / 64;
+	TArray<uint64, TMemStackAllocator<>> Emitted;
+	Emitted.SetNumZeroed(WordsPerRow * GridSize.Y);
+
+	for (const FIntRect& Free : Rects)
+	{
+		// Last anchor (inclusive) that keeps Size inside this rectangle
+		const int32 LastX = Free.Max.X - Size.X;
+		const int32 LastY = Free.Max.Y - Size.Y;
+		if (LastX < Free.Min.X || LastY < Free.Min.Y) continue;
+
+		for (int32 Y = Free.Min.Y; Y <= LastY; ++Y)
+		{
+			uint64* Row = Emitted.GetData() + Y * WordsPerRow;
+			for (int32 WordIndex = Free.Min.X >> 6; WordIndex <= LastX >> 6; ++WordIndex)
+			{
+				const int32 SpanStart = FMath::Max(Free.Min.X, WordIndex * 64);
+				const int32 SpanEnd = FMath::Min(LastX + 1, (WordIndex + 1) * 64);
+				const uint64 Span = FreeRectIndex::MakeSpanMask(SpanStart & 63, SpanEnd - SpanStart);
+
+				uint64 Fresh = Span & ~Row[WordIndex];
+				Row[WordIndex] |= Span;
+				while (Fresh)
+				{
+					OutAnchors.Add(FIntPoint(WordIndex * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Fresh)), Y));
+					Fresh &= Fresh - 1;
+				}
+			}
+		}
+	}
+}
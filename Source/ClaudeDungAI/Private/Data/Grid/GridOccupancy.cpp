@@ -0,0 +1,168 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/GridOccupancy.h"
+
+void FGridOccupancy::Init(FIntPoint InGridSize)
+{
+	GridSize = FIntPoint(FMath::Max(InGridSize.X, 0), FMath::Max(InGridSize.Y, 0));
+	WordsPerRow = (GridSize.X + 63) / 64;
+
+	Words.Reset();
+	Words.SetNumZeroed(WordsPerRow * GridSize.Y);
+
+	// Empty grid: an all-zero table is exact
+	SummedArea.Reset();
+	SummedArea.SetNumZeroed((GridSize.X + 1) * (GridSize.Y + 1));
+	bSummedAreaValid = true;
+}
+
+void FGridOccupancy::Reset()
+{
+	FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+
+	// All cells free again, so a zeroed table is exact
+	FMemory::Memzero(SummedArea.GetData(), SummedArea.Num() * sizeof(int32));
+	bSummedAreaValid = SummedArea.Num() > 0;
+}
+
+void FGridOccupancy::Empty()
+{
+	Words.Empty();
+	SummedArea.Empty();
+	bSummedAreaValid = false;
+	GridSize = FIntPoint::ZeroValue;
+	WordsPerRow = 0;
+}
+
+bool FGridOccupancy::IsCellOccupied(FIntPoint Cell) const
+{
+	if (Cell.X < 0 || Cell.X >= GridSize.X || Cell.Y < 0 || Cell.Y >= GridSize.Y) return true;
+
+	const uint64 Word = Words[Cell.Y * WordsPerRow + (Cell.X >> 6)];
+	return (Word >> (Cell.X & 63)) & 1ull;
+}
+
+void FGridOccupancy::SetCell(FIntPoint Cell, bool bOccupied)
+{
+	if (Cell.X < 0 || Cell.X >= GridSize.X || Cell.Y < 0 || Cell.Y >= GridSize.Y) return;
+
+	uint64& Word = Words[Cell.Y * WordsPerRow + (Cell.X >> 6)];
+	const uint64 Bit = 1ull << (Cell.X & 63);
+	if (!bOccupied && (Word & Bit)) bSummedAreaValid = false;
+	Word = bOccupied ? (Word | Bit) : (Word & ~Bit);
+}
+
+bool FGridOccupancy::IsRectFree(FIntPoint StartCoord, FIntPoint Size) const
+{
+	// Whole rectangle must be inside the grid
+	if (Size.X <= 0 || Size.Y <= 0) return false;
+	if (StartCoord.X < 0 || StartCoord.Y < 0) return false;
+	if (StartCoord.X + Size.X > GridSize.X || StartCoord.Y + Size.Y > GridSize.Y) return false;
+
+	// O(1) rejection: anything counted by the table is still occupied
+	if (bSummedAreaValid && SummedAreaCount(StartCoord, Size) > 0) return false;
+
+	return IsRectFreeBits(StartCoord, Size);
+}
+
+bool FGridOccupancy::IsRectFreeBits(FIntPoint StartCoord, FIntPoint Size) const
+{
+	const int32 FirstWord = StartCoord.X >> 6;
+	const int32 LastWord = (StartCoord.X + Size.X - 1) >> 6;
+
+	// Common case: span lives inside one word, build the mask once and test each row
+	if (FirstWord == LastWord)
+	{
+		const uint64 Mask = MakeSpanMask(StartCoord.X & 63, Size.X);
+		const uint64* Row = Words.GetData() + StartCoord.Y * WordsPerRow + FirstWord;
+
+		for (int32 Y = 0; Y < Size.Y; ++Y, Row += WordsPerRow)
+		{
+			if (*Row & Mask) return false;
+		}
+		return true;
+	}
+
+	// Wide span: test each word the span touches
+	for (int32 Y = StartCoord.Y; Y < StartCoord.Y + Size.Y; ++Y)
+	{
+		const uint64* Row = Words.GetData() + Y * WordsPerRow;
+		for (int32 WordIndex = FirstWord; WordIndex <= LastWord; ++WordIndex)
+		{
+			const int32 SpanStart = FMath::Max(StartCoord.X, WordIndex * 64);
+			const int32 SpanEnd = FMath::Min(StartCoord.X + Size.X, (WordIndex + 1) * 64);
+			if (Row[WordIndex] & MakeSpanMask(SpanStart & 63, SpanEnd - SpanStart)) return false;
+		}
+	}
+	return true;
+}
+
+void FGridOccupancy::SetRect(FIntPoint StartCoord, FIntPoint Size, bool bOccupied)
+{
+	// Clip to grid bounds
+	const int32 MinX = FMath::Max(StartCoord.X, 0);
+	const int32 MinY = FMath::Max(StartCoord.Y, 0);
+	const int32 MaxX = FMath::Min(StartCoord.X + Size.X, GridSize.X);
+	const int32 MaxY = FMath::Min(StartCoord.Y + Size.Y, GridSize.Y);
+	if (MinX >= MaxX || MinY >= MaxY) return;
+	if (!bOccupied) bSummedAreaValid = false;
+
+	for (int32 Y = MinY; Y < MaxY; ++Y)
+	{
+		uint64* Row = Words.GetData() + Y * WordsPerRow;
+		for (int32 WordIndex = MinX >> 6; WordIndex <= (MaxX - 1) >> 6; ++WordIndex)
+		{
+			const int32 SpanStart = FMath::Max(MinX, WordIndex * 64);
+			const int32 SpanEnd = FMath::Min(MaxX, (WordIndex + 1) * 64);
+			const uint64 Mask = MakeSpanMask(SpanStart & 63, SpanEnd - SpanStart);
+			Row[WordIndex] = bOccupied ? (Row[WordIndex] | Mask) : (Row[WordIndex] & ~Mask);
+		}
+	}
+}
+
+int32 FGridOccupancy::CountOccupied() const
+{
+	int32 Count = 0;
+	for (const uint64 Word : Words) { Count += FMath::CountBits(Word); }
+	return Count;
+}
+
+void FGridOccupancy::RebuildSummedAreaTable()
+{
+	const int32 Stride = GridSize.X + 1;
+	SummedArea.SetNumZeroed(Stride * (GridSize.Y + 1));
+
+	// S(x+1, y+1) = cell(x, y) + S(x, y+1) + S(x+1, y) - S(x, y), computed as running row sums
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		const uint64* Row = Words.GetData() + Y * WordsPerRow;
+		const int32* Above = SummedArea.GetData() + Y * Stride;
+		int32* Current = SummedArea.GetData() + (Y + 1) * Stride;
+
+		int32 RowSum = 0;
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			RowSum += static_cast<int32>((Row[X >> 6] >> (X & 63)) & 1ull);
+			Current[X + 1] = Above[X + 1] + RowSum;
+		}
+	}
+	bSummedAreaValid = true;
+}
+
+int32 FGridOccupancy::SummedAreaCount(FIntPoint StartCoord, FIntPoint Size) const
+{
+	const int32 Stride = GridSize.X + 1;
+	const int32 X0 = StartCoord.X;
+	const int32 Y0 = StartCoord.Y;
+	const int32 X1 = StartCoord.X + Size.X;
+	const int32 Y1 = StartCoord.Y + Size.Y;
+
+	return SummedArea[Y1 * Stride + X1] - SummedArea[Y0 * Stride + X1] - SummedArea[Y1 * Stride + X0] + SummedArea[Y0 * Stride + X0];
+}
+
+uint64 FGridOccupancy::MakeSpanMask(int32 BitOffset, int32 BitCount)
+{
+	if (BitCount <= 0) return 0;
+	const uint64 Bits = (BitCount >= 64) ? ~0ull : ((1ull << BitCount) - 1);
+	return Bits << BitOffset;
+}
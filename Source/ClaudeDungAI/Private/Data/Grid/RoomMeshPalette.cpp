@@ -0,0 +1,40 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Data/Grid/RoomMeshPalette.h"
+#include "Engine/StaticMesh.h"
+
+FRoomMeshId FRoomMeshPalette::Intern(const TSoftObjectPtr<UStaticMesh>& Mesh)
+{
+	if (Mesh.IsNull()) return InvalidId;
+
+	const FSoftObjectPath& Path = Mesh.ToSoftObjectPath();
+	if (const FRoomMeshId* Existing = IdsByPath.Find(Path)) return *Existing;
+
+	if (Meshes.Num() >= InvalidId)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRoomMeshPalette::Intern - Palette full, cannot add %s"), *Path.ToString());
+		return InvalidId;
+	}
+
+	const FRoomMeshId NewId = static_cast<FRoomMeshId>(Meshes.Add(Mesh));
+	IdsByPath.Add(Path, NewId);
+	return NewId;
+}
+
+FRoomMeshId FRoomMeshPalette::Find(const TSoftObjectPtr<UStaticMesh>& Mesh) const
+{
+	const FRoomMeshId* Existing = Mesh.IsNull() ? nullptr : IdsByPath.Find(Mesh.ToSoftObjectPath());
+	return Existing ? *Existing : InvalidId;
+}
+
+const TSoftObjectPtr<UStaticMesh>& FRoomMeshPalette::GetMesh(FRoomMeshId Id) const
+{
+	static const TSoftObjectPtr<UStaticMesh> NullMesh;
+	return IsValidId(Id) ? Meshes[Id] : NullMesh;
+}
+
+void FRoomMeshPalette::Reset()
+{
+	Meshes.Reset();
+	IdsByPath.Reset();
+}
@@ -113,4 +113,50 @@ const FPresetRegion* URoomPreset::GetRegionAtCoordinate(FIntPoint GridCoordinate
 	}
 
 	return FoundRegion;
+}
+
+void URoomPreset::BuildRegionRaster(FIntPoint GridSize, TArray<uint8>& OutRaster) const
+{
+	OutRaster.Reset();
+	if (GridSize.X <= 0 || GridSize.Y <= 0) return;
+	OutRaster.Init(NoRegion, GridSize.X * GridSize.Y);
+
+	const int32 StorableRegions = FMath::Min(Regions.Num(), static_cast<int32>(NoRegion));
+	if (Regions.Num() > StorableRegions)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("PresetRoomLayout '%s': %d regions, only the first %d fit the region raster"),
+			*GetName(), Regions.Num(), StorableRegions);
+	}
+
+	// Paint lowest priority first so higher priorities overwrite; among equal priorities the earlier region
+	// must win (GetRegionAtCoordinate keeps the first strict maximum), so it is painted last
+	TArray<int32, TInlineAllocator<32>> PaintOrder;
+	for (int32 RegionIndex = 0; RegionIndex < StorableRegions; ++RegionIndex)
+	{
+		// The linear scan starts at priority -1 with a strict compare, so negative priorities never win
+		if (Regions[RegionIndex].FillPriority >= 0) PaintOrder.Add(RegionIndex);
+	}
+	PaintOrder.Sort([this](int32 A, int32 B)
+	{
+		const int32 PriorityA = Regions[A].FillPriority;
+		const int32 PriorityB = Regions[B].FillPriority;
+		return PriorityA != PriorityB ? PriorityA < PriorityB : A > B;
+	});
+
+	for (const int32 RegionIndex : PaintOrder)
+	{
+		const FPresetRegion& Region = Regions[RegionIndex];
+		const int32 MinX = FMath::Max(Region.StartCell.X, 0);
+		const int32 MinY = FMath::Max(Region.StartCell.Y, 0);
+		const int32 MaxX = FMath::Min(Region.EndCell.X, GridSize.X - 1);
+		const int32 MaxY = FMath::Min(Region.EndCell.Y, GridSize.Y - 1);
+
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				OutRaster[Y * GridSize.X + X] = static_cast<uint8>(RegionIndex);
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -2,3 +2,30 @@
 
 
 #include "ClaudeDungAI/Public/Data/Room/CeilingData.h"
+
+void UCeilingData::EnsureSamplers() const
+{
+	if (bSamplersBuilt) return;
+
+	auto GetWeight = [](const FCeilingTile& Tile) { return Tile.PlacementWeight; };
+	LargeTileSampler.BuildFromPool(LargeTilePool, GetWeight);
+	MediumTileSampler.BuildFromPool(MediumTilePool, GetWeight);
+	SmallTileSampler.BuildFromPool(SmallTilePool, GetWeight);
+	bSamplersBuilt = true;
+}
+
+void UCeilingData::InvalidateSamplers() const
+{
+	LargeTileSampler.Reset();
+	MediumTileSampler.Reset();
+	SmallTileSampler.Reset();
+	bSamplersBuilt = false;
+}
+
+#if WITH_EDITOR
+void UCeilingData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateSamplers();
+}
+#endif
@@ -2,3 +2,62 @@
 
 
 #include "ClaudeDungAI/Public/Data/Room/FloorData.h"
+#include "Data/Grid/GridData.h"
+
+FIntPoint UFloorData::GetTileFootprint(const FMeshPlacementInfo& MeshInfo)
+{
+	// Explicit footprint, otherwise default 1x1 (mesh bounds are not read here)
+	if (MeshInfo.GridFootprint.X > 0 && MeshInfo.GridFootprint.Y > 0) return MeshInfo.GridFootprint;
+	return FIntPoint(1, 1);
+}
+
+const FFloorFootprintBucket* UFloorData::FindFootprintBucket(FIntPoint Size) const
+{
+	return GetFootprintBuckets().Find(Size);
+}
+
+const TMap<FIntPoint, FFloorFootprintBucket>& UFloorData::GetFootprintBuckets() const
+{
+	if (!bSamplersBuilt) BuildSamplers();
+	return FootprintBuckets;
+}
+
+void UFloorData::InvalidateSamplers() const
+{
+	FootprintBuckets.Reset();
+	bSamplersBuilt = false;
+}
+
+void UFloorData::BuildSamplers() const
+{
+	FootprintBuckets.Reset();
+
+	// A tile serves its own footprint and the rotated one
+	for (int32 TileIndex = 0; TileIndex < FloorTilePool.Num(); ++TileIndex)
+	{
+		const FIntPoint Footprint = GetTileFootprint(FloorTilePool[TileIndex]);
+		FootprintBuckets.FindOrAdd(Footprint).TileIndices.Add(TileIndex);
+		if (Footprint.X != Footprint.Y)
+		{
+			FootprintBuckets.FindOrAdd(FIntPoint(Footprint.Y, Footprint.X)).TileIndices.Add(TileIndex);
+		}
+	}
+
+	for (TPair<FIntPoint, FFloorFootprintBucket>& Pair : FootprintBuckets)
+	{
+		FFloorFootprintBucket& Bucket = Pair.Value;
+		TArray<float, TInlineAllocator<16>> Weights;
+		for (const int32 TileIndex : Bucket.TileIndices) { Weights.Add(FloorTilePool[TileIndex].PlacementWeight); }
+		Bucket.Sampler.Build(Weights);
+	}
+
+	bSamplersBuilt = true;
+}
+
+#if WITH_EDITOR
+void UFloorData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateSamplers();
+}
+#endif
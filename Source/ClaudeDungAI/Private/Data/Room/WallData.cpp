@@ -2,3 +2,87 @@
 
 
 #include "ClaudeDungAI/Public/Data/Room/WallData.h"
+#include "Data/Grid/GridData.h"
+#include "Utilities/Helpers/DungeonGenerationHelpers.h"
+
+const FWeightedAliasTable& UWallData::GetModuleSampler() const
+{
+	if (!bSamplersBuilt) BuildSamplers();
+	return ModuleSampler;
+}
+
+const TMap<int32, FWallFootprintBucket>& UWallData::GetFootprintBuckets() const
+{
+	if (!bSamplersBuilt) BuildSamplers();
+	return FootprintBuckets;
+}
+
+const FWallRunPacker& UWallData::GetRunPacker(int32 MaxRunLength) const
+{
+	if (!bSamplersBuilt) BuildSamplers();
+	RunPacker.EnsureLength(MaxRunLength);
+	return RunPacker;
+}
+
+void UWallData::InvalidateSamplers() const
+{
+	ModuleSampler.Reset();
+	FootprintBuckets.Reset();
+	RunPacker.Reset();
+	bSamplersBuilt = false;
+}
+
+FTransform UWallData::GetSocketTransform(UStaticMesh* Mesh, FName SocketName, const FVector& FallbackOffset) const
+{
+	if (!Mesh) return FTransform(FallbackOffset);
+
+	const TPair<TObjectKey<UStaticMesh>, FName> Key(Mesh, SocketName);
+	const TOptional<FTransform>* Cached = SocketTransformCache.Find(Key);
+	if (!Cached)
+	{
+		FVector SocketLocation;
+		FRotator SocketRotation;
+		TOptional<FTransform> SocketTransform;
+		if (UDungeonGenerationHelpers::GetMeshSocketTransform(Mesh, SocketName, SocketLocation, SocketRotation))
+		{
+			SocketTransform = FTransform(SocketRotation, SocketLocation);
+		}
+		Cached = &SocketTransformCache.Add(Key, SocketTransform);
+	}
+
+	return Cached->IsSet() ? Cached->GetValue() : FTransform(FallbackOffset);
+}
+
+void UWallData::BuildSamplers() const
+{
+	ModuleSampler.BuildFromPool(AvailableWallModules, [](const FWallModule& Module) { return Module.PlacementWeight; });
+
+	FootprintBuckets.Reset();
+	for (int32 ModuleIndex = 0; ModuleIndex < AvailableWallModules.Num(); ++ModuleIndex)
+	{
+		const int32 Footprint = AvailableWallModules[ModuleIndex].Y_AxisFootprint;
+		if (Footprint > 0) FootprintBuckets.FindOrAdd(Footprint).ModuleIndices.Add(ModuleIndex);
+	}
+
+	TArray<int32, TInlineAllocator<8>> Footprints;
+	for (TPair<int32, FWallFootprintBucket>& Pair : FootprintBuckets)
+	{
+		FWallFootprintBucket& Bucket = Pair.Value;
+		TArray<float, TInlineAllocator<16>> Weights;
+		for (const int32 ModuleIndex : Bucket.ModuleIndices) { Weights.Add(AvailableWallModules[ModuleIndex].PlacementWeight); }
+		Bucket.Sampler.Build(Weights);
+		Footprints.Add(Pair.Key);
+	}
+	RunPacker.Build(Footprints);
+
+	bSamplersBuilt = true;
+}
+
+#if WITH_EDITOR
+void UWallData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateSamplers();
+	InvalidateSocketCache();
+}
+#endif
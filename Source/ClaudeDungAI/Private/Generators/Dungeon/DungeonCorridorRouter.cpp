@@ -0,0 +1,423 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generators/Dungeon/DungeonCorridorRouter.h"
+#include "Generators/Dungeon/DungeonGenerator.h"
+#include "Utilities/Helpers/DungeonGenerationHelpers.h"
+#include "Algo/Reverse.h"
+
+namespace DungeonCorridorRouter
+{
+	// Octile distance (diagonal steps cost sqrt 2)
+	static float OctileDistance(FIntPoint Delta)
+	{
+		const int32 DX = FMath::Abs(Delta.X);
+		const int32 DY = FMath::Abs(Delta.Y);
+		return (float)FMath::Max(DX, DY) + (UE_SQRT_2 - 1.0f) * (float)FMath::Min(DX, DY);
+	}
+
+	static FIntPoint SignOf(FIntPoint Delta)
+	{
+		return FIntPoint(FMath::Sign(Delta.X), FMath::Sign(Delta.Y));
+	}
+
+	struct FOpenNode
+	{
+		float F;
+		int32 Index;
+	};
+
+	struct FOpenNodeLess
+	{
+		bool operator()(const FOpenNode& A, const FOpenNode& B) const { return A.F < B.F; }
+	};
+}
+
+FDungeonCorridorRouter::FDungeonCorridorRouter()
+	: Layout(nullptr)
+	, GridOrigin(FIntPoint::ZeroValue)
+	, GridSize(FIntPoint::ZeroValue)
+	, MaxExpansions(200000)
+	, SearchStamp(0)
+{
+}
+
+void FDungeonCorridorRouter::Build(const FDungeonLayout& InLayout, int32 Margin)
+{
+	Layout = &InLayout;
+	Margin = FMath::Max(Margin, 1);
+	GridOrigin = InLayout.Bounds.Min - FIntPoint(Margin, Margin);
+	GridSize = InLayout.Bounds.Size() + FIntPoint(2 * Margin, 2 * Margin);
+
+	// One bitset of room footprints; every clearance mask is derived from it
+	BlockedMask.Init(GridSize);
+	for (const FDungeonRoomNode& Room : InLayout.Rooms)
+	{
+		const FIntRect Footprint = Room.GetFootprint();
+		BlockedMask.SetRect(Footprint.Min - GridOrigin, Footprint.Size(), true);
+	}
+	BlockedMask.RebuildSummedAreaTable();
+
+	ClearanceMasks.Reset();
+	CorridorMask.Init(GridSize);
+	DoorwayMask.Init(GridSize);
+	CorridorCells.Reset();
+	Corridors.Reset();
+
+	const int32 NumCells = GridSize.X * GridSize.Y;
+	GScores.SetNumUninitialized(NumCells);
+	Parents.SetNumUninitialized(NumCells);
+	SeenStamps.Init(0, NumCells);
+	ClosedStamps.Init(0, NumCells);
+	CellStamps.Init(0, NumCells);
+	SearchStamp = 0;
+}
+
+int32 FDungeonCorridorRouter::RouteAll()
+{
+	if (!Layout)
+	{ UE_LOG(LogTemp, Error, TEXT("FDungeonCorridorRouter::RouteAll - Router not built!")); return 0; }
+
+	const double StartTime = FPlatformTime::Seconds();
+	Corridors.Reset();
+	Corridors.Reserve(Layout->Connections.Num());
+
+	int32 NumSearched = 0;
+	int32 NumFailed = 0;
+	for (int32 ConnectionIndex = 0; ConnectionIndex < Layout->Connections.Num(); ++ConnectionIndex)
+	{
+		FDungeonCorridor Corridor;
+		if (!RouteConnection(ConnectionIndex, Corridor)) { ++NumFailed; continue; }
+
+		if (Corridor.bSearched) ++NumSearched;
+		Corridors.Add(MoveTemp(Corridor));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FDungeonCorridorRouter::RouteAll - Routed %d corridors (%d searched, %d failed), %d floor cells in %.2f ms"),
+		Corridors.Num(), NumSearched, NumFailed, CorridorCells.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return Corridors.Num();
+}
+
+bool FDungeonCorridorRouter::RouteConnection(int32 ConnectionIndex, FDungeonCorridor& OutCorridor)
+{
+	if (!Layout || !Layout->Connections.IsValidIndex(ConnectionIndex)) return false;
+
+	const FDungeonConnection& Connection = Layout->Connections[ConnectionIndex];
+	const FDungeonRoomNode& RoomA = Layout->Rooms[Connection.RoomA];
+	const FDungeonRoomNode& RoomB = Layout->Rooms[Connection.RoomB];
+	const FDoorwayLayoutInfo& DoorA = RoomA.Doorways[Connection.DoorwayA];
+	const FDoorwayLayoutInfo& DoorB = RoomB.Doorways[Connection.DoorwayB];
+
+	OutCorridor = FDungeonCorridor();
+	OutCorridor.ConnectionIndex = ConnectionIndex;
+	OutCorridor.Width = FMath::Max(FMath::Min(DoorA.WidthInCells, DoorB.WidthInCells), 1);
+	const int32 Width = OutCorridor.Width;
+	++SearchStamp;
+
+	// Doorway openings stay unwalled whether or not a corridor reaches them
+	for (int32 Offset = 0; Offset < DoorA.WidthInCells; ++Offset) { DoorwayMask.SetCell(UDungeonGenerator::GetDoorwayDungeonCell(RoomA, DoorA, Offset) - GridOrigin, true); }
+	for (int32 Offset = 0; Offset < DoorB.WidthInCells; ++Offset) { DoorwayMask.SetCell(UDungeonGenerator::GetDoorwayDungeonCell(RoomB, DoorB, Offset) - GridOrigin, true); }
+
+	// First opening cell of each doorway (lowest lateral coordinate) and the step out of the room
+	const FIntPoint FirstA = UDungeonGenerator::GetDoorwayDungeonCell(RoomA, DoorA, 0) - GridOrigin;
+	const FIntPoint FirstB = UDungeonGenerator::GetDoorwayDungeonCell(RoomB, DoorB, 0) - GridOrigin;
+	const FIntPoint StepA = UDungeonGenerator::GetEdgeOutwardStep(DoorA.Edge);
+	const FIntPoint StepB = UDungeonGenerator::GetEdgeOutwardStep(DoorB.Edge);
+
+	// Facing doorways on the same lateral span: a straight strip, no search
+	if (StepA == -StepB && DoorA.WidthInCells == DoorB.WidthInCells)
+	{
+		const FIntPoint Delta = FirstB - FirstA;
+		const int32 Distance = Delta.X * StepA.X + Delta.Y * StepA.Y;
+		const bool bAligned = (StepA.X != 0 ? Delta.Y : Delta.X) == 0;
+		if (bAligned && Distance >= 2)
+		{
+			const int32 Length = Distance - 1;
+			const FIntPoint StripMin = (StepA.X + StepA.Y > 0) ? FirstA + StepA : FirstA + StepA * Length;
+			const FIntPoint StripSize = StepA.X != 0 ? FIntPoint(Length, Width) : FIntPoint(Width, Length);
+			if (BlockedMask.IsRectFree(StripMin, StripSize))
+			{
+				for (int32 X = 0; X < StripSize.X; ++X)
+				{
+					for (int32 Y = 0; Y < StripSize.Y; ++Y) { StampCell(StripMin + FIntPoint(X, Y), OutCorridor); }
+				}
+				return true;
+			}
+		}
+	}
+
+	// The searched point is the min corner of a Width x Width square whose near side touches the opening
+	auto AnchorFor = [Width](FIntPoint First, FIntPoint Step) { return (Step.X + Step.Y > 0) ? First + Step : First + Step * Width; };
+	const FIntPoint StartAnchor = AnchorFor(FirstA, StepA);
+	const FIntPoint GoalAnchor = AnchorFor(FirstB, StepB);
+
+	const FGridOccupancy& Clearance = GetClearanceMask(Width);
+	if (Clearance.IsCellOccupied(StartAnchor) || Clearance.IsCellOccupied(GoalAnchor))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDungeonCorridorRouter - Connection %d: no room for a %d-wide corridor in front of a doorway"), ConnectionIndex, Width);
+		return false;
+	}
+
+	TArray<FIntPoint> JumpPoints;
+	if (!FindPath(Clearance, StartAnchor, GoalAnchor, JumpPoints))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FDungeonCorridorRouter - Connection %d (rooms %d -> %d): no path"), ConnectionIndex, Connection.RoomA, Connection.RoomB);
+		return false;
+	}
+
+	// Walk the straight/diagonal runs between jump points; diagonal steps go through an orthogonal neighbour
+	// (free by the no-corner-cutting rule) so the floor stays 4-connected
+	StampSquare(JumpPoints[0], Width, OutCorridor);
+	for (int32 PointIndex = 1; PointIndex < JumpPoints.Num(); ++PointIndex)
+	{
+		const FIntPoint Target = JumpPoints[PointIndex];
+		const FIntPoint Direction = DungeonCorridorRouter::SignOf(Target - JumpPoints[PointIndex - 1]);
+		FIntPoint Cell = JumpPoints[PointIndex - 1];
+		while (Cell != Target)
+		{
+			if (Direction.X != 0 && Direction.Y != 0) StampSquare(Cell + FIntPoint(Direction.X, 0), Width, OutCorridor);
+			Cell += Direction;
+			StampSquare(Cell, Width, OutCorridor);
+		}
+	}
+
+	OutCorridor.bSearched = true;
+	return true;
+}
+
+void FDungeonCorridorRouter::EmitPlacements(const TSoftObjectPtr<UStaticMesh>& FloorMesh, const TSoftObjectPtr<UStaticMesh>& WallMesh,
+	FRoomMeshPalette& Palette, FMeshInstanceBuffers& OutFloorInstances, FMeshInstanceBuffers& OutWallInstances) const
+{
+	const FRoomMeshId FloorId = Palette.Intern(FloorMesh);
+	const FRoomMeshId WallId = Palette.Intern(WallMesh);
+	OutFloorInstances.Reset(Palette.Num());
+	OutWallInstances.Reset(Palette.Num());
+
+	static constexpr EWallEdge Sides[] = { EWallEdge::North, EWallEdge::South, EWallEdge::East, EWallEdge::West };
+	for (const FIntPoint& Cell : CorridorCells)
+	{
+		const FIntPoint DungeonCell = Cell + GridOrigin;
+		const FVector CellCenter((DungeonCell.X + 0.5f) * CELL_SIZE, (DungeonCell.Y + 0.5f) * CELL_SIZE, 0.0f);
+		OutFloorInstances.Add(FloorId, FTransform(FRotator::ZeroRotator, CellCenter, FVector::OneVector));
+
+		for (EWallEdge Side : Sides)
+		{
+			const FIntPoint Step = UDungeonGenerator::GetEdgeOutwardStep(Side);
+			const FIntPoint Neighbour = Cell + Step;
+			const bool bInGrid = Neighbour.X >= 0 && Neighbour.Y >= 0 && Neighbour.X < GridSize.X && Neighbour.Y < GridSize.Y;
+			if (bInGrid && (CorridorMask.IsCellOccupied(Neighbour) || DoorwayMask.IsCellOccupied(Neighbour))) continue;
+
+			// On the shared cell boundary, facing back into the corridor (same convention as a room's edge walls)
+			const FVector BoundaryOffset(Step.X * CELL_SIZE * 0.5f, Step.Y * CELL_SIZE * 0.5f, 0.0f);
+			OutWallInstances.Add(WallId, FTransform(UDungeonGenerationHelpers::GetWallRotationForEdge(Side), CellCenter + BoundaryOffset, FVector::OneVector));
+		}
+	}
+}
+
+#pragma region Internal Helpers
+const FGridOccupancy& FDungeonCorridorRouter::GetClearanceMask(int32 Width)
+{
+	if (const FGridOccupancy* Existing = ClearanceMasks.Find(Width)) return *Existing;
+
+	// Anchor blocked when its square touches a footprint or leaves the grid (summed-area test per cell)
+	FGridOccupancy& Clearance = ClearanceMasks.Add(Width);
+	Clearance.Init(GridSize);
+	const FIntPoint Square(Width, Width);
+	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	{
+		for (int32 X = 0; X < GridSize.X; ++X)
+		{
+			if (!BlockedMask.IsRectFree(FIntPoint(X, Y), Square)) Clearance.SetCell(FIntPoint(X, Y), true);
+		}
+	}
+	return Clearance;
+}
+
+bool FDungeonCorridorRouter::FindPath(const FGridOccupancy& Clearance, FIntPoint Start, FIntPoint Goal, TArray<FIntPoint>& OutJumpPoints)
+{
+	using namespace DungeonCorridorRouter;
+
+	TArray<FOpenNode> OpenHeap;
+	TArray<FIntPoint, TInlineAllocator<8>> Directions;
+
+	const int32 StartIndex = ToIndex(Start);
+	GScores[StartIndex] = 0.0f;
+	Parents[StartIndex] = INDEX_NONE;
+	SeenStamps[StartIndex] = SearchStamp;
+	OpenHeap.HeapPush({ OctileDistance(Goal - Start), StartIndex }, FOpenNodeLess());
+
+	int32 Expansions = 0;
+	while (OpenHeap.Num() > 0)
+	{
+		FOpenNode Node;
+		OpenHeap.HeapPop(Node, FOpenNodeLess(), EAllowShrinking::No);
+		if (ClosedStamps[Node.Index] == SearchStamp) continue;
+		ClosedStamps[Node.Index] = SearchStamp;
+
+		const FIntPoint Cell = ToCell(Node.Index);
+		if (Cell == Goal)
+		{
+			for (int32 Index = Node.Index; Index != INDEX_NONE; Index = Parents[Index]) { OutJumpPoints.Add(ToCell(Index)); }
+			Algo::Reverse(OutJumpPoints);
+			return true;
+		}
+		if (++Expansions > MaxExpansions) break;
+
+		// Travel direction into this node decides which neighbours can still lead somewhere new
+		const FIntPoint Direction = Parents[Node.Index] == INDEX_NONE ? FIntPoint::ZeroValue : SignOf(Cell - ToCell(Parents[Node.Index]));
+		GetPrunedDirections(Clearance, Cell, Direction, Directions);
+
+		for (const FIntPoint& Step : Directions)
+		{
+			FIntPoint JumpPoint;
+			if (!Jump(Clearance, Cell + Step, Step, Goal, JumpPoint)) continue;
+
+			const int32 JumpIndex = ToIndex(JumpPoint);
+			if (ClosedStamps[JumpIndex] == SearchStamp) continue;
+
+			const float G = GScores[Node.Index] + OctileDistance(JumpPoint - Cell);
+			if (SeenStamps[JumpIndex] != SearchStamp || G < GScores[JumpIndex])
+			{
+				SeenStamps[JumpIndex] = SearchStamp;
+				GScores[JumpIndex] = G;
+				Parents[JumpIndex] = Node.Index;
+				OpenHeap.HeapPush({ G + OctileDistance(Goal - JumpPoint), JumpIndex }, FOpenNodeLess());
+			}
+		}
+	}
+
+	return false;
+}
+
+bool FDungeonCorridorRouter::Jump(const FGridOccupancy& Clearance, FIntPoint Cell, FIntPoint Direction, FIntPoint Goal, FIntPoint& OutJumpPoint) const
+{
+	auto IsWalkable = [&Clearance](int32 X, int32 Y) { return !Clearance.IsCellOccupied(FIntPoint(X, Y)); };
+	const int32 DX = Direction.X;
+	const int32 DY = Direction.Y;
+
+	// Iterative along the run; a diagonal run only recurses one level into its two straight scans
+	while (true)
+	{
+		const int32 X = Cell.X;
+		const int32 Y = Cell.Y;
+		if (!IsWalkable(X, Y)) return false;
+		if (Cell == Goal) { OutJumpPoint = Cell; return true; }
+
+		if (DX != 0 && DY != 0)
+		{
+			FIntPoint Unused;
+			if (Jump(Clearance, FIntPoint(X + DX, Y), FIntPoint(DX, 0), Goal, Unused) || Jump(Clearance, FIntPoint(X, Y + DY), FIntPoint(0, DY), Goal, Unused))
+			{
+				OutJumpPoint = Cell;
+				return true;
+			}
+		}
+		else if (DX != 0)
+		{
+			// Forced neighbour: a side cell opens up right after an obstacle beside the previous cell
+			if ((IsWalkable(X, Y - 1) && !IsWalkable(X - DX, Y - 1)) || (IsWalkable(X, Y + 1) && !IsWalkable(X - DX, Y + 1)))
+			{
+				OutJumpPoint = Cell;
+				return true;
+			}
+		}
+		else
+		{
+			if ((IsWalkable(X - 1, Y) && !IsWalkable(X - 1, Y - DY)) || (IsWalkable(X + 1, Y) && !IsWalkable(X + 1, Y - DY)))
+			{
+				OutJumpPoint = Cell;
+				return true;
+			}
+		}
+
+		// No corner cutting: a diagonal step needs both orthogonal cells free (for straight runs this tests the next cell)
+		if (!(IsWalkable(X + DX, Y) && IsWalkable(X, Y + DY))) return false;
+		Cell += Direction;
+	}
+}
+
+void FDungeonCorridorRouter::GetPrunedDirections(const FGridOccupancy& Clearance, FIntPoint Cell, FIntPoint Direction,
+	TArray<FIntPoint, TInlineAllocator<8>>& OutDirections) const
+{
+	auto IsWalkable = [&Clearance](int32 X, int32 Y) { return !Clearance.IsCellOccupied(FIntPoint(X, Y)); };
+	const int32 X = Cell.X;
+	const int32 Y = Cell.Y;
+	const int32 DX = Direction.X;
+	const int32 DY = Direction.Y;
+	OutDirections.Reset();
+
+	if (DX == 0 && DY == 0)
+	{
+		for (int32 StepX = -1; StepX <= 1; ++StepX)
+		{
+			for (int32 StepY = -1; StepY <= 1; ++StepY)
+			{
+				if (StepX == 0 && StepY == 0) continue;
+				if (StepX != 0 && StepY != 0 && !(IsWalkable(X + StepX, Y) && IsWalkable(X, Y + StepY))) continue;
+				if (IsWalkable(X + StepX, Y + StepY)) OutDirections.Add(FIntPoint(StepX, StepY));
+			}
+		}
+		return;
+	}
+
+	if (DX != 0 && DY != 0)
+	{
+		const bool bAlongX = IsWalkable(X + DX, Y);
+		const bool bAlongY = IsWalkable(X, Y + DY);
+		if (bAlongY) OutDirections.Add(FIntPoint(0, DY));
+		if (bAlongX) OutDirections.Add(FIntPoint(DX, 0));
+		if (bAlongX && bAlongY) OutDirections.Add(FIntPoint(DX, DY));
+	}
+	else if (DX != 0)
+	{
+		const bool bNext = IsWalkable(X + DX, Y);
+		const bool bUp = IsWalkable(X, Y + 1);
+		const bool bDown = IsWalkable(X, Y - 1);
+		if (bNext)
+		{
+			OutDirections.Add(FIntPoint(DX, 0));
+			if (bUp) OutDirections.Add(FIntPoint(DX, 1));
+			if (bDown) OutDirections.Add(FIntPoint(DX, -1));
+		}
+		if (bUp) OutDirections.Add(FIntPoint(0, 1));
+		if (bDown) OutDirections.Add(FIntPoint(0, -1));
+	}
+	else
+	{
+		const bool bNext = IsWalkable(X, Y + DY);
+		const bool bRight = IsWalkable(X + 1, Y);
+		const bool bLeft = IsWalkable(X - 1, Y);
+		if (bNext)
+		{
+			OutDirections.Add(FIntPoint(0, DY));
+			if (bRight) OutDirections.Add(FIntPoint(1, DY));
+			if (bLeft) OutDirections.Add(FIntPoint(-1, DY));
+		}
+		if (bRight) OutDirections.Add(FIntPoint(1, 0));
+		if (bLeft) OutDirections.Add(FIntPoint(-1, 0));
+	}
+}
+
+void FDungeonCorridorRouter::StampSquare(FIntPoint Anchor, int32 Width, FDungeonCorridor& Corridor)
+{
+	for (int32 X = 0; X < Width; ++X)
+	{
+		for (int32 Y = 0; Y < Width; ++Y) { StampCell(Anchor + FIntPoint(X, Y), Corridor); }
+	}
+}
+
+void FDungeonCorridorRouter::StampCell(FIntPoint Cell, FDungeonCorridor& Corridor)
+{
+	const int32 Index = ToIndex(Cell);
+	if (CellStamps[Index] != SearchStamp)
+	{
+		CellStamps[Index] = SearchStamp;
+		Corridor.Cells.Add(Cell + GridOrigin);
+	}
+
+	if (!CorridorMask.IsCellOccupied(Cell))
+	{
+		CorridorMask.SetCell(Cell, true);
+		CorridorCells.Add(Cell);
+	}
+}
+#pragma endregion
@@ -2,3 +2,377 @@
 
 
 #include "Generators/Dungeon/DungeonGenerator.h"
+#include "Data/Grid/DungeonSpatialHash.h"
+#include "Data/Room/RoomData.h"
+#include "Utilities/Helpers/DungeonGenerationHelpers.h"
+#include "Utilities/Helpers/WeightedAliasTable.h"
+
+namespace DungeonLayout
+{
+	// Spatial hash tag for corridor reservations (rooms are tagged with their index)
+	static constexpr int32 CorridorTag = -1;
+
+	// Cells kept between a doorway and the room's corners
+	static constexpr int32 DoorwayCornerMargin = 1;
+
+	static constexpr EWallEdge AllEdges[] = { EWallEdge::North, EWallEdge::South, EWallEdge::East, EWallEdge::West };
+
+	static uint8 EdgeBit(EWallEdge Edge) { return (uint8)(1 << (uint8)Edge); }
+
+	// North/South walls run along Y, their outward normal is X
+	static bool IsNormalAlongX(EWallEdge Edge) { return Edge == EWallEdge::North || Edge == EWallEdge::South; }
+
+	// Start and length of the room interior along the wall's running axis
+	static int32 GetLateralMin(const FDungeonRoomNode& Room, EWallEdge Edge) { return IsNormalAlongX(Edge) ? Room.GridOrigin.Y : Room.GridOrigin.X; }
+	static int32 GetLateralLength(const FDungeonRoomNode& Room, EWallEdge Edge) { return IsNormalAlongX(Edge) ? Room.GridSize.Y : Room.GridSize.X; }
+
+	// Rectangle from (NormalMin, LateralMin) with the given extents, in dungeon X/Y
+	static FIntRect MakeEdgeRect(EWallEdge Edge, int32 NormalMin, int32 NormalLength, int32 LateralMin, int32 LateralLength)
+	{
+		return IsNormalAlongX(Edge)
+			? FIntRect(FIntPoint(NormalMin, LateralMin), FIntPoint(NormalMin + NormalLength, LateralMin + LateralLength))
+			: FIntRect(FIntPoint(LateralMin, NormalMin), FIntPoint(LateralMin + LateralLength, NormalMin + NormalLength));
+	}
+
+	static FIntRect ExpandRect(const FIntRect& Rect, int32 Amount)
+	{
+		return FIntRect(Rect.Min - FIntPoint(Amount, Amount), Rect.Max + FIntPoint(Amount, Amount));
+	}
+
+	static FIntPoint RandomTemplateSize(const FDungeonRoomTemplate& Template, FRandomStream& Stream)
+	{
+		const FIntPoint MinSize(FMath::Max(Template.MinGridSize.X, 4), FMath::Max(Template.MinGridSize.Y, 4));
+		const FIntPoint MaxSize(FMath::Max(Template.MaxGridSize.X, MinSize.X), FMath::Max(Template.MaxGridSize.Y, MinSize.Y));
+		return FIntPoint(Stream.RandRange(MinSize.X, MaxSize.X), Stream.RandRange(MinSize.Y, MaxSize.Y));
+	}
+}
+
+#pragma region Layout Generation
+bool UDungeonGenerator::GenerateLayout(const FDungeonLayoutSettings& Settings, int32 Seed)
+{
+	using namespace DungeonLayout;
+
+	const double StartTime = FPlatformTime::Seconds();
+	ClearLayout();
+	Layout.Seed = Seed;
+
+	// Only templates that can actually produce a room take part in the draw
+	TArray<const FDungeonRoomTemplate*> Templates;
+	for (const FDungeonRoomTemplate& Template : Settings.RoomTemplates)
+	{
+		if (!Template.RoomData)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DungeonGenerator: Skipping room template without RoomData"));
+			continue;
+		}
+		if (Template.Weight > 0.0f) { Templates.Add(&Template); }
+	}
+	if (Templates.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("DungeonGenerator: No usable room templates"));
+		return false;
+	}
+
+	FWeightedAliasTable TemplateTable;
+	TemplateTable.BuildFromPool(Templates, [](const FDungeonRoomTemplate* Template) { return Template->Weight; });
+
+	FRandomStream Stream(Seed);
+	FDungeonSpatialHash SpatialHash(Settings.SpatialHashBucketSize);
+	const int32 NumRooms = FMath::Max(Settings.NumRooms, 1);
+	Layout.Rooms.Reserve(NumRooms);
+	UsedEdgeMasks.Reserve(NumRooms);
+
+	// First room sits at the dungeon origin
+	{
+		const FDungeonRoomTemplate& Template = *Templates[TemplateTable.Sample(Stream)];
+		FDungeonRoomNode& Root = Layout.Rooms.AddDefaulted_GetRef();
+		Root.RoomData = Template.RoomData;
+		Root.GridSize = RandomTemplateSize(Template, Stream);
+		Root.Seed = DeriveRoomSeed(Seed, 0);
+		UsedEdgeMasks.Add(0);
+		SpatialHash.Add(Root.GetFootprint(), 0);
+	}
+
+	// Grow outward from rooms that still have a free wall; a room is retired once its walls are used up
+	// or it has failed MaxPlacementAttempts times, so total work is bounded by NumRooms * MaxPlacementAttempts
+	TArray<int32> OpenRooms;
+	TArray<int32> FailedAttempts;
+	OpenRooms.Add(0);
+	FailedAttempts.Add(0);
+	const int32 MaxAttempts = FMath::Max(Settings.MaxPlacementAttempts, 1);
+
+	while (Layout.Rooms.Num() < NumRooms && OpenRooms.Num() > 0)
+	{
+		const int32 OpenSlot = Stream.RandHelper(OpenRooms.Num());
+		const int32 ParentIndex = OpenRooms[OpenSlot];
+
+		EWallEdge FreeEdges[4];
+		int32 NumFreeEdges = 0;
+		for (EWallEdge Edge : AllEdges)
+		{
+			if (!(UsedEdgeMasks[ParentIndex] & EdgeBit(Edge))) { FreeEdges[NumFreeEdges++] = Edge; }
+		}
+		if (NumFreeEdges == 0 || FailedAttempts[ParentIndex] >= MaxAttempts)
+		{
+			OpenRooms.RemoveAtSwap(OpenSlot);
+			continue;
+		}
+
+		const EWallEdge Edge = FreeEdges[Stream.RandHelper(NumFreeEdges)];
+		const FDungeonRoomTemplate& Template = *Templates[TemplateTable.Sample(Stream)];
+		const int32 NewIndex = TryAttachRoom(ParentIndex, Edge, Template, Settings, SpatialHash, Stream);
+		if (NewIndex == INDEX_NONE)
+		{
+			++FailedAttempts[ParentIndex];
+			continue;
+		}
+
+		OpenRooms.Add(NewIndex);
+		FailedAttempts.Add(0);
+	}
+
+	const int32 NumLoops = AddLoopConnections(Settings, SpatialHash, Stream);
+
+	// Bounds over everything the hash holds (room footprints and corridors)
+	Layout.Bounds = SpatialHash.GetRect(0);
+	for (int32 EntryId = 1; EntryId < SpatialHash.Num(); ++EntryId)
+	{
+		const FIntRect& Rect = SpatialHash.GetRect(EntryId);
+		Layout.Bounds.Min = Layout.Bounds.Min.ComponentMin(Rect.Min);
+		Layout.Bounds.Max = Layout.Bounds.Max.ComponentMax(Rect.Max);
+	}
+
+	if (Layout.Rooms.Num() < NumRooms)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DungeonGenerator: Only %d of %d rooms fit (raise MaxPlacementAttempts or the corridor length range)"),
+			Layout.Rooms.Num(), NumRooms);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("DungeonGenerator: Placed %d rooms, %d connections (%d loops), bounds %dx%d cells in %.2f ms"),
+		Layout.Rooms.Num(), Layout.Connections.Num(), NumLoops, Layout.Bounds.Width(), Layout.Bounds.Height(),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return Layout.Rooms.Num() > 0;
+}
+
+void UDungeonGenerator::ClearLayout()
+{
+	Layout = FDungeonLayout();
+	UsedEdgeMasks.Reset();
+}
+#pragma endregion
+
+#pragma region Coordinate Conversion
+int32 UDungeonGenerator::DeriveRoomSeed(int32 LayoutSeed, int32 RoomIndex)
+{
+	// SplitMix64 finalizer over (seed, index): neighbouring rooms get unrelated streams
+	uint64 Z = ((uint64)(uint32)LayoutSeed << 32 | (uint32)RoomIndex) + 0x9E3779B97F4A7C15ull;
+	Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+	return (int32)(uint32)(Z ^ (Z >> 31));
+}
+
+FIntPoint UDungeonGenerator::GetDoorwayDungeonCell(const FDungeonRoomNode& Room, const FDoorwayLayoutInfo& Doorway, int32 Offset)
+{
+	return Room.GridOrigin + UDungeonGenerationHelpers::GetEdgeCell(Doorway.Edge, Doorway.StartCell + Offset, Room.GridSize);
+}
+
+FIntPoint UDungeonGenerator::GetEdgeOutwardStep(EWallEdge Edge)
+{
+	switch (Edge)
+	{
+	case EWallEdge::North: return FIntPoint(1, 0);
+	case EWallEdge::South: return FIntPoint(-1, 0);
+	case EWallEdge::East:  return FIntPoint(0, 1);
+	case EWallEdge::West:  return FIntPoint(0, -1);
+	default:               return FIntPoint::ZeroValue;
+	}
+}
+
+EWallEdge UDungeonGenerator::GetOppositeEdge(EWallEdge Edge)
+{
+	switch (Edge)
+	{
+	case EWallEdge::North: return EWallEdge::South;
+	case EWallEdge::South: return EWallEdge::North;
+	case EWallEdge::East:  return EWallEdge::West;
+	case EWallEdge::West:  return EWallEdge::East;
+	default:               return EWallEdge::None;
+	}
+}
+#pragma endregion
+
+#pragma region Internal Helpers
+int32 UDungeonGenerator::TryAttachRoom(int32 ParentIndex, EWallEdge Edge, const FDungeonRoomTemplate& Template,
+	const FDungeonLayoutSettings& Settings, FDungeonSpatialHash& SpatialHash, FRandomStream& Stream)
+{
+	using namespace DungeonLayout;
+
+	FDungeonRoomNode Child;
+	Child.RoomData = Template.RoomData;
+	Child.GridSize = RandomTemplateSize(Template, Stream);
+
+	const FDungeonRoomNode& Parent = Layout.Rooms[ParentIndex];
+	const int32 Width = GetSharedDoorwayWidth(Parent, Child);
+	const int32 NeededSpan = Width + 2 * DoorwayCornerMargin;
+	const int32 ParentLateralMin = GetLateralMin(Parent, Edge);
+	const int32 ParentLateralLength = GetLateralLength(Parent, Edge);
+	const int32 ChildLateralLength = GetLateralLength(Child, Edge);
+	if (ParentLateralLength < NeededSpan || ChildLateralLength < NeededSpan) return INDEX_NONE;
+
+	// Slide the child along the wall so at least one doorway's worth of wall is shared
+	const int32 ChildLateralMin = Stream.RandRange(ParentLateralMin + NeededSpan - ChildLateralLength, ParentLateralMin + ParentLateralLength - NeededSpan);
+	const int32 CorridorLength = Stream.RandRange(FMath::Max(Settings.MinCorridorLength, 1), FMath::Max(Settings.MaxCorridorLength, Settings.MinCorridorLength));
+
+	// Corridor runs from the cell past the parent's wall ring to the cell before the child's
+	int32 CorridorNormalMin = 0;
+	int32 ChildNormalMin = 0;
+	switch (Edge)
+	{
+	case EWallEdge::North:
+		CorridorNormalMin = Parent.GridOrigin.X + Parent.GridSize.X + 1;
+		ChildNormalMin = CorridorNormalMin + CorridorLength + 1;
+		break;
+	case EWallEdge::South:
+		CorridorNormalMin = Parent.GridOrigin.X - 1 - CorridorLength;
+		ChildNormalMin = CorridorNormalMin - 1 - Child.GridSize.X;
+		break;
+	case EWallEdge::East:
+		CorridorNormalMin = Parent.GridOrigin.Y + Parent.GridSize.Y + 1;
+		ChildNormalMin = CorridorNormalMin + CorridorLength + 1;
+		break;
+	case EWallEdge::West:
+		CorridorNormalMin = Parent.GridOrigin.Y - 1 - CorridorLength;
+		ChildNormalMin = CorridorNormalMin - 1 - Child.GridSize.Y;
+		break;
+	default:
+		return INDEX_NONE;
+	}
+	Child.GridOrigin = IsNormalAlongX(Edge) ? FIntPoint(ChildNormalMin, ChildLateralMin) : FIntPoint(ChildLateralMin, ChildNormalMin);
+
+	// Both doorways share the same lateral cells, so the corridor is a straight strip
+	const int32 SharedMin = FMath::Max(ParentLateralMin, ChildLateralMin) + DoorwayCornerMargin;
+	const int32 SharedMax = FMath::Min(ParentLateralMin + ParentLateralLength, ChildLateralMin + ChildLateralLength) - DoorwayCornerMargin;
+	const int32 DoorwayStart = Stream.RandRange(SharedMin, SharedMax - Width);
+	const FIntRect CorridorRect = MakeEdgeRect(Edge, CorridorNormalMin, CorridorLength, DoorwayStart, Width);
+
+	// Padded child footprint must clear everything but its parent (which it faces across the corridor)
+	const FIntRect ChildFootprint = Child.GetFootprint();
+	if (SpatialHash.AnyOverlapping(ExpandRect(ChildFootprint, Settings.RoomPadding), [ParentIndex](int32 Tag) { return Tag != ParentIndex; }))
+	{
+		return INDEX_NONE;
+	}
+	if (SpatialHash.AnyOverlapping(CorridorRect, [](int32) { return true; })) return INDEX_NONE;
+
+	Child.Depth = Parent.Depth + 1;
+	const int32 ChildIndex = Layout.Rooms.Num();
+	Child.Seed = DeriveRoomSeed(Layout.Seed, ChildIndex);
+	Layout.Rooms.Add(MoveTemp(Child));
+	UsedEdgeMasks.Add(0);
+
+	SpatialHash.Add(ChildFootprint, ChildIndex);
+	SpatialHash.Add(CorridorRect, CorridorTag);
+	AddConnection(ParentIndex, Edge, ChildIndex, DoorwayStart, Width, false);
+	return ChildIndex;
+}
+
+int32 UDungeonGenerator::AddLoopConnections(const FDungeonLayoutSettings& Settings, FDungeonSpatialHash& SpatialHash, FRandomStream& Stream)
+{
+	using namespace DungeonLayout;
+	if (Settings.LoopChance <= 0.0f) return 0;
+
+	// Only +X/+Y walls look for a partner, so every facing pair is considered once
+	static constexpr EWallEdge SearchEdges[] = { EWallEdge::North, EWallEdge::East };
+	const int32 MaxCorridorLength = FMath::Max(Settings.MaxCorridorLength, 1);
+	int32 NumAdded = 0;
+
+	for (int32 RoomIndex = 0; RoomIndex < Layout.Rooms.Num(); ++RoomIndex)
+	{
+		for (EWallEdge Edge : SearchEdges)
+		{
+			if (UsedEdgeMasks[RoomIndex] & EdgeBit(Edge)) continue;
+			if (Stream.FRand() >= Settings.LoopChance) continue;
+
+			const FDungeonRoomNode& Room = Layout.Rooms[RoomIndex];
+			const bool bAlongX = IsNormalAlongX(Edge);
+			const int32 RingNormal = bAlongX ? Room.GridOrigin.X + Room.GridSize.X : Room.GridOrigin.Y + Room.GridSize.Y;
+			const int32 LateralMin = GetLateralMin(Room, Edge);
+			const int32 LateralLength = GetLateralLength(Room, Edge);
+
+			// Nearest room whose wall ring starts within corridor range in front of this wall
+			const FIntRect Probe = MakeEdgeRect(Edge, RingNormal + 1, MaxCorridorLength + 1, LateralMin, LateralLength);
+			int32 NearestRoom = INDEX_NONE;
+			int32 NearestGap = MAX_int32;
+			SpatialHash.ForEachOverlapping(Probe, [&](int32, const FIntRect& Rect, int32 Tag)
+			{
+				if (Tag < 0 || Tag == RoomIndex) return true;
+				const int32 Gap = (bAlongX ? Rect.Min.X : Rect.Min.Y) - RingNormal - 1;
+				if (Gap >= 1 && Gap < NearestGap)
+				{
+					NearestGap = Gap;
+					NearestRoom = Tag;
+				}
+				return true;
+			});
+			if (NearestRoom == INDEX_NONE) continue;
+			if (UsedEdgeMasks[NearestRoom] & EdgeBit(GetOppositeEdge(Edge))) continue;
+
+			const FDungeonRoomNode& Other = Layout.Rooms[NearestRoom];
+			const int32 Width = GetSharedDoorwayWidth(Room, Other);
+			const int32 SharedMin = FMath::Max(LateralMin, GetLateralMin(Other, Edge)) + DoorwayCornerMargin;
+			const int32 SharedMax = FMath::Min(LateralMin + LateralLength, GetLateralMin(Other, Edge) + GetLateralLength(Other, Edge)) - DoorwayCornerMargin;
+			if (SharedMax - SharedMin < Width) continue;
+
+			const int32 DoorwayStart = Stream.RandRange(SharedMin, SharedMax - Width);
+			const FIntRect CorridorRect = MakeEdgeRect(Edge, RingNormal + 1, NearestGap, DoorwayStart, Width);
+			if (SpatialHash.AnyOverlapping(CorridorRect, [](int32) { return true; })) continue;
+
+			SpatialHash.Add(CorridorRect, CorridorTag);
+			AddConnection(RoomIndex, Edge, NearestRoom, DoorwayStart, Width, true);
+			++NumAdded;
+		}
+	}
+
+	return NumAdded;
+}
+
+void UDungeonGenerator::AddConnection(int32 RoomA, EWallEdge EdgeA, int32 RoomB, int32 LateralStart, int32 Width, bool bIsLoop)
+{
+	using namespace DungeonLayout;
+
+	auto MakeDoorway = [LateralStart, Width](const FDungeonRoomNode& Room, EWallEdge Edge)
+	{
+		FDoorwayLayoutInfo Doorway;
+		Doorway.Edge = Edge;
+		Doorway.StartCell = LateralStart - GetLateralMin(Room, Edge);
+		Doorway.WidthInCells = Width;
+		Doorway.DoorData = Room.RoomData ? Room.RoomData->DefaultDoorData : nullptr;
+		Doorway.bIsStandardDoorway = true;
+		return Doorway;
+	};
+
+	const EWallEdge EdgeB = GetOppositeEdge(EdgeA);
+	FDungeonRoomNode& NodeA = Layout.Rooms[RoomA];
+	FDungeonRoomNode& NodeB = Layout.Rooms[RoomB];
+
+	FDungeonConnection Connection;
+	Connection.RoomA = RoomA;
+	Connection.DoorwayA = NodeA.Doorways.Add(MakeDoorway(NodeA, EdgeA));
+	Connection.RoomB = RoomB;
+	Connection.DoorwayB = NodeB.Doorways.Add(MakeDoorway(NodeB, EdgeB));
+	Connection.bIsLoop = bIsLoop;
+
+	const int32 ConnectionIndex = Layout.Connections.Add(Connection);
+	NodeA.Connections.Add(ConnectionIndex);
+	NodeB.Connections.Add(ConnectionIndex);
+	UsedEdgeMasks[RoomA] |= EdgeBit(EdgeA);
+	UsedEdgeMasks[RoomB] |= EdgeBit(EdgeB);
+}
+
+int32 UDungeonGenerator::GetSharedDoorwayWidth(const FDungeonRoomNode& A, const FDungeonRoomNode& B)
+{
+	const int32 WidthA = A.RoomData ? A.RoomData->StandardDoorwayWidth : 4;
+	const int32 WidthB = B.RoomData ? B.RoomData->StandardDoorwayWidth : 4;
+	return FMath::Clamp(FMath::Min(WidthA, WidthB), 2, 8);
+}
+#pragma endregion
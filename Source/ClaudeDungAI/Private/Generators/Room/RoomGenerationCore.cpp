@@ -0,0 +1,2395 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generators/Room/RoomGenerationCore.h"
+#include "Utilities/Helpers/DungeonGenerationHelpers.h"
+#include "Data/Room/FloorData.h"
+#include "Async/ParallelFor.h"
+
+namespace RoomGeneratorSeeds
+{
+	// Salts for each generation phase's stream
+	enum class EPhase : uint32 { Floor = 1, Walls, Doorways, Ceiling, Clutter, PresetRegions };
+
+	// SplitMix64 finaliser: neighbouring seeds and salts give unrelated streams
+	static int32 DeriveStreamSeed(int32 Seed, EPhase Phase)
+	{
+		uint64 Z = ((uint64)(uint32)Seed << 32 | (uint32)Phase) + 0x9E3779B97F4A7C15ull;
+		Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+		return (int32)(uint32)(Z ^ (Z >> 31));
+	}
+
+	// Seed of a preset region's own core (one salt per region after the phase salts)
+	static int32 DeriveRegionSeed(int32 Seed, int32 RegionIndex)
+	{
+		return DeriveStreamSeed(Seed, (EPhase)((uint32)EPhase::PresetRegions + (uint32)RegionIndex));
+	}
+}
+
+FRoomGenerationCore::FRoomGenerationCore()
+	: GridSize(FIntPoint::ZeroValue)
+	, CellSize(CELL_SIZE)
+	, bIsInitialized(false)
+	, RoomSeed(0)
+	, bEmitInstanceBuffers(false)
+	, bFloorInstancesDirty(true)
+	, bWallInstancesDirty(true)
+	, bCornerInstancesDirty(true)
+	, bCeilingInstancesDirty(true)
+	, LargeTilesPlaced(0)
+	, MediumTilesPlaced(0)
+	, SmallTilesPlaced(0)
+	, FillerTilesPlaced(0)
+{
+}
+
+void FRoomGenerationCore::Initialize(FIntPoint InGridSize, int32 InSeed)
+{
+	GridSize = InGridSize;
+	CellSize = CELL_SIZE;
+	bIsInitialized = true;
+	SetSeed(InSeed);
+
+	// Initialize statistics
+	LargeTilesPlaced = 0;
+	MediumTilesPlaced = 0;
+	SmallTilesPlaced = 0;
+	FillerTilesPlaced = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::Initialize - Initialized with GridSize (%d, %d), CellSize %.2f, Seed %d"), 
+	GridSize.X, GridSize.Y, CellSize, RoomSeed);
+}
+
+void FRoomGenerationCore::SetSnapshot(TSharedPtr<const FRoomGenerationSnapshot> InSnapshot)
+{
+	Snapshot = MoveTemp(InSnapshot);
+}
+
+void FRoomGenerationCore::SetSeed(int32 InSeed)
+{
+	using namespace RoomGeneratorSeeds;
+
+	RoomSeed = InSeed;
+	FloorStream.Initialize(DeriveStreamSeed(RoomSeed, EPhase::Floor));
+	WallStream.Initialize(DeriveStreamSeed(RoomSeed, EPhase::Walls));
+	DoorwayStream.Initialize(DeriveStreamSeed(RoomSeed, EPhase::Doorways));
+	CeilingStream.Initialize(DeriveStreamSeed(RoomSeed, EPhase::Ceiling));
+	ClutterStream.Initialize(DeriveStreamSeed(RoomSeed, EPhase::Clutter));
+}
+
+bool FRoomGenerationCore::GenerateAll()
+{
+	if (!bIsInitialized || !Snapshot.IsValid())
+	{ UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateAll - Not initialized or no snapshot!")); return false; }
+
+	CreateGrid();
+
+	// Floor and walls are required; corners and ceiling are optional styles
+	const bool bFloor = GenerateFloor();
+	const bool bWalls = GenerateWalls();
+	GenerateCorners();
+	if (Snapshot->bHasCeilingStyle) GenerateCeiling();
+
+	if (bEmitInstanceBuffers) PackInstanceBuffers();
+
+	return bFloor && bWalls;
+}
+
+#pragma region Instance Buffers
+const FMeshInstanceBuffers& FRoomGenerationCore::GetFloorInstances() const
+{
+	if (bFloorInstancesDirty)
+	{
+		FloorInstances.Reset(MeshPalette.Num());
+		for (const FPlacedMeshInfo& PlacedMesh : PlacedFloorMeshes) { FloorInstances.Add(PlacedMesh.MeshId, PlacedMesh.GetLocalTransform(CellSize)); }
+		bFloorInstancesDirty = false;
+	}
+	return FloorInstances;
+}
+
+const FMeshInstanceBuffers& FRoomGenerationCore::GetWallInstances() const
+{
+	if (bWallInstancesDirty)
+	{
+		// Layers that were not placed carry an invalid id and are skipped, so their unused transforms never reach a buffer
+		WallInstances.Reset(MeshPalette.Num());
+		for (const FPlacedWallInfo& PlacedWall : PlacedWallMeshes)
+		{
+			WallInstances.Add(PlacedWall.BaseMeshId, PlacedWall.BottomTransform);
+			WallInstances.Add(PlacedWall.Middle1MeshId, PlacedWall.Middle1Transform);
+			WallInstances.Add(PlacedWall.Middle2MeshId, PlacedWall.Middle2Transform);
+			WallInstances.Add(PlacedWall.TopMeshId, PlacedWall.TopTransform);
+		}
+		bWallInstancesDirty = false;
+	}
+	return WallInstances;
+}
+
+const FMeshInstanceBuffers& FRoomGenerationCore::GetCornerInstances() const
+{
+	if (bCornerInstancesDirty)
+	{
+		CornerInstances.Reset(MeshPalette.Num());
+		for (const FPlacedCornerInfo& PlacedCorner : PlacedCornerMeshes) { CornerInstances.Add(PlacedCorner.CornerMeshId, PlacedCorner.Transform); }
+		bCornerInstancesDirty = false;
+	}
+	return CornerInstances;
+}
+
+const FMeshInstanceBuffers& FRoomGenerationCore::GetCeilingInstances() const
+{
+	if (bCeilingInstancesDirty)
+	{
+		CeilingInstances.Reset(MeshPalette.Num());
+		for (const FPlacedCeilingInfo& PlacedTile : PlacedCeilingTiles) { CeilingInstances.Add(PlacedTile.MeshId, PlacedTile.Transform); }
+		bCeilingInstancesDirty = false;
+	}
+	return CeilingInstances;
+}
+
+void FRoomGenerationCore::PackInstanceBuffers() const
+{
+	GetFloorInstances();
+	GetWallInstances();
+	GetCornerInstances();
+	GetCeilingInstances();
+}
+#pragma endregion
+
+#pragma region Room Grid Management
+void FRoomGenerationCore::CreateGrid()
+{
+	if (!bIsInitialized) { UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::CreateGrid - Generator not initialized!")); return; }
+
+	// Calculate total cells needed
+	int32 TotalCells = GridSize.X * GridSize.Y;
+
+	// Initialize grid with all cells set to Empty
+	GridState.Empty(TotalCells);
+	GridState.AddUninitialized(TotalCells);
+
+	for (int32 i = 0; i < TotalCells; ++i) { GridState[i] = EGridCellType::ECT_Empty; }
+	OccupancyMask.Init(GridSize);
+	FreeRectIndex.Invalidate();
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::CreateGrid - Created grid with %d cells"), TotalCells);
+}
+
+void FRoomGenerationCore::ClearGrid()
+{
+	GridState.Empty();
+	OccupancyMask.Empty();
+	FreeRectIndex.Invalidate();
+	PlacedFloorMeshes. Empty();
+	PlacedWallMeshes.Empty();
+	ResetBaseWallSegments();
+	bFloorInstancesDirty = true;
+	bWallInstancesDirty = true;
+
+	// Reset statistics
+	LargeTilesPlaced = 0;
+	MediumTilesPlaced = 0;
+	SmallTilesPlaced = 0;
+	FillerTilesPlaced = 0;
+	
+	bIsInitialized = false;
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::ClearGrid - Grid cleared"));
+}
+
+void FRoomGenerationCore::ResetGridCellStates()
+{
+	if (! bIsInitialized)
+	{ UE_LOG(LogTemp, Warning, TEXT("FRoomGenerationCore::ResetGridCellStates - Not initialized! ")); return; }
+
+	// Reset all cells to empty
+	int32 CellsReset = 0;
+	for (EGridCellType& Cell : GridState)
+	{
+		if (Cell != EGridCellType::ECT_Empty)
+		{
+			Cell = EGridCellType:: ECT_Empty;
+			CellsReset++;
+		}
+	}
+	OccupancyMask.Reset();
+	FreeRectIndex.Invalidate();
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::ResetGridCellStates - Reset %d cells to empty (Total: %d)"), 
+		CellsReset, GridState.Num());
+}
+
+EGridCellType FRoomGenerationCore::GetCellState(FIntPoint GridCoord) const
+{
+	if (!IsValidGridCoordinate(GridCoord)) return EGridCellType::ECT_Empty;
+	int32 Index = GridCoordToIndex(GridCoord); return GridState[Index];
+}
+
+bool FRoomGenerationCore::SetCellState(FIntPoint GridCoord, EGridCellType NewState)
+{
+	if (!IsValidGridCoordinate(GridCoord))	return false;
+
+	int32 Index = GridCoordToIndex(GridCoord);
+	GridState[Index] = NewState;
+	OccupancyMask.SetCell(GridCoord, NewState != EGridCellType::ECT_Empty);
+
+	// Keep free-rectangle index current on occupy; freeing a cell needs a rebuild
+	if (NewState != EGridCellType::ECT_Empty) FreeRectIndex.Occupy(GridCoord, FIntPoint(1, 1));
+	else FreeRectIndex.Invalidate();
+	return true;
+}
+
+bool FRoomGenerationCore::IsValidGridCoordinate(FIntPoint GridCoord) const
+{
+	return GridCoord.X >= 0 && GridCoord.X < GridSize.X && GridCoord.Y >= 0 && GridCoord.Y < GridSize.Y;
+}
+
+bool FRoomGenerationCore::IsAreaAvailable(FIntPoint StartCoord, FIntPoint Size) const
+{
+	// Bounds, then O(1) summed-area rejection (table from GenerateFloor's rebuild; cells placed since are caught
+	// below), then packed-row confirm (one mask test per row)
+	return OccupancyMask.IsRectFree(StartCoord, Size);
+}
+
+bool FRoomGenerationCore::MarkArea(FIntPoint StartCoord, FIntPoint Size, EGridCellType CellType)
+{
+	// Validate that area is available
+	if (!IsAreaAvailable(StartCoord, Size))	return false;
+
+	// Mark all cells in area (rows are contiguous in GridState)
+	for (int32 Y = StartCoord.Y; Y < StartCoord.Y + Size.Y; ++Y)
+	{
+		EGridCellType* Row = GridState.GetData() + GridCoordToIndex(FIntPoint(StartCoord.X, Y));
+		for (int32 X = 0; X < Size.X; ++X) { Row[X] = CellType; }
+	}
+	OccupancyMask.SetRect(StartCoord, Size, CellType != EGridCellType::ECT_Empty);
+	if (CellType != EGridCellType::ECT_Empty) FreeRectIndex.Occupy(StartCoord, Size);
+	else FreeRectIndex.Invalidate();
+	return true;
+}
+
+bool FRoomGenerationCore::ClearArea(FIntPoint StartCoord, FIntPoint Size)
+{
+	// Validate coordinates
+	if (StartCoord.X + Size. X > GridSize.X || StartCoord.Y + Size.Y > GridSize.Y) return false;
+
+	// Clear all cells in area
+	for (int32 X = 0; X < Size.X; ++X)
+	{
+		for (int32 Y = 0; Y < Size.Y; ++Y)
+		{
+			FIntPoint CellCoord(StartCoord.X + X, StartCoord.Y + Y);
+			if (IsValidGridCoordinate(CellCoord)) { GridState[GridCoordToIndex(CellCoord)] = EGridCellType::ECT_Empty; }
+		}
+	}
+	OccupancyMask.SetRect(StartCoord, Size, false);
+	FreeRectIndex.Invalidate();
+	return true;
+}
+
+
+#pragma endregion
+
+#pragma region RoomPreset Layout Management
+bool FRoomGenerationCore::IsUsingPresetLayout() const
+{
+	if (!Snapshot.IsValid() || !bIsInitialized) return false;
+	return Snapshot->bUsePresetLayout;
+}
+
+const FPresetRegion* FRoomGenerationCore::GetRegionAtCoordinate(FIntPoint GridCoordinate) const
+{
+	if (!IsUsingPresetLayout() || !IsValidGridCoordinate(GridCoordinate)) return nullptr;
+
+	// Priority was resolved into the snapshot's region raster when it was built
+	return Snapshot->GetPresetRegionAt(GridCoordinate);
+}
+#pragma endregion
+
+#pragma region Floor Generation
+bool FRoomGenerationCore::GenerateFloor()
+{
+	if (!bIsInitialized)
+	{ UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateFloor - Generator not initialized!")); return false; }
+
+	if (!Snapshot.IsValid() || !Snapshot->bHasFloorStyle)
+	{ UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateFloor - FloorData not assigned or failed to load!")); return false; }
+
+	// Validate FloorTilePool exists
+	if (Snapshot->FloorTilePool.Num() == 0)
+	{ UE_LOG(LogTemp, Warning, TEXT("FRoomGenerationCore::GenerateFloor - No floor meshes defined in FloorTilePool!")); return false;}
+	
+	// Clear previous placement data
+	ClearPlacedFloorMeshes();
+
+	// Every scratch array of the floor pass is released when this returns
+	FMemMark ScratchMark(FMemStack::Get());
+
+	// Rewind floor stream so regenerating the floor reproduces the same layout
+	FloorStream.Reset();
+	
+	int32 FloorLargeTilesPlaced = 0;
+	int32 FloorMediumTilesPlaced = 0;
+	int32 FloorSmallTilesPlaced = 0;
+	int32 FloorFillerTilesPlaced = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateFloor - Starting floor generation"));
+
+ 
+	// PHASE 0:  FORCED EMPTY REGIONS (Mark cells as reserved)
+ 	TRoomScratchArray<FIntPoint> ForcedEmptyCells;
+	ExpandForcedEmptyRegions(ForcedEmptyCells);
+	if (ForcedEmptyCells.Num() > 0)
+	{
+		MarkForcedEmptyCells(ForcedEmptyCells);
+		UE_LOG(LogTemp, Log, TEXT("  Phase 0: Marked %d forced empty cells"), ForcedEmptyCells. Num());
+	}
+	
+	// PHASE 1: FORCED PLACEMENTS (Designer overrides - highest priority)
+ 	int32 ForcedCount = ExecuteForcedPlacements();
+	UE_LOG(LogTemp, Log, TEXT("  Phase 1: Placed %d forced meshes"), ForcedCount);
+
+	// PHASE 1.5: PRESET REGIONS (styled regions pack their own cells in parallel; the phases below fill the remainder)
+	if (Snapshot->bUsePresetLayout && Snapshot->PresetRegionStyles.Num() > 0)
+	{
+		int32 RegionCount = GeneratePresetRegionFloors();
+		UE_LOG(LogTemp, Log, TEXT("  Phase 1.5: Placed %d preset region meshes"), RegionCount);
+	}
+	
+	// One O(grid area) summed-area rebuild for every fill pass below: forced and region cells now reject anchors in
+	// four reads, and the passes only add occupancy, so the table stays a valid rejection test until the floor is done
+	OccupancyMask.RebuildSummedAreaTable();
+
+	// Pool resolved into the snapshot on the game thread
+	const TArray<FMeshPlacementInfo>& FloorMeshes = Snapshot->FloorTilePool;
+
+	// PHASE 2 (ALTERNATE): SINGLE-PASS PACK (largest fitting footprint per cell, one sweep)
+	if (Snapshot->bUseSinglePassPacker)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  Phase 2: Single-pass pack with %d tile options"), FloorMeshes.Num());
+		int32 PackedCount = FillSinglePass(FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+		UE_LOG(LogTemp, Log, TEXT("  Phase 2: Packed %d meshes"), PackedCount);
+	}
+	else
+	{
+		// PHASE 2: GREEDY FILL (Large → Medium → Small)
+		UE_LOG(LogTemp, Log, TEXT("  Phase 2: Greedy fill with %d tile options"), FloorMeshes.Num());
+
+		// Large tiles (400x400, 200x400, 400x200)
+		FillWithTileSize(FIntPoint(4, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+		FillWithTileSize(FIntPoint(2, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+		FillWithTileSize(FIntPoint(4, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+
+		// Medium tiles (200x200)
+		FillWithTileSize(FIntPoint(2, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+
+		// Small tiles (100x200, 200x100, 100x100)
+		FillWithTileSize(FIntPoint(1, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+		FillWithTileSize(FIntPoint(2, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+		FillWithTileSize(FIntPoint(1, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	
+		// PHASE 3: GAP FILL (Fill remaining empty cells with any available mesh)
+		int32 GapFillCount = FillRemainingGaps(FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+		UE_LOG(LogTemp, Log, TEXT("  Phase 3:  Filled %d remaining gaps"), GapFillCount);
+	}
+ 
+	// FINAL STATISTICS
+	int32 RemainingEmpty = GetCellCountByType(EGridCellType::ECT_Empty);
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateFloor - Floor generation complete"));
+	UE_LOG(LogTemp, Log, TEXT("  Total meshes placed: %d"), PlacedFloorMeshes.Num());
+	UE_LOG(LogTemp, Log, TEXT("  Large:  %d, Medium: %d, Small: %d, Filler: %d"), 
+		FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
+	UE_LOG(LogTemp, Log, TEXT("  Remaining empty cells: %d"), RemainingEmpty);
+
+	return true;
+}
+
+void FRoomGenerationCore::ClearPlacedFloorMeshes()
+{
+	PlacedFloorMeshes. Empty();
+	bFloorInstancesDirty = true;
+	LargeTilesPlaced = 0;
+	MediumTilesPlaced = 0;
+	SmallTilesPlaced = 0;
+	FillerTilesPlaced = 0;
+}
+
+void FRoomGenerationCore::GetFloorStatistics(int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles) const
+{
+	OutLargeTiles = LargeTilesPlaced;
+	OutMediumTiles = MediumTilesPlaced;
+	OutSmallTiles = SmallTilesPlaced;
+	OutFillerTiles = FillerTilesPlaced;
+}
+
+int32 FRoomGenerationCore::ExecuteForcedPlacements()
+{
+	if (! bIsInitialized || !Snapshot.IsValid()) 
+	{ UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::ExecuteForcedPlacements - Not initialized! ")); return 0;}
+
+	int32 SuccessfulPlacements = 0;
+	const TMap<FIntPoint, FMeshPlacementInfo>& ForcedPlacements = Snapshot->ForcedFloorPlacements;
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::ExecuteForcedPlacements - Processing %d forced placements"), ForcedPlacements. Num());
+	for (const auto& Pair : ForcedPlacements)
+	{
+		const FIntPoint StartCoord = Pair.Key;
+		const FMeshPlacementInfo& MeshInfo = Pair.Value;
+
+		// Validate mesh asset
+		if (MeshInfo.MeshAsset. IsNull())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) has null mesh asset - skipping"), StartCoord.X, StartCoord.Y);
+			continue;
+		}
+
+		// Calculate original footprint
+		FIntPoint OriginalFootprint = CalculateFootprint(MeshInfo);
+
+		UE_LOG(LogTemp, Verbose, TEXT("  Attempting forced placement at (%d,%d) with footprint %dx%d"), 
+		StartCoord.X, StartCoord.Y, OriginalFootprint.X, OriginalFootprint.Y);
+
+		// Try to find a rotation that fits the available space
+		int32 BestRotation = -1;
+		FIntPoint BestFootprint;
+
+		if (MeshInfo.AllowedRotations.Num() > 0)
+		{
+			// Try each allowed rotation to find one that fits
+			for (int32 Rotation :  MeshInfo.AllowedRotations)
+			{
+				FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
+
+				// Check if this rotation fits within grid bounds
+				if (StartCoord.X + RotatedFootprint.X <= GridSize. X && StartCoord.Y + RotatedFootprint.Y <= GridSize.Y)
+				{
+					// Check if area is available
+					if (IsAreaAvailable(StartCoord, RotatedFootprint))
+					{
+						BestRotation = Rotation;
+						BestFootprint = RotatedFootprint;
+						UE_LOG(LogTemp, Verbose, TEXT("    Found valid rotation %d° (footprint %dx%d)"), 
+							Rotation, RotatedFootprint.X, RotatedFootprint.Y);
+						break; // Use first valid rotation
+					}
+				}
+			}
+		}
+		else
+		{
+			// No allowed rotations defined, try default (0°)
+			BestRotation = 0;
+			BestFootprint = OriginalFootprint;
+		}
+
+		// Check if we found a valid rotation
+		if (BestRotation == -1)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) cannot fit with any allowed rotation - skipping"), 
+				StartCoord.X, StartCoord.Y);
+			continue;
+		}
+
+		// Validate bounds with best rotation
+		if (StartCoord.X + BestFootprint.X > GridSize.X || 
+		    StartCoord.Y + BestFootprint. Y > GridSize.Y)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) is out of bounds (size %dx%d) - skipping"), 
+				StartCoord.X, StartCoord.Y, BestFootprint. X, BestFootprint.Y);
+			continue;
+		}
+
+		// Final check if area is available
+		if (! IsAreaAvailable(StartCoord, BestFootprint))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) overlaps existing placement - skipping"), 
+				StartCoord.X, StartCoord.Y);
+			continue;
+		}
+
+		// Place the mesh with best rotation
+		if (TryPlaceMesh(StartCoord, BestFootprint, MeshInfo, BestRotation))
+		{
+			SuccessfulPlacements++;
+			UE_LOG(LogTemp, Log, TEXT("  ✓ Placed forced mesh at (%d,%d) size %dx%d rotation %d°"), 
+				StartCoord.X, StartCoord.Y, BestFootprint. X, BestFootprint.Y, BestRotation);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("  Failed to place forced mesh at (%d,%d) - TryPlaceMesh returned false"), 
+				StartCoord.X, StartCoord.Y);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::ExecuteForcedPlacements - Placed %d/%d forced meshes"), 
+		SuccessfulPlacements, ForcedPlacements.Num());
+
+	return SuccessfulPlacements;
+}
+
+int32 FRoomGenerationCore::FillRemainingGaps(int32& OutLargeTiles,
+	int32& OutMediumTiles,
+	int32& OutSmallTiles,
+	int32& OutFillerTiles)
+{
+	const TArray<FMeshPlacementInfo>& TilePool = Snapshot->FloorTilePool;
+	if (TilePool.Num() == 0)
+	{ UE_LOG(LogTemp, Warning, TEXT("FRoomGenerationCore::FillRemainingGaps - No meshes in tile pool! ")); return 0;}
+
+	int32 PlacedCount = 0;
+
+	// Define sizes to try (largest to smallest for efficiency)
+	static const FIntPoint SizesToTry[] = {
+		FIntPoint(1, 4), // 100x400
+		FIntPoint(4, 1), // 400x100
+		FIntPoint(1, 2), // 100x200
+		FIntPoint(2, 1), // 200x100
+		FIntPoint(1, 1)  // 100x100
+	};
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::FillRemainingGaps - Starting gap fill"));
+
+	// Anchor lists of every size are released together when the gap fill returns
+	FMemMark ScratchMark(FMemStack::Get());
+
+	// Try each size in order
+	for (const FIntPoint& TargetSize : SizesToTry)
+	{
+		// Cached sampler over tiles matching this size (or rotated version)
+		const FFloorFootprintBucket* Bucket = Snapshot->FloorFootprintBuckets.Find(TargetSize);
+		if (!Bucket) continue; // No tiles of this size, try next
+
+		int32 SizePlacedCount = 0;
+
+		// Candidate anchors come from the free-rectangle index; only placements made during this sweep can reject them
+		if (!FreeRectIndex.IsValid()) FreeRectIndex.Build(OccupancyMask);
+
+		TRoomScratchArray<FIntPoint> Anchors;
+		FreeRectIndex.GatherAnchors(TargetSize, Anchors);
+
+		// Try to place tiles of this size in the remaining free space
+		for (const FIntPoint& StartCoord : Anchors)
+		{
+			// Check if area is available
+			if (IsAreaAvailable(StartCoord, TargetSize))
+			{
+				// Select weighted random mesh (alias draw, no copy)
+				const FMeshPlacementInfo& SelectedMesh = *SelectWeightedMesh(TilePool, *Bucket);
+				FIntPoint OriginalFootprint = CalculateFootprint(SelectedMesh);
+
+				// Find rotation that matches target size
+				int32 BestRotation = 0;
+				
+				if (SelectedMesh.AllowedRotations.Num() > 0)
+				{
+					// Build list of rotations that would fit the target size
+					TArray<int32, TInlineAllocator<4>> ValidRotations;
+
+					for (int32 Rotation : SelectedMesh.AllowedRotations)
+					{
+						FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
+						
+						if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
+						{
+							ValidRotations.Add(Rotation);
+						}
+					}
+
+					// Select random rotation from valid options
+					if (ValidRotations.Num() > 0)
+					{
+						int32 RandomIndex = FloorStream.RandRange(0, ValidRotations.Num() - 1);
+						BestRotation = ValidRotations[RandomIndex];
+					}
+				}
+
+				// Try to place mesh with rotation
+				if (TryPlaceMesh(StartCoord, TargetSize, SelectedMesh, BestRotation))
+				{
+					SizePlacedCount++;
+					PlacedCount++;
+
+					// Update statistics
+					int32 TileArea = TargetSize.X * TargetSize.Y;
+					if (TileArea >= 16) OutLargeTiles++;
+					else if (TileArea >= 4) OutMediumTiles++;
+					else if (TileArea >= 2) OutSmallTiles++;
+					else OutFillerTiles++;
+				}
+			}
+		}
+
+		if (SizePlacedCount > 0)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("  Filled %d gaps with %dx%d tiles"), SizePlacedCount, TargetSize. X, TargetSize.Y);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::FillRemainingGaps - Placed %d gap-fill meshes"), PlacedCount);
+
+	return PlacedCount;
+}
+
+TArray<FIntPoint> FRoomGenerationCore::ExpandForcedEmptyRegions() const
+{
+	TArray<FIntPoint> ExpandedCells;
+	ExpandForcedEmptyRegions(ExpandedCells);
+	return ExpandedCells;
+}
+
+template <typename AllocatorType>
+void FRoomGenerationCore::ExpandForcedEmptyRegions(TArray<FIntPoint, AllocatorType>& ExpandedCells) const
+{
+	ExpandedCells.Reset();
+	if (!Snapshot.IsValid()) return;
+
+	// One bit per cell replaces AddUnique's linear search (first occurrence order is kept)
+	// No FMemMark here: ExpandedCells may itself live on the caller's mem stack and grow while we run
+	TBitArray<> bCellAdded(false, GridSize.X * GridSize.Y);
+	auto AddCell = [&](const FIntPoint& Cell)
+	{
+		FBitReference bAdded = bCellAdded[Cell.Y * GridSize.X + Cell.X];
+		if (!bAdded) { bAdded = true; ExpandedCells.Add(Cell); }
+	};
+
+	// 1. Expand all rectangular regions into individual cells
+	for (const FForcedEmptyRegion& Region : Snapshot->ForcedEmptyRegions)
+	{
+		// Calculate bounding box (handles any corner order)
+		int32 MinX = FMath::Min(Region.StartCell.X, Region.EndCell. X);
+		int32 MaxX = FMath::Max(Region.StartCell.X, Region.EndCell.X);
+		int32 MinY = FMath::Min(Region.StartCell.Y, Region.EndCell. Y);
+		int32 MaxY = FMath::Max(Region.StartCell.Y, Region.EndCell.Y);
+
+		// Clamp to valid grid bounds
+		MinX = FMath:: Clamp(MinX, 0, GridSize.X - 1);
+		MaxX = FMath::Clamp(MaxX, 0, GridSize.X - 1);
+		MinY = FMath::Clamp(MinY, 0, GridSize.Y - 1);
+		MaxY = FMath:: Clamp(MaxY, 0, GridSize.Y - 1);
+
+		// Add all cells within the rectangular region
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				AddCell(FIntPoint(X, Y));
+			}
+		}
+	}
+
+	// 2. Add individual forced empty cells
+	for (const FIntPoint& Cell : Snapshot->ForcedEmptyFloorCells)
+	{
+		// Validate cell is within grid bounds
+		if (Cell.X >= 0 && Cell.X < GridSize.X && Cell.Y >= 0 && Cell.Y < GridSize.Y) {	AddCell(Cell); }
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::ExpandForcedEmptyRegions - Expanded to %d cells"), ExpandedCells.Num());
+}
+
+void FRoomGenerationCore::MarkForcedEmptyCells(TConstArrayView<FIntPoint> EmptyCells)
+{
+	for (const FIntPoint& Cell :  EmptyCells)
+	{
+		// Mark as Wall type (reserved/boundary marker)
+		SetCellState(Cell, EGridCellType::ECT_Wall);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::MarkForcedEmptyCells - Marked %d cells as empty"), EmptyCells.Num());
+}
+#pragma endregion
+
+#pragma region Wall Generation
+bool FRoomGenerationCore::GenerateWalls()
+{
+	if (!bIsInitialized)
+	{ UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateWalls - Generator not initialized! ")); return false; }
+
+	if (!Snapshot.IsValid() || !Snapshot->bHasWallStyle)
+	{ UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateWalls - WallStyleData not assigned!")); return false; }
+
+	if (Snapshot->WallModules.Num() == 0)
+	{ UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateWalls - No wall modules defined!"));	return false; }
+	
+	// Clear previous data
+	ClearPlacedWalls();
+	ResetBaseWallSegments();  // Clear tracking array and edge masks
+
+	// Rewind wall stream (doorways rewind their own stream)
+	WallStream.Reset();
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateWalls - Starting wall generation"));
+
+	// PHASE 0:   GENERATE DOORWAYS FIRST (Before any walls are placed!)
+	UE_LOG(LogTemp, Log, TEXT("  Phase 0: Generating doorways"));
+	if (! GenerateDoorways())
+	{ UE_LOG(LogTemp, Warning, TEXT("  Doorway generation failed, continuing with walls")); }
+	else
+	{ UE_LOG(LogTemp, Log, TEXT("  Doorways generated:   %d"), PlacedDoorwayMeshes. Num()); }
+	
+	// PHASE 1: FORCED WALL PLACEMENTS
+	int32 ForcedCount = ExecuteForcedWallPlacements();
+	if (ForcedCount > 0) UE_LOG(LogTemp, Log, TEXT("  Phase 0: Placed %d forced walls"), ForcedCount);
+	
+	// PHASE 2: Generate base walls for each edge (edge scratch is released when this returns)
+	FMemMark ScratchMark(FMemStack::Get());
+	FillWallEdge(EWallEdge::North);
+	FillWallEdge(EWallEdge::South);
+	FillWallEdge(EWallEdge::East);
+	FillWallEdge(EWallEdge::West);
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateWalls - Base walls tracked:  %d segments"), 
+		PlacedBaseWallSegments.Num());
+
+	// PASS 3: Spawn middle layers using socket-based stacking
+	SpawnMiddleWallLayers();
+
+	// PASS 4: Spawn top layer using socket-based stacking
+	SpawnTopWallLayer();
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateWalls - Complete.  Total wall records: %d"), 
+		PlacedWallMeshes.Num());
+
+	return true;
+}
+
+int32 FRoomGenerationCore::ExecuteForcedWallPlacements()
+{
+	if (!bIsInitialized || !Snapshot.IsValid())
+	{ UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::ExecuteForcedWallPlacements - Not initialized!")); return 0;	}
+
+	// Check if there are any forced placements
+	if (Snapshot->ForcedWallPlacements.Num() == 0)
+	{ UE_LOG(LogTemp, Verbose, TEXT("FRoomGenerationCore::ExecuteForcedWallPlacements - No forced walls to place")); return 0;}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::ExecuteForcedWallPlacements - Processing %d forced walls"), 
+		Snapshot->ForcedWallPlacements.Num());
+
+	int32 SuccessfulPlacements = 0;
+	int32 FailedPlacements = 0;
+
+	// Wall offsets (used for all walls; zero when no WallData resolved)
+	const float NorthOffset = Snapshot->NorthWallOffsetX;
+	const float SouthOffset = Snapshot->SouthWallOffsetX;
+	const float EastOffset = Snapshot->EastWallOffsetY;
+	const float WestOffset = Snapshot->WestWallOffsetY;
+
+	for (int32 i = 0; i < Snapshot->ForcedWallPlacements.Num(); ++i)
+	{
+		const FForcedWallPlacement& ForcedWall = Snapshot->ForcedWallPlacements[i];
+		const FRoomSnapshotWallModule& ResolvedModule = Snapshot->ForcedWallModules[i];
+		const FWallModule& Module = ResolvedModule.Module;
+
+		UE_LOG(LogTemp, Verbose, TEXT("  Forced Wall [%d]: Edge=%s, StartCell=%d, Footprint=%d"), i, 
+		*UEnum::GetValueAsString(ForcedWall.Edge), ForcedWall.StartCell, Module.Y_AxisFootprint);
+	 
+		// VALIDATION:  Base Mesh (resolved by the snapshot)
+		if (!ResolvedModule.bBaseMeshLoaded)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED: BaseMesh failed to load"));
+			FailedPlacements++;
+			continue;
+		}
+
+	 
+		// VALIDATION: Check Edge Cells
+		const int32 EdgeLength = UDungeonGenerationHelpers::GetEdgeLength(ForcedWall.Edge, GridSize);
+
+		if (EdgeLength == 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED: No cells on edge %s"), *UEnum::GetValueAsString(ForcedWall.Edge));
+			FailedPlacements++;
+			continue;
+		}
+	 
+		// VALIDATION: Check Bounds
+	 	int32 Footprint = Module.Y_AxisFootprint;
+		if (ForcedWall.StartCell < 0 || ForcedWall.StartCell + Footprint > EdgeLength)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED: Out of bounds (StartCell=%d, Footprint=%d, EdgeLength=%d)"),
+				ForcedWall.StartCell, Footprint, EdgeLength);
+			FailedPlacements++;
+			continue;
+		}
+
+		// NOTE: Overlap checking with other forced walls would happen here
+		// For now, we assume designers don't create overlapping forced placements
+	 
+		// PLACEMENT: Calculate Position & Rotation Using Helpers
+		FVector WallPosition = UDungeonGenerationHelpers:: CalculateWallPosition(
+		ForcedWall.Edge, ForcedWall.StartCell, Footprint, GridSize, CellSize,
+		NorthOffset, SouthOffset, EastOffset, WestOffset);
+
+		FRotator WallRotation = UDungeonGenerationHelpers::GetWallRotationForEdge(ForcedWall.Edge);
+	 
+		// PLACEMENT: Create Base Wall Transform
+		FTransform BaseTransform(WallRotation, WallPosition, FVector:: OneVector);
+	 
+		// TRACKING: Store Segment for Middle/Top Spawning
+		FGeneratorWallSegment Segment;
+		Segment.Edge = ForcedWall.Edge;
+		Segment.StartCell = ForcedWall.StartCell;
+		Segment. SegmentLength = Footprint;
+		Segment.BaseTransform = BaseTransform;
+		Segment.WallModule = &ResolvedModule;  // Store pointer to module data
+		Segment.SourceSnapshot = Snapshot;
+
+		TrackBaseWallSegment(Segment);
+
+		UE_LOG(LogTemp, Verbose, TEXT("    ✓ Forced wall tracked: Edge=%s, StartCell=%d, Footprint=%d"),
+		*UEnum::GetValueAsString(ForcedWall.Edge), ForcedWall.StartCell, Footprint);
+		SuccessfulPlacements++;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::ExecuteForcedWallPlacements - Placed %d/%d forced walls (%d failed)"),
+	SuccessfulPlacements, Snapshot->ForcedWallPlacements. Num(), FailedPlacements);
+	return SuccessfulPlacements;
+}
+
+bool FRoomGenerationCore::IsCellRangeOccupied(EWallEdge Edge, int32 StartCell, int32 Length) const
+{
+	// Any tracked segment (forced or filled) on this edge covering the range shows up in the edge mask
+	const int32 Slot = GetEdgeSlot(Edge);
+	return Slot != INDEX_NONE && DoesEdgeMaskOverlap(WallEdgeMasks[Slot], StartCell, Length);
+}
+
+void FRoomGenerationCore::TrackBaseWallSegment(const FGeneratorWallSegment& Segment)
+{
+	PlacedBaseWallSegments.Add(Segment);
+
+	const int32 Slot = GetEdgeSlot(Segment.Edge);
+	if (Slot == INDEX_NONE) return;
+
+	if (!WallEdgeMasks[Slot].IsInitialized()) InitEdgeMasks(WallEdgeMasks);
+	WallEdgeMasks[Slot].SetRect(FIntPoint(Segment.StartCell, 0), FIntPoint(Segment.SegmentLength, 1), true);
+}
+
+void FRoomGenerationCore::ResetBaseWallSegments()
+{
+	PlacedBaseWallSegments.Empty();
+	for (FGridOccupancy& EdgeMask : WallEdgeMasks) { EdgeMask.Empty(); }
+}
+
+void FRoomGenerationCore::ClearPlacedWalls()
+{
+	PlacedWallMeshes.Empty();
+	bWallInstancesDirty = true;
+}
+
+void FRoomGenerationCore::SpawnMiddleWallLayers()
+{
+	if (!Snapshot.IsValid()) return;
+	bWallInstancesDirty = true;
+
+	int32 Middle1Spawned = 0;
+	int32 Middle2Spawned = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::SpawnMiddleWallLayers - Processing %d base segments"), PlacedBaseWallSegments.Num());
+
+	for (const FGeneratorWallSegment& Segment : PlacedBaseWallSegments)
+	{
+		if (!Segment.WallModule) continue;
+		const FRoomSnapshotWallModule& Resolved = *Segment.WallModule;
+
+		// MIDDLE 1 LAYER
+		if (Resolved.bMiddleMesh1Loaded)
+		{
+			// Stack on the base layer's "TopBackCenter" socket (resolved by the snapshot)
+			FTransform Middle1WorldTransform = Resolved.BaseTopSocket * Segment.BaseTransform;
+
+			// Store wall info
+			FPlacedWallInfo PlacedWall;
+			PlacedWall.Edge = Segment.Edge;
+			PlacedWall.StartCell = Segment.StartCell;
+			PlacedWall.SpanLength = Segment.SegmentLength;
+			PlacedWall.BaseMeshId = MeshPalette.Intern(Resolved.Module.BaseMesh);
+			PlacedWall.Middle1MeshId = MeshPalette.Intern(Resolved.Module.MiddleMesh1);
+			PlacedWall.BottomTransform = Segment.BaseTransform;
+			PlacedWall.Middle1Transform = Middle1WorldTransform;
+
+			PlacedWallMeshes.Add(PlacedWall);
+			Middle1Spawned++;
+
+			// MIDDLE 2 LAYER
+			if (Resolved.bMiddleMesh2Loaded)
+			{
+				PlacedWallMeshes.Last().Middle2MeshId = MeshPalette.Intern(Resolved.Module.MiddleMesh2);
+				PlacedWallMeshes.Last().Middle2Transform = Resolved.Middle1TopSocket * Middle1WorldTransform;
+				Middle2Spawned++;
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::SpawnMiddleWallLayers - Middle1: %d, Middle2: %d"), Middle1Spawned, Middle2Spawned);
+}
+
+void FRoomGenerationCore::SpawnTopWallLayer()
+{
+	if (!Snapshot.IsValid()) return;
+	bWallInstancesDirty = true;
+
+	int32 TopSpawned = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::SpawnTopWallLayer - Processing %d wall segments"), PlacedWallMeshes.Num());
+
+	// Wall records are created one per segment that got a Middle1 layer, in segment order
+	int32 WallIndex = 0;
+	for (const FGeneratorWallSegment& Segment : PlacedBaseWallSegments)
+	{
+		if (!Segment.WallModule || !Segment.WallModule->bMiddleMesh1Loaded) continue;
+		if (!PlacedWallMeshes.IsValidIndex(WallIndex)) break;
+
+		const FRoomSnapshotWallModule& Resolved = *Segment.WallModule;
+		FPlacedWallInfo& Wall = PlacedWallMeshes[WallIndex++];
+
+		// Top mesh is required
+		if (!Resolved.bTopMeshLoaded) continue;
+
+		// DETERMINE WHICH LAYER TO STACK ON (Priority:  Middle2 > Middle1 > Base)
+		FTransform StackSocket;
+		FTransform StackBaseTransform;
+
+		if (Resolved.bMiddleMesh2Loaded)
+		{
+			StackSocket = Resolved.Middle2TopSocket;
+			StackBaseTransform = Wall.Middle2Transform;
+		}
+		else if (Resolved.bMiddleMesh1Loaded)
+		{
+			StackSocket = Resolved.Middle1TopSocket;
+			StackBaseTransform = Wall.Middle1Transform;
+		}
+		else
+		{
+			StackSocket = Resolved.BaseTopSocket;
+			StackBaseTransform = Wall.BottomTransform;
+		}
+
+		// Chain the layer's socket with its world transform
+		Wall.TopMeshId = MeshPalette.Intern(Resolved.Module.TopMesh);
+		Wall.TopTransform = StackSocket * StackBaseTransform;
+		TopSpawned++;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::SpawnTopWallLayer - Top meshes: %d"), TopSpawned);
+}
+#pragma endregion
+
+#pragma region Corner Generation
+bool FRoomGenerationCore::GenerateCorners()
+{
+	 if (!bIsInitialized)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateCorners - Generator not initialized! "));
+        return false;
+    }
+
+    if (!Snapshot.IsValid() || !Snapshot->bHasWallStyle)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateCorners - WallStyleData not assigned or failed to load!"));
+        return false;
+    }
+
+    // Corner settings resolved by the snapshot
+    const FRoomGenerationSnapshot* WallData = Snapshot.Get();
+
+    // Clear previous corners
+    ClearPlacedCorners();
+
+    UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateCorners - Starting corner generation"));
+
+    // Corner mesh (required)
+    if (WallData->DefaultCornerMesh.IsNull())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FRoomGenerationCore::GenerateCorners - No default corner mesh defined, skipping corners"));
+        return true; // Not an error, just no corners to place
+    }
+
+    if (!WallData->bCornerMeshLoaded)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FRoomGenerationCore::GenerateCorners - Failed to load corner mesh"));
+        return false;
+    }
+
+    // ========================================================================
+    // Define corner data (matching MasterRoom's clockwise order:  SW, SE, NE, NW)
+    // ========================================================================
+    
+    struct FCornerData
+    {
+        ECornerPosition Position;
+        FVector BasePosition;  // Grid corner position (before offset)
+        FRotator Rotation;     // From WallData
+        FVector Offset;        // Per-corner offset from WallData
+        FString Name;          // For logging
+    };
+
+    TArray<FCornerData> Corners = {
+        { 
+            ECornerPosition::SouthWest, 
+            FVector(0.0f, 0.0f, 0.0f),  // Bottom-left
+            WallData->SouthWestCornerRotation, 
+            WallData->SouthWestCornerOffset,
+            TEXT("SouthWest")
+        },
+        { 
+            ECornerPosition::SouthEast, 
+            FVector(0.0f, GridSize.Y * CellSize, 0.0f),  // Bottom-right
+            WallData->SouthEastCornerRotation, 
+            WallData->SouthEastCornerOffset,
+            TEXT("SouthEast")
+        },
+        { 
+            ECornerPosition::NorthEast, 
+            FVector(GridSize.X * CellSize, GridSize.Y * CellSize, 0.0f),  // Top-right
+            WallData->NorthEastCornerRotation, 
+            WallData->NorthEastCornerOffset,
+            TEXT("NorthEast")
+        },
+        { 
+            ECornerPosition:: NorthWest, 
+            FVector(GridSize.X * CellSize, 0.0f, 0.0f),  // Top-left
+            WallData->NorthWestCornerRotation, 
+            WallData->NorthWestCornerOffset,
+            TEXT("NorthWest")
+        }
+    };
+
+    // ========================================================================
+    // Generate each corner
+    // ========================================================================
+    
+    for (const FCornerData& CornerData : Corners)
+    {
+        // Apply designer offset to base position
+        FVector FinalPosition = CornerData. BasePosition + CornerData. Offset;
+
+        // Create transform (local/component space)
+        FTransform CornerTransform(CornerData.Rotation, FinalPosition, FVector:: OneVector);
+
+        // Create placed corner info
+        FPlacedCornerInfo PlacedCorner;
+        PlacedCorner.Corner = CornerData. Position;
+        PlacedCorner.CornerMeshId = MeshPalette.Intern(WallData->DefaultCornerMesh);
+        PlacedCorner.Transform = CornerTransform;
+
+        PlacedCornerMeshes.Add(PlacedCorner);
+
+        UE_LOG(LogTemp, Verbose, TEXT("  Placed %s corner at position %s with rotation (%.0f, %.0f, %.0f)"),
+            *CornerData.Name,
+            *FinalPosition.ToString(),
+            CornerData. Rotation.Roll,
+            CornerData.Rotation. Pitch,
+            CornerData.Rotation.Yaw);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateCorners - Complete.  Placed %d corners"), PlacedCornerMeshes.Num());
+
+    return true;
+}
+
+void FRoomGenerationCore::ClearPlacedCorners()
+{
+	PlacedCornerMeshes.Empty();
+	bCornerInstancesDirty = true;
+}
+#pragma endregion
+
+#pragma region Doorway Generation
+
+bool FRoomGenerationCore::GenerateDoorways()
+{
+    if (!  bIsInitialized)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateDoorways - Generator not initialized!  "));
+        return false;
+    }
+
+    if (!Snapshot.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateDoorways - No room snapshot! "));
+        return false;
+    }
+
+    // Rewind doorway stream so automatic doorway choice depends only on the seed
+    DoorwayStream.Reset();
+
+    // ========================================================================
+    // CHECK FOR CACHED LAYOUT
+    // ========================================================================
+    
+    if (CachedDoorwayLayouts.Num() > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateDoorways - Using cached layout (%d doorways), recalculating transforms"),
+            CachedDoorwayLayouts.Num());
+        
+        // Clear old transforms but keep layout
+        PlacedDoorwayMeshes.  Empty();
+        
+        // Recalculate transforms from cached layouts (with current offsets)
+        for (const FDoorwayLayoutInfo& Layout : CachedDoorwayLayouts)
+        {
+            FPlacedDoorwayInfo PlacedDoor = CalculateDoorwayTransforms(Layout);
+            PlacedDoorwayMeshes.Add(PlacedDoor);
+        }
+        
+        MarkDoorwayCells();
+        
+        UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateDoorways - Transforms recalculated with current offsets"));
+        return true;
+    }
+
+    // ========================================================================
+    // NO CACHE - GENERATE NEW LAYOUT
+    // ========================================================================
+
+    UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateDoorways - Generating new doorway layout"));
+
+    // Clear both layout and transforms
+    PlacedDoorwayMeshes. Empty();
+    CachedDoorwayLayouts.  Empty();
+
+    int32 ManualDoorwaysPlaced = 0;
+    int32 AutomaticDoorwaysPlaced = 0;
+
+    // ========================================================================
+    // PHASE 1: Process Manual Doorway Placements
+    // ========================================================================
+
+    for (const FFixedDoorLocation& ForcedDoor : Snapshot->ForcedDoorways)
+    {
+        // Validate door data
+        UDoorData* DoorData = ForcedDoor.DoorData ?  ForcedDoor.DoorData : Snapshot->DefaultDoorData;
+        const FRoomSnapshotDoorStyle* DoorStyle = Snapshot->FindDoorStyle(DoorData);
+        
+        if (!DoorData || !DoorStyle)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("  Forced doorway has no DoorData, skipping"));
+            continue;
+        }
+        
+    	int32 DoorWidth = DoorStyle->TotalDoorwayWidth;
+    	UE_LOG(LogTemp, Log, TEXT("  Manual doorway:  Edge=%s, FrameFootprint=%d, SideFills=%s, TotalWidth=%d"),
+    	*UEnum::GetValueAsString(ForcedDoor.WallEdge), DoorStyle->FrameFootprintY, *UEnum:: GetValueAsString(DoorStyle->SideFillType), DoorWidth);
+        // Validate bounds
+        const int32 EdgeLength = UDungeonGenerationHelpers::GetEdgeLength(ForcedDoor.WallEdge, GridSize);
+        
+        if (ForcedDoor.StartCell < 0 || ForcedDoor.StartCell + DoorWidth > EdgeLength)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("  Forced doorway out of bounds, skipping"));
+            continue;
+        }
+
+        // ✅ Create and cache layout info
+        FDoorwayLayoutInfo LayoutInfo;
+        LayoutInfo.Edge = ForcedDoor.WallEdge;
+        LayoutInfo.StartCell = ForcedDoor.StartCell;
+        LayoutInfo.WidthInCells = DoorWidth;
+        LayoutInfo.DoorData = DoorData;
+        LayoutInfo.bIsStandardDoorway = false;
+        LayoutInfo.ManualOffsets = ForcedDoor.DoorPositionOffsets;  // Store manual offsets
+
+        CachedDoorwayLayouts.Add(LayoutInfo);
+
+        // ✅ Calculate transforms from layout
+        FPlacedDoorwayInfo PlacedDoor = CalculateDoorwayTransforms(LayoutInfo);
+        PlacedDoorwayMeshes.Add(PlacedDoor);
+
+        ManualDoorwaysPlaced++;
+    }
+
+    // ========================================================================
+    // PHASE 2: Generate Automatic Standard Doorway
+    // ========================================================================
+
+    if (Snapshot->bGenerateStandardDoorway && Snapshot->DefaultDoorData)
+    {
+        // Determine edges to use
+        TArray<EWallEdge, TInlineAllocator<4>> EdgesToUse;
+        
+        if (Snapshot->bSetStandardDoorwayEdge)
+        {
+            EdgesToUse. Add(Snapshot->StandardDoorwayEdge);
+            UE_LOG(LogTemp, Log, TEXT("  Using manual edge:   %s"), 
+                *UEnum::GetValueAsString(Snapshot->StandardDoorwayEdge));
+        }
+        else if (Snapshot->bMultipleDoorways)
+        {
+            int32 NumDoorways = FMath:: Clamp(Snapshot->NumAutomaticDoorways, 2, 4);
+            
+            TArray<EWallEdge, TInlineAllocator<4>> AllEdges = {
+                EWallEdge:: North, EWallEdge::  South, 
+                EWallEdge:: East, EWallEdge:: West
+            };
+            
+            for (int32 i = AllEdges.Num() - 1; i > 0; --i)
+            {
+                int32 j = DoorwayStream.RandRange(0, i);
+                AllEdges. Swap(i, j);
+            }
+            
+            for (int32 i = 0; i < NumDoorways && i < AllEdges.Num(); ++i)
+            {
+                EdgesToUse.Add(AllEdges[i]);
+            }
+            
+            UE_LOG(LogTemp, Log, TEXT("  Generating %d automatic doorways"), NumDoorways);
+        }
+        else
+        {
+            TArray<EWallEdge, TInlineAllocator<4>> AllEdges = {
+                EWallEdge::North, EWallEdge::South, 
+                EWallEdge:: East, EWallEdge:: West
+            };
+            EWallEdge ChosenEdge = AllEdges[DoorwayStream.RandRange(0, AllEdges.Num() - 1)];
+            EdgesToUse.Add(ChosenEdge);
+            
+            UE_LOG(LogTemp, Log, TEXT("  Using random edge:  %s"), 
+                *UEnum::GetValueAsString(ChosenEdge));
+        }
+        
+        // Generate doorway on each chosen edge
+        for (EWallEdge ChosenEdge : EdgesToUse)
+        {
+            int32 EdgeLength = UDungeonGenerationHelpers::GetEdgeLength(ChosenEdge, GridSize);
+
+            int32 StartCell = (EdgeLength - Snapshot->StandardDoorwayWidth) / 2;
+            StartCell = FMath:: Clamp(StartCell, 0, EdgeLength - Snapshot->StandardDoorwayWidth);
+
+            // Check for overlap with existing doorways
+            bool bOverlaps = false;
+            for (const FDoorwayLayoutInfo& ExistingLayout : CachedDoorwayLayouts)
+            {
+                if (ExistingLayout.Edge == ChosenEdge)
+                {
+                    int32 ExistingStart = ExistingLayout.StartCell;
+                    int32 ExistingEnd = ExistingStart + ExistingLayout.WidthInCells;
+                    int32 NewStart = StartCell;
+                    int32 NewEnd = StartCell + Snapshot->StandardDoorwayWidth;
+
+                    if (NewStart < ExistingEnd && ExistingStart < NewEnd)
+                    {
+                        bOverlaps = true;
+                        UE_LOG(LogTemp, Warning, TEXT("  Doorway on %s would overlap, skipping"),
+                            *UEnum::  GetValueAsString(ChosenEdge));
+                        break;
+                    }
+                }
+            }
+
+            if (!bOverlaps)
+            {
+                // ✅ Create and cache layout info
+                FDoorwayLayoutInfo LayoutInfo;
+                LayoutInfo.Edge = ChosenEdge;
+                LayoutInfo.StartCell = StartCell;
+                LayoutInfo. WidthInCells = Snapshot->StandardDoorwayWidth;
+                LayoutInfo.DoorData = Snapshot->DefaultDoorData;
+                LayoutInfo.bIsStandardDoorway = true;
+                // No manual offsets for automatic doorways
+
+                CachedDoorwayLayouts.Add(LayoutInfo);
+
+                // ✅ Calculate transforms from layout
+                FPlacedDoorwayInfo PlacedDoor = CalculateDoorwayTransforms(LayoutInfo);
+                PlacedDoorwayMeshes. Add(PlacedDoor);
+
+                AutomaticDoorwaysPlaced++;
+            }
+        }
+    }
+
+    // ========================================================================
+    // PHASE 3: Mark Doorway Cells
+    // ========================================================================
+
+    MarkDoorwayCells();
+
+    UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateDoorways - Complete.   Cached %d layouts, placed %d doorways"),
+        CachedDoorwayLayouts.Num(), PlacedDoorwayMeshes.Num());
+
+    return true;
+}
+
+FPlacedDoorwayInfo FRoomGenerationCore::CalculateDoorwayTransforms(const FDoorwayLayoutInfo& Layout) const
+{
+    FPlacedDoorwayInfo PlacedDoor;
+    PlacedDoor.Edge = Layout.Edge;
+    PlacedDoor.StartCell = Layout.StartCell;
+    PlacedDoor.  WidthInCells = Layout.WidthInCells;
+    PlacedDoor. DoorData = Layout.DoorData;
+    PlacedDoor.bIsStandardDoorway = Layout.bIsStandardDoorway;
+
+    // Calculate base position (no offsets)
+    FVector BasePosition = UDungeonGenerationHelpers::  CalculateDoorwayPosition(
+        Layout.Edge,
+        Layout.StartCell,
+        Layout.WidthInCells,
+        GridSize,
+        CellSize
+    );
+
+    // Door style values resolved by the snapshot; a cached layout whose door is no longer referenced gets no offsets
+    const FRoomSnapshotDoorStyle* FoundStyle = Snapshot->FindDoorStyle(Layout.DoorData);
+    const FRoomSnapshotDoorStyle DefaultStyle;
+    const FRoomSnapshotDoorStyle* DoorStyle = FoundStyle ? FoundStyle : &DefaultStyle;
+
+    // ✅ Get offsets based on doorway type
+    FDoorPositionOffsets Offsets;
+    
+    if (Layout.bIsStandardDoorway)
+    {
+        // Automatic doorway:   use edge-specific offsets from DoorData
+        Offsets = DoorStyle->GetOffsetsForEdge(Layout.  Edge);
+        
+        UE_LOG(LogTemp, VeryVerbose, TEXT("    Using edge-specific offsets for %s:  Frame=%s, Actor=%s"),
+            *UEnum::GetValueAsString(Layout. Edge),
+            *Offsets.  FramePositionOffset. ToString(),
+            *Offsets. ActorPositionOffset.  ToString());
+    }
+    else
+    {
+        // Manual doorway:  use stored manual offsets
+        Offsets = Layout.ManualOffsets;
+        
+        UE_LOG(LogTemp, VeryVerbose, TEXT("    Using manual offsets:  Frame=%s, Actor=%s"),
+            *Offsets. FramePositionOffset.ToString(),
+            *Offsets. ActorPositionOffset. ToString());
+    }
+
+    // Apply offsets to base position
+    FVector FinalFramePosition = BasePosition + Offsets.  FramePositionOffset;
+    FVector FinalActorPosition = BasePosition + Offsets.ActorPositionOffset;
+
+    // Calculate rotation
+    FRotator Rotation = UDungeonGenerationHelpers::GetWallRotationForEdge(Layout.Edge);
+    Rotation += DoorStyle->FrameRotationOffset;
+
+    // Store transforms
+    PlacedDoor. FrameTransform = FTransform(Rotation, FinalFramePosition, FVector:: OneVector);
+    PlacedDoor.ActorTransform = FTransform(Rotation, FinalActorPosition, FVector::OneVector);
+
+    return PlacedDoor;
+}
+
+void FRoomGenerationCore::MarkDoorwayCells()
+{
+    // Edge masks are rebuilt in the same pass, so wall filling tests whole spans with one mask check
+    InitEdgeMasks(DoorwayEdgeMasks);
+
+    for (const FPlacedDoorwayInfo& Doorway : PlacedDoorwayMeshes)
+    {
+        const int32 Slot = GetEdgeSlot(Doorway.Edge);
+        if (Slot != INDEX_NONE)
+        {
+            DoorwayEdgeMasks[Slot].SetRect(FIntPoint(Doorway.StartCell, 0), FIntPoint(Doorway.WidthInCells, 1), true);
+        }
+
+        const int32 EdgeLength = UDungeonGenerationHelpers::GetEdgeLength(Doorway.Edge, GridSize);
+
+        for (int32 i = 0; i < Doorway.WidthInCells; ++i)
+        {
+            int32 CellIndex = Doorway.StartCell + i;
+            if (CellIndex >= 0 && CellIndex < EdgeLength)
+            {
+                FIntPoint Cell = UDungeonGenerationHelpers::GetEdgeCell(Doorway.Edge, CellIndex, GridSize);
+                
+                // Mark in grid state (if cell is within interior grid)
+                // Note:  Boundary cells (virtual) are outside interior grid bounds
+                // So we only mark if cell is within (0, GridSize-1)
+                if (Cell.X >= 0 && Cell.X < GridSize. X && Cell.Y >= 0 && Cell.Y < GridSize.Y)
+                {
+                    int32 GridIndex = Cell.Y * GridSize.X + Cell.X;
+                    if (GridState. IsValidIndex(GridIndex))
+                    {
+                        SetCellState(Cell, EGridCellType::ECT_Doorway);
+                    }
+                }
+                
+                UE_LOG(LogTemp, VeryVerbose, TEXT("    Marked doorway cell:  (%d, %d)"), Cell.X, Cell.Y);
+            }
+        }
+    }
+}
+
+bool FRoomGenerationCore::IsCellPartOfDoorway(FIntPoint Cell) const
+{
+	// Doorway cells are the virtual boundary cells just outside the grid; map the cell back to its edge index
+	if (Cell.X == GridSize.X) return DoesEdgeSpanOverlapDoorway(EWallEdge::North, Cell.Y, 1);
+	if (Cell.X == -1) return DoesEdgeSpanOverlapDoorway(EWallEdge::South, Cell.Y, 1);
+	if (Cell.Y == GridSize.Y) return DoesEdgeSpanOverlapDoorway(EWallEdge::East, Cell.X, 1);
+	if (Cell.Y == -1) return DoesEdgeSpanOverlapDoorway(EWallEdge::West, Cell.X, 1);
+	return false;
+}
+
+bool FRoomGenerationCore::DoesEdgeSpanOverlapDoorway(EWallEdge Edge, int32 StartCell, int32 Length) const
+{
+	const int32 Slot = GetEdgeSlot(Edge);
+	return Slot != INDEX_NONE && DoesEdgeMaskOverlap(DoorwayEdgeMasks[Slot], StartCell, Length);
+}
+
+void FRoomGenerationCore::ClearPlacedDoorways()
+{
+    PlacedDoorwayMeshes.Empty();
+	CachedDoorwayLayouts. Empty(); 
+	for (FGridOccupancy& EdgeMask : DoorwayEdgeMasks) { EdgeMask.Empty(); }
+}
+
+void FRoomGenerationCore::SetDoorwayLayouts(TArray<FDoorwayLayoutInfo> InLayouts)
+{
+	ClearPlacedDoorways();
+	CachedDoorwayLayouts = MoveTemp(InLayouts);
+}
+#pragma endregion
+
+#pragma region Ceiling Generation
+bool FRoomGenerationCore::GenerateCeiling()
+{
+    if (! bIsInitialized)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::GenerateCeiling - Generator not initialized!  "));
+        return false;
+    }
+
+    if (!Snapshot.IsValid() || !Snapshot->bHasCeilingStyle)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FRoomGenerationCore::GenerateCeiling - No CeilingStyleData assigned"));
+        return false;
+    }
+
+    // Ceiling pools, samplers and settings resolved by the snapshot
+    const FRoomGenerationSnapshot* CeilingData = Snapshot.Get();
+
+    // Clear previous ceiling data
+    ClearPlacedCeiling();
+
+    UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateCeiling - Starting ceiling generation"));
+
+    // Create occupancy grid (region cores start from the cells their region does not own)
+    FGridOccupancy CeilingOccupied;
+    CeilingOccupied.Init(GridSize);
+    if (ReservedCeilingCells.GetGridSize() == GridSize) CeilingOccupied = ReservedCeilingCells;
+
+    // Rewind ceiling stream so regenerating the ceiling reproduces the same layout
+    CeilingStream.Reset();
+
+    int32 CeilingLargeTilesPlaced = 0;
+    int32 CeilingMediumTilesPlaced = 0;
+    int32 CeilingSmallTilesPlaced = 0;
+
+    // ========================================================================
+    // HELPER LAMBDAS
+    // ========================================================================
+
+    auto IsCellOccupied = [&](int32 X, int32 Y) -> bool
+    {
+        return CeilingOccupied.IsCellOccupied(FIntPoint(X, Y));
+    };
+
+    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
+    {
+        CeilingOccupied.SetRect(FIntPoint(StartX, StartY), Size, true);
+    };
+
+    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
+    {
+        return CeilingOccupied.IsRectFree(FIntPoint(StartX, StartY), Size);
+    };
+
+    // O(1) draw from the alias table copied from CeilingData
+    auto SelectWeightedTile = [&](const TArray<FCeilingTile>& Pool, const FWeightedAliasTable& Sampler) -> const FCeilingTile*
+    {
+        const int32 Index = Sampler.Sample(CeilingStream);
+        return Pool.IsValidIndex(Index) ? &Pool[Index] : nullptr;
+    };
+
+	// Pass 0 Forced Placements
+	int32 ForcedCount = ExecuteForcedCeilingPlacements(CeilingOccupied);
+	if (ForcedCount > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  Phase 0: Placed %d forced ceiling tiles"), ForcedCount);
+	}
+
+	// Pass 0.5 Preset Regions (styled regions tile their own cells in parallel)
+	if (Snapshot->bUsePresetLayout && Snapshot->PresetRegionStyles.Num() > 0)
+	{
+		int32 RegionCount = GeneratePresetRegionCeilings(CeilingOccupied);
+		UE_LOG(LogTemp, Log, TEXT("  Phase 0.5: Placed %d preset region ceiling tiles"), RegionCount);
+	}
+	
+    // ========================================================================
+    // PASS 1:  LARGE TILES (4x4)
+    // ========================================================================
+
+    if (CeilingData->LargeTilePool.Num() > 0)
+    {
+        CeilingOccupied.RebuildSummedAreaTable();
+        for (int32 Y = 0; Y <= GridSize.Y - 4; Y++)
+        {
+            for (int32 X = 0; X <= GridSize.X - 4; X++)
+            {
+                // ✅ CHANGED:    Use GridFootprint instead of hardcoded size
+                FIntPoint TargetSize(4, 4);
+                
+                if (IsAreaAvailable(X, Y, TargetSize))
+                {
+                    const FCeilingTile* SelectedTile = SelectWeightedTile(CeilingData->LargeTilePool, CeilingData->LargeTileSampler);
+
+                    if (SelectedTile && ! SelectedTile->Mesh. IsNull())
+                    {
+                        // ✅ CHANGED:   Use GridFootprint from tile
+                        FIntPoint TileFootprint = SelectedTile->GridFootprint;
+                        
+                        // Calculate center position based on actual footprint
+                        FVector TilePosition = FVector(
+                            (X + TileFootprint.X / 2.0f) * CellSize,
+                            (Y + TileFootprint.Y / 2.0f) * CellSize,
+                            CeilingData->CeilingHeight
+                        );
+
+                        FTransform TileTransform(CeilingData->CeilingRotation, TilePosition, FVector(1.0f));
+
+                        FPlacedCeilingInfo PlacedTile;
+                        PlacedTile.GridCoordinate = FIntPoint(X, Y);
+                        PlacedTile.TileSize = TileFootprint;  // ✅ Use actual footprint
+                        PlacedTile.MeshId = MeshPalette.Intern(SelectedTile->Mesh);
+                        PlacedTile.Transform = TileTransform;
+
+                        PlacedCeilingTiles.Add(PlacedTile);
+                        MarkCellsOccupied(X, Y, TileFootprint);  // ✅ Use actual footprint
+                        CeilingLargeTilesPlaced++;
+                    }
+                }
+            }
+        }
+    }
+
+    // ========================================================================
+    // PASS 2:  MEDIUM TILES (2x2)
+    // ========================================================================
+
+    if (CeilingData->MediumTilePool.Num() > 0)
+    {
+        CeilingOccupied.RebuildSummedAreaTable();
+        for (int32 Y = 0; Y <= GridSize.Y - 2; Y++)
+        {
+            for (int32 X = 0; X <= GridSize.X - 2; X++)
+            {
+                // ✅ CHANGED:   Use GridFootprint
+                FIntPoint TargetSize(2, 2);
+                
+                if (IsAreaAvailable(X, Y, TargetSize))
+                {
+                    const FCeilingTile* SelectedTile = SelectWeightedTile(CeilingData->MediumTilePool, CeilingData->MediumTileSampler);
+
+                    if (SelectedTile && !SelectedTile->Mesh.IsNull())
+                    {
+                        // ✅ CHANGED:   Use GridFootprint from tile
+                        FIntPoint TileFootprint = SelectedTile->GridFootprint;
+                        
+                        FVector TilePosition = FVector(
+                            (X + TileFootprint.X / 2.0f) * CellSize,
+                            (Y + TileFootprint.Y / 2.0f) * CellSize,
+                            CeilingData->CeilingHeight
+                        );
+
+                        FTransform TileTransform(CeilingData->CeilingRotation, TilePosition, FVector(1.0f));
+
+                        FPlacedCeilingInfo PlacedTile;
+                        PlacedTile.GridCoordinate = FIntPoint(X, Y);
+                        PlacedTile.TileSize = TileFootprint;
+                        PlacedTile.MeshId = MeshPalette.Intern(SelectedTile->Mesh);
+                        PlacedTile.Transform = TileTransform;
+
+                        PlacedCeilingTiles.Add(PlacedTile);
+                        MarkCellsOccupied(X, Y, TileFootprint);
+                        CeilingMediumTilesPlaced++;
+                    }
+                }
+            }
+        }
+    }
+
+    // ========================================================================
+    // PASS 3:  SMALL TILES (1x1)
+    // ========================================================================
+
+    if (CeilingData->SmallTilePool.Num() > 0)
+    {
+        for (int32 Y = 0; Y < GridSize.Y; Y++)
+        {
+            for (int32 X = 0; X < GridSize.X; X++)
+            {
+                if (!  IsCellOccupied(X, Y))
+                {
+                    const FCeilingTile* SelectedTile = SelectWeightedTile(CeilingData->SmallTilePool, CeilingData->SmallTileSampler);
+
+                    if (SelectedTile && ! SelectedTile->Mesh. IsNull())
+                    {
+                        // ✅ CHANGED:   Use GridFootprint from tile
+                        FIntPoint TileFootprint = SelectedTile->GridFootprint;
+                        
+                        FVector TilePosition = FVector(
+                            (X + TileFootprint.X / 2.0f) * CellSize,
+                            (Y + TileFootprint.Y / 2.0f) * CellSize,
+                            CeilingData->CeilingHeight
+                        );
+
+                        FTransform TileTransform(CeilingData->CeilingRotation, TilePosition, FVector(1.0f));
+
+                        FPlacedCeilingInfo PlacedTile;
+                        PlacedTile. GridCoordinate = FIntPoint(X, Y);
+                        PlacedTile.TileSize = TileFootprint;
+                        PlacedTile.MeshId = MeshPalette.Intern(SelectedTile->Mesh);
+                        PlacedTile.Transform = TileTransform;
+
+                        PlacedCeilingTiles.Add(PlacedTile);
+                        MarkCellsOccupied(X, Y, TileFootprint);
+                        CeilingSmallTilesPlaced++;
+                    }
+                }
+            }
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GenerateCeiling - Complete:    %d large, %d medium, %d small = %d total"),
+        CeilingLargeTilesPlaced, CeilingMediumTilesPlaced, CeilingSmallTilesPlaced, PlacedCeilingTiles. Num());
+
+    return true;
+}
+
+int32 FRoomGenerationCore::ExecuteForcedCeilingPlacements(FGridOccupancy& CeilingOccupied)
+{
+	if (!bIsInitialized || !Snapshot.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FRoomGenerationCore::ExecuteForcedCeilingPlacements - Not initialized! "));
+		return 0;
+	}
+
+	// Check if there are any forced placements
+	if (Snapshot->ForcedCeilingPlacements.Num() == 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("FRoomGenerationCore::ExecuteForcedCeilingPlacements - No forced ceiling tiles"));
+		return 0;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::ExecuteForcedCeilingPlacements - Processing %d forced tiles"),
+		Snapshot->ForcedCeilingPlacements. Num());
+
+	int32 SuccessfulPlacements = 0;
+	int32 FailedPlacements = 0;
+
+	// Ceiling height/rotation from the snapshot
+	const FRoomGenerationSnapshot* CeilingData = Snapshot.Get();
+	if (!CeilingData->bHasCeilingStyle)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ExecuteForcedCeilingPlacements - Failed to load CeilingStyleData"));
+		return 0;
+	}
+
+	for (int32 i = 0; i < Snapshot->ForcedCeilingPlacements.Num(); ++i)
+	{
+		const FForcedCeilingPlacement& ForcedTile = Snapshot->ForcedCeilingPlacements[i];
+		const FCeilingTile& TileInfo = ForcedTile.TileInfo;
+
+		UE_LOG(LogTemp, Log, TEXT("  Forced Tile [%d]: Coord=(%d,%d), Footprint=(%d,%d), AllowedRotations=%d"),
+			i, ForcedTile.GridCoordinate.X, ForcedTile.GridCoordinate.Y,
+			TileInfo.GridFootprint.X, TileInfo. GridFootprint.Y,
+			ForcedTile. AllowedRotations.Num());
+
+		// VALIDATION: Mesh (resolved by the snapshot)
+		if (!Snapshot->ForcedCeilingMeshLoaded[i])
+		{
+			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED:  Mesh failed to load"));
+			FailedPlacements++;
+			continue;
+		}
+
+		// ✅ FIXED:  Determine rotation with proper logic
+		FRotator TileRotation = CeilingData->CeilingRotation;  // Start with base rotation
+		int32 AdditionalYaw = 0;  // Track additional rotation for logging
+		
+		if (ForcedTile.AllowedRotations.Num() > 0)
+		{
+			// Pick random rotation from allowed list
+			int32 RandomIndex = CeilingStream.RandRange(0, ForcedTile.AllowedRotations.Num() - 1);
+			AdditionalYaw = ForcedTile.AllowedRotations[RandomIndex];
+			
+			// Add to base rotation
+			TileRotation. Yaw += AdditionalYaw;
+			
+			// ✅ NEW: Log the selected rotation
+			UE_LOG(LogTemp, Log, TEXT("    Selected rotation: %d° (from %d options, index %d)"),
+				AdditionalYaw, ForcedTile.AllowedRotations.Num(), RandomIndex);
+			UE_LOG(LogTemp, Log, TEXT("    Final rotation:  Pitch=%.1f, Yaw=%.1f, Roll=%.1f"),
+				TileRotation.Pitch, TileRotation.Yaw, TileRotation.Roll);
+		}
+		else
+		{
+			// ✅ NEW: Log default rotation usage
+			UE_LOG(LogTemp, Log, TEXT("    Using default CeilingData rotation:  Pitch=%.1f, Yaw=%.1f, Roll=%.1f"),
+				TileRotation.Pitch, TileRotation.Yaw, TileRotation.Roll);
+		}
+
+		// VALIDATION:  Check bounds (use potentially rotated footprint)
+		int32 StartX = ForcedTile. GridCoordinate.X;
+		int32 StartY = ForcedTile.GridCoordinate.Y;
+		
+		// ✅ IMPORTANT: Get rotated footprint for bounds checking
+		FIntPoint EffectiveFootprint = GetRotatedFootprint(TileInfo. GridFootprint, AdditionalYaw);
+		
+		int32 EndX = StartX + EffectiveFootprint.X;
+		int32 EndY = StartY + EffectiveFootprint.Y;
+
+		if (EndX > GridSize.X || EndY > GridSize.Y || StartX < 0 || StartY < 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED:  Out of bounds (Start=%d,%d, End=%d,%d, GridSize=%d,%d)"),
+				StartX, StartY, EndX, EndY, GridSize.X, GridSize.Y);
+			FailedPlacements++;
+			continue;
+		}
+
+		// VALIDATION: Check if area is available (use rotated footprint)
+		if (!CeilingOccupied.IsRectFree(FIntPoint(StartX, StartY), EffectiveFootprint))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED:  Area at (%d,%d) size (%dx%d) already occupied"),
+				StartX, StartY, EffectiveFootprint.X, EffectiveFootprint.Y);
+			FailedPlacements++;
+			continue;
+		}
+
+		// PLACEMENT: Calculate transform (use rotated footprint for centering)
+		FVector TilePosition = FVector(
+			(StartX + EffectiveFootprint.X / 2.0f) * CellSize,
+			(StartY + EffectiveFootprint.Y / 2.0f) * CellSize,
+			CeilingData->CeilingHeight
+		);
+
+		FTransform TileTransform(TileRotation, TilePosition, FVector(1.0f));
+
+		// TRACKING: Store placed tile
+		FPlacedCeilingInfo PlacedTile;
+		PlacedTile.GridCoordinate = FIntPoint(StartX, StartY);
+		PlacedTile.TileSize = EffectiveFootprint;  // ✅ Use rotated footprint
+		PlacedTile.MeshId = MeshPalette.Intern(TileInfo.Mesh);
+		PlacedTile.Transform = TileTransform;
+
+		PlacedCeilingTiles.Add(PlacedTile);
+		bCeilingInstancesDirty = true;
+
+		// OCCUPANCY: Mark cells as occupied (use rotated footprint)
+		CeilingOccupied.SetRect(FIntPoint(StartX, StartY), EffectiveFootprint, true);
+
+		UE_LOG(LogTemp, Log, TEXT("    ✓ Placed forced tile at (%d,%d) size (%dx%d) rotation (%.0f°)"),
+			StartX, StartY, EffectiveFootprint.X, EffectiveFootprint.Y, TileRotation.Yaw);
+		SuccessfulPlacements++;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::ExecuteForcedCeilingPlacements - Placed %d/%d tiles (%d failed)"),
+		SuccessfulPlacements, Snapshot->ForcedCeilingPlacements.Num(), FailedPlacements);
+
+	return SuccessfulPlacements;
+}
+#pragma endregion
+
+#pragma region Internal Floor Generation
+void FRoomGenerationCore::FillWithTileSize(FIntPoint TargetSize,
+	int32& OutLargeTiles,
+	int32& OutMediumTiles,
+	int32& OutSmallTiles,
+	int32& OutFillerTiles)
+{
+	// Cached sampler over tiles matching target size (or rotated version)
+	const FFloorFootprintBucket* Bucket = Snapshot->FloorFootprintBuckets.Find(TargetSize);
+	if (!Bucket) return; // No tiles of this size
+
+	const TArray<FMeshPlacementInfo>& TilePool = Snapshot->FloorTilePool;
+
+	UE_LOG(LogTemp, Verbose, TEXT("FRoomGenerationCore::FillWithTileSize - Filling with %dx%d tiles (%d options)"), 
+		TargetSize.X, TargetSize.Y, Bucket->TileIndices.Num());
+
+	// Candidate anchors come from the free-rectangle index; only placements made during this sweep can reject them
+	if (!FreeRectIndex.IsValid()) FreeRectIndex.Build(OccupancyMask);
+
+	FMemMark ScratchMark(FMemStack::Get());
+	TRoomScratchArray<FIntPoint> Anchors;
+	FreeRectIndex.GatherAnchors(TargetSize, Anchors);
+
+	// Try to place tiles of this size across the free space
+	for (const FIntPoint& StartCoord : Anchors)
+	{
+		// Check if area is available for target size
+		if (IsAreaAvailable(StartCoord, TargetSize))
+		{
+			// Select weighted random mesh (alias draw, no copy)
+			const FMeshPlacementInfo& SelectedMesh = *SelectWeightedMesh(TilePool, *Bucket);
+			FIntPoint OriginalFootprint = CalculateFootprint(SelectedMesh);
+
+			// Find rotation that matches target size
+			int32 BestRotation = 0;
+			
+			if (SelectedMesh.AllowedRotations.Num() > 0)
+			{
+				// Build list of rotations that would fit the target size
+				TArray<int32, TInlineAllocator<4>> ValidRotations;
+
+				for (int32 Rotation :  SelectedMesh.AllowedRotations)
+				{
+					FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
+					
+					if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
+					{
+						ValidRotations.Add(Rotation);
+					}
+				}
+
+				// Select random rotation from valid options
+				if (ValidRotations.Num() > 0)
+				{
+					int32 RandomIndex = FloorStream.RandRange(0, ValidRotations.Num() - 1);
+					BestRotation = ValidRotations[RandomIndex];
+				}
+			}
+
+			// Try to place mesh with selected rotation
+			if (TryPlaceMesh(StartCoord, TargetSize, SelectedMesh, BestRotation))
+			{
+				// Update statistics
+				int32 TileArea = TargetSize.X * TargetSize.Y;
+				if (TileArea >= 16) OutLargeTiles++;
+				else if (TileArea >= 4) OutMediumTiles++;
+				else if (TileArea >= 2) OutSmallTiles++;
+				else OutFillerTiles++;
+			}
+		}
+	}
+}
+
+int32 FRoomGenerationCore::FillSinglePass(int32& OutLargeTiles,
+	int32& OutMediumTiles,
+	int32& OutSmallTiles,
+	int32& OutFillerTiles)
+{
+	const TArray<FMeshPlacementInfo>& TilePool = Snapshot->FloorTilePool;
+	if (TilePool.Num() == 0)
+	{ UE_LOG(LogTemp, Warning, TEXT("FRoomGenerationCore::FillSinglePass - No meshes in tile pool! ")); return 0; }
+
+	// One cached bucket per oriented footprint present in the pool (a tile serves both of its orientations)
+	FMemMark ScratchMark(FMemStack::Get());
+	TRoomScratchArray<TPair<FIntPoint, const FFloorFootprintBucket*>> Buckets;
+	for (const TPair<FIntPoint, FFloorFootprintBucket>& Pair : Snapshot->FloorFootprintBuckets)
+	{
+		Buckets.Emplace(Pair.Key, &Pair.Value);
+	}
+
+	// Largest area first; for equal area prefer the squarer footprint, then the narrower one (2x4 before 4x2)
+	Buckets.Sort([](const TPair<FIntPoint, const FFloorFootprintBucket*>& A, const TPair<FIntPoint, const FFloorFootprintBucket*>& B)
+	{
+		const int32 AreaA = A.Key.X * A.Key.Y;
+		const int32 AreaB = B.Key.X * B.Key.Y;
+		if (AreaA != AreaB) return AreaA > AreaB;
+
+		const int32 LongA = FMath::Max(A.Key.X, A.Key.Y);
+		const int32 LongB = FMath::Max(B.Key.X, B.Key.Y);
+		if (LongA != LongB) return LongA < LongB;
+
+		return A.Key.X < B.Key.X;
+	});
+
+	UE_LOG(LogTemp, Verbose, TEXT("FRoomGenerationCore::FillSinglePass - %d footprint buckets"), Buckets.Num());
+
+	// Every free cell is a candidate anchor, visited once in row-major order
+	if (!FreeRectIndex.IsValid()) FreeRectIndex.Build(OccupancyMask);
+
+	TRoomScratchArray<FIntPoint> Anchors;
+	FreeRectIndex.GatherAnchors(FIntPoint(1, 1), Anchors);
+
+	// The index returns anchors in rectangle order; largest-first packing relies on the row-major sweep
+	Anchors.Sort([](const FIntPoint& A, const FIntPoint& B) { return A.Y != B.Y ? A.Y < B.Y : A.X < B.X; });
+
+	int32 PlacedCount = 0;
+
+	for (const FIntPoint& StartCoord : Anchors)
+	{
+		// Covered by a tile placed earlier in this sweep
+		if (OccupancyMask.IsCellOccupied(StartCoord)) continue;
+
+		for (const TPair<FIntPoint, const FFloorFootprintBucket*>& Bucket : Buckets)
+		{
+			const FIntPoint TargetSize = Bucket.Key;
+			if (!IsAreaAvailable(StartCoord, TargetSize)) continue;
+
+			// Select weighted random mesh (alias draw, no copy)
+			const FMeshPlacementInfo& SelectedMesh = *SelectWeightedMesh(TilePool, *Bucket.Value);
+			FIntPoint OriginalFootprint = CalculateFootprint(SelectedMesh);
+
+			// Find rotation that matches target size
+			int32 BestRotation = 0;
+
+			if (SelectedMesh.AllowedRotations.Num() > 0)
+			{
+				// Build list of rotations that would fit the target size
+				TArray<int32, TInlineAllocator<4>> ValidRotations;
+
+				for (int32 Rotation : SelectedMesh.AllowedRotations)
+				{
+					FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
+
+					if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
+					{
+						ValidRotations.Add(Rotation);
+					}
+				}
+
+				// Select random rotation from valid options
+				if (ValidRotations.Num() > 0)
+				{
+					int32 RandomIndex = FloorStream.RandRange(0, ValidRotations.Num() - 1);
+					BestRotation = ValidRotations[RandomIndex];
+				}
+			}
+
+			// Try to place mesh with selected rotation; largest fit wins, move to next anchor
+			if (TryPlaceMesh(StartCoord, TargetSize, SelectedMesh, BestRotation))
+			{
+				PlacedCount++;
+
+				// Update statistics
+				int32 TileArea = TargetSize.X * TargetSize.Y;
+				if (TileArea >= 16) OutLargeTiles++;
+				else if (TileArea >= 4) OutMediumTiles++;
+				else if (TileArea >= 2) OutSmallTiles++;
+				else OutFillerTiles++;
+				break;
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::FillSinglePass - Placed %d meshes"), PlacedCount);
+
+	return PlacedCount;
+}
+
+const FMeshPlacementInfo* FRoomGenerationCore::SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool, const FFloorFootprintBucket& Bucket) const
+{
+	// O(1) draw from the prebuilt alias table, mapped back to the pool entry
+	const int32 BucketIndex = Bucket.Sampler.Sample(FloorStream);
+	if (!Bucket.TileIndices.IsValidIndex(BucketIndex)) return nullptr;
+
+	return &Pool[Bucket.TileIndices[BucketIndex]];
+}
+
+bool FRoomGenerationCore::TryPlaceMesh(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
+{
+	// Check if area is available
+	if (! IsAreaAvailable(StartCoord, Size)) return false;
+
+	// Mark area as occupied
+	if (!MarkArea(StartCoord, Size, EGridCellType::ECT_FloorMesh)) return false;
+	
+	// Create placed mesh info
+	FPlacedMeshInfo PlacedMesh;
+	PlacedMesh.GridPosition = StartCoord;
+	PlacedMesh.Size = Size;
+	PlacedMesh.Rotation = Rotation;
+	PlacedMesh.MeshId = MeshPalette.Intern(MeshInfo.MeshAsset);
+
+	// Transform is derived on demand (FPlacedMeshInfo::GetLocalTransform: centered on the whole footprint)
+
+	// Store placed mesh
+	PlacedFloorMeshes.Add(PlacedMesh);
+	bFloorInstancesDirty = true;
+
+	return true;
+}
+
+FIntPoint FRoomGenerationCore::CalculateFootprint(const FMeshPlacementInfo& MeshInfo) const
+{
+	// Shared with UFloorData so cached footprint buckets agree with placement
+	// TODO: Load mesh and calculate actual bounds when GridFootprint is unset
+	return UFloorData::GetTileFootprint(MeshInfo);
+}
+#pragma endregion
+
+#pragma region Internal Preset Region Generation
+TUniquePtr<FRoomGenerationCore> FRoomGenerationCore::CreateRegionCore(const FRoomSnapshotRegionStyle& Style) const
+{
+	TUniquePtr<FRoomGenerationCore> RegionCore = MakeUnique<FRoomGenerationCore>();
+	RegionCore->SetSnapshot(Style.Snapshot);
+	RegionCore->Initialize(Style.Snapshot->GridSize, RoomGeneratorSeeds::DeriveRegionSeed(RoomSeed, Style.RegionIndex));
+	return RegionCore;
+}
+
+int32 FRoomGenerationCore::GeneratePresetRegionFloors()
+{
+	TArray<const FRoomSnapshotRegionStyle*, TInlineAllocator<16>> Jobs;
+	for (const FRoomSnapshotRegionStyle& Style : Snapshot->PresetRegionStyles)
+	{
+		if (Style.Snapshot->bHasFloorStyle && Style.Snapshot->FloorTilePool.Num() > 0) Jobs.Add(&Style);
+	}
+	if (Jobs.Num() == 0) return 0;
+
+	// Raster ownership makes the regions disjoint even when their rectangles overlap, so every job only
+	// reads the room grid and writes a core of its own
+	TArray<TUniquePtr<FRoomGenerationCore>, TInlineAllocator<16>> RegionCores;
+	RegionCores.SetNum(Jobs.Num());
+	ParallelFor(Jobs.Num(), [this, &Jobs, &RegionCores](int32 JobIndex)
+	{
+		const FRoomSnapshotRegionStyle& Style = *Jobs[JobIndex];
+		TUniquePtr<FRoomGenerationCore> RegionCore = CreateRegionCore(Style);
+		RegionCore->CreateGrid();
+
+		// Block cells another region wins, plus anything forced empty or forced placed in the room
+		const FIntPoint RegionSize = Style.Snapshot->GridSize;
+		for (int32 Y = 0; Y < RegionSize.Y; ++Y)
+		{
+			for (int32 X = 0; X < RegionSize.X; ++X)
+			{
+				const int32 RoomIndex = GridCoordToIndex(Style.Origin + FIntPoint(X, Y));
+				if (Snapshot->PresetRegionRaster[RoomIndex] != Style.RegionIndex || GridState[RoomIndex] != EGridCellType::ECT_Empty)
+				{
+					RegionCore->SetCellState(FIntPoint(X, Y), EGridCellType::ECT_Wall);
+				}
+			}
+		}
+
+		RegionCore->GenerateFloor();
+		RegionCores[JobIndex] = MoveTemp(RegionCore);
+	});
+
+	// Serial merge in region order keeps palette ids and record order independent of scheduling
+	int32 MergedCount = 0;
+	for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+	{
+		const FRoomGenerationCore& RegionCore = *RegionCores[JobIndex];
+		for (const FPlacedMeshInfo& RegionMesh : RegionCore.GetPlacedFloorMeshes())
+		{
+			FPlacedMeshInfo PlacedMesh = RegionMesh;
+			PlacedMesh.GridPosition += Jobs[JobIndex]->Origin;
+			if (!MarkArea(PlacedMesh.GridPosition, PlacedMesh.Size, EGridCellType::ECT_FloorMesh)) continue;
+
+			PlacedMesh.MeshId = MeshPalette.Intern(RegionCore.GetMeshPalette().GetMesh(RegionMesh.MeshId));
+			PlacedFloorMeshes.Add(PlacedMesh);
+			MergedCount++;
+		}
+	}
+	if (MergedCount > 0) bFloorInstancesDirty = true;
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GeneratePresetRegionFloors - %d regions, %d meshes"), Jobs.Num(), MergedCount);
+	return MergedCount;
+}
+
+int32 FRoomGenerationCore::GeneratePresetRegionCeilings(FGridOccupancy& CeilingOccupied)
+{
+	TArray<const FRoomSnapshotRegionStyle*, TInlineAllocator<16>> Jobs;
+	for (const FRoomSnapshotRegionStyle& Style : Snapshot->PresetRegionStyles)
+	{
+		if (Style.Snapshot->bHasCeilingStyle) Jobs.Add(&Style);
+	}
+	if (Jobs.Num() == 0) return 0;
+
+	TArray<TUniquePtr<FRoomGenerationCore>, TInlineAllocator<16>> RegionCores;
+	RegionCores.SetNum(Jobs.Num());
+	ParallelFor(Jobs.Num(), [this, &Jobs, &RegionCores, &CeilingOccupied](int32 JobIndex)
+	{
+		const FRoomSnapshotRegionStyle& Style = *Jobs[JobIndex];
+		TUniquePtr<FRoomGenerationCore> RegionCore = CreateRegionCore(Style);
+
+		// Reserve cells another region wins and forced ceiling tiles already placed in the room
+		const FIntPoint RegionSize = Style.Snapshot->GridSize;
+		RegionCore->ReservedCeilingCells.Init(RegionSize);
+		for (int32 Y = 0; Y < RegionSize.Y; ++Y)
+		{
+			for (int32 X = 0; X < RegionSize.X; ++X)
+			{
+				const FIntPoint RoomCell = Style.Origin + FIntPoint(X, Y);
+				if (Snapshot->PresetRegionRaster[GridCoordToIndex(RoomCell)] != Style.RegionIndex || CeilingOccupied.IsCellOccupied(RoomCell))
+				{
+					RegionCore->ReservedCeilingCells.SetCell(FIntPoint(X, Y), true);
+				}
+			}
+		}
+
+		RegionCore->GenerateCeiling();
+		RegionCores[JobIndex] = MoveTemp(RegionCore);
+	});
+
+	int32 MergedCount = 0;
+	for (int32 JobIndex = 0; JobIndex < Jobs.Num(); ++JobIndex)
+	{
+		const FRoomGenerationCore& RegionCore = *RegionCores[JobIndex];
+		const FIntPoint Origin = Jobs[JobIndex]->Origin;
+		for (const FPlacedCeilingInfo& RegionTile : RegionCore.GetPlacedCeilingTiles())
+		{
+			FPlacedCeilingInfo PlacedTile = RegionTile;
+			PlacedTile.GridCoordinate += Origin;
+
+			// A tile whose footprint outgrew its region may collide with a neighbour merged earlier
+			if (!CeilingOccupied.IsRectFree(PlacedTile.GridCoordinate, PlacedTile.TileSize)) continue;
+
+			PlacedTile.Transform.AddToTranslation(FVector(Origin.X * CellSize, Origin.Y * CellSize, 0.0f));
+			PlacedTile.MeshId = MeshPalette.Intern(RegionCore.GetMeshPalette().GetMesh(RegionTile.MeshId));
+			CeilingOccupied.SetRect(PlacedTile.GridCoordinate, PlacedTile.TileSize, true);
+			PlacedCeilingTiles.Add(PlacedTile);
+			MergedCount++;
+		}
+	}
+	if (MergedCount > 0) bCeilingInstancesDirty = true;
+
+	UE_LOG(LogTemp, Log, TEXT("FRoomGenerationCore::GeneratePresetRegionCeilings - %d regions, %d tiles"), Jobs.Num(), MergedCount);
+	return MergedCount;
+}
+#pragma endregion
+
+#pragma region Coordinate Conversion
+
+FVector FRoomGenerationCore::GridToLocalPosition(FIntPoint GridCoord) const
+{
+	// Calculate center of cell
+	float LocalX = GridCoord.X * CellSize + (CellSize * 0.5f);
+	float LocalY = GridCoord.Y * CellSize + (CellSize * 0.5f);
+	return FVector(LocalX, LocalY, 0.0f);
+}
+
+FIntPoint FRoomGenerationCore::LocalToGridPosition(FVector LocalPos) const
+{
+	// Floor division to get grid coordinate
+	int32 GridX = FMath::FloorToInt(LocalPos.X / CellSize);
+	int32 GridY = FMath:: FloorToInt(LocalPos. Y / CellSize);
+	return FIntPoint(GridX, GridY);
+}
+
+FIntPoint FRoomGenerationCore::GetRotatedFootprint(FIntPoint OriginalFootprint, int32 Rotation)
+{
+	// Normalize rotation to 0-359 range
+	Rotation = Rotation % 360;
+	if (Rotation < 0) Rotation += 360;
+
+	// For 90 and 270 degree rotations, swap X and Y
+	if (Rotation == 90 || Rotation == 270) return FIntPoint(OriginalFootprint.Y, OriginalFootprint.X);
+
+	// For 0 and 180 degree rotations, keep original
+	return OriginalFootprint;
+}
+#pragma endregion
+
+#pragma region Room Statistics
+
+int32 FRoomGenerationCore::GetCellCountByType(EGridCellType CellType) const
+{
+	int32 Count = 0;
+	for (const EGridCellType& Cell : GridState)
+	{ if (Cell == CellType) ++Count; } return Count;
+}
+
+float FRoomGenerationCore::GetOccupancyPercentage() const
+{
+	int32 TotalCells = GetTotalCellCount();
+	if (TotalCells == 0) return 0.0f;
+
+	int32 OccupiedCells = GetCellCountByType(EGridCellType::ECT_FloorMesh);
+	return (static_cast<float>(OccupiedCells) / static_cast<float>(TotalCells)) * 100.0f;
+}
+#pragma endregion
+
+#pragma region Internal Helpers
+
+int32 FRoomGenerationCore::GridCoordToIndex(FIntPoint GridCoord) const
+{
+	// Row-major order: Index = Y * Width + X
+	return GridCoord.Y * GridSize.X + GridCoord.X;
+}
+
+FIntPoint FRoomGenerationCore::IndexToGridCoord(int32 Index) const
+{
+	// Reverse row-major order
+	int32 X = Index % GridSize.X;
+	int32 Y = Index / GridSize.X;
+	return FIntPoint(X, Y);
+}
+
+void FRoomGenerationCore::InitEdgeMasks(FGridOccupancy (&EdgeMasks)[4]) const
+{
+	// North/South run along Y, East/West along X
+	EdgeMasks[GetEdgeSlot(EWallEdge::North)].Init(FIntPoint(GridSize.Y, 1));
+	EdgeMasks[GetEdgeSlot(EWallEdge::South)].Init(FIntPoint(GridSize.Y, 1));
+	EdgeMasks[GetEdgeSlot(EWallEdge::East)].Init(FIntPoint(GridSize.X, 1));
+	EdgeMasks[GetEdgeSlot(EWallEdge::West)].Init(FIntPoint(GridSize.X, 1));
+}
+
+bool FRoomGenerationCore::DoesEdgeMaskOverlap(const FGridOccupancy& EdgeMask, int32 StartCell, int32 Length)
+{
+	if (!EdgeMask.IsInitialized()) return false;
+
+	// Clip to the edge; cells beyond it are never marked
+	const int32 SpanStart = FMath::Max(StartCell, 0);
+	const int32 SpanEnd = FMath::Min(StartCell + Length, EdgeMask.GetGridSize().X);
+	if (SpanStart >= SpanEnd) return false;
+
+	return !EdgeMask.IsRectFree(FIntPoint(SpanStart, 0), FIntPoint(SpanEnd - SpanStart, 1));
+}
+
+void FRoomGenerationCore::FillWallEdge(EWallEdge Edge)
+{
+    if (!Snapshot.IsValid() || Snapshot->WallModules.Num() == 0) return;
+
+    if (Snapshot->bUseOptimalWallPacker && !Snapshot->WallRunPacker.IsEmpty())
+    {
+        FillWallEdgeOptimal(Edge);
+        return;
+    }
+
+    const int32 EdgeLength = UDungeonGenerationHelpers::GetEdgeLength(Edge, GridSize);
+    if (EdgeLength == 0) return;
+
+    FRotator WallRotation = UDungeonGenerationHelpers:: GetWallRotationForEdge(Edge);
+    UE_LOG(LogTemp, Verbose, TEXT("  Filling edge %s with %d cells"),
+        *UEnum::GetValueAsString(Edge), EdgeLength);
+
+    // Greedy bin packing: Fill with largest modules first (BASE LAYER ONLY)
+    int32 CurrentCell = 0;
+
+    while (CurrentCell < EdgeLength)
+    {
+        // Check if THIS SPECIFIC CELL is part of a doorway (edge mask, no doorway loop)
+        if (DoesEdgeSpanOverlapDoorway(Edge, CurrentCell, 1))
+        {
+            UE_LOG(LogTemp, VeryVerbose, TEXT("    Skipping cell %d (part of doorway)"), CurrentCell);
+            CurrentCell++;
+            continue;
+        }
+        
+        // Skip cells occupied by forced walls
+        if (IsCellRangeOccupied(Edge, CurrentCell, 1))
+        {
+            UE_LOG(LogTemp, VeryVerbose, TEXT("    Skipping cell %d (occupied by forced wall)"), CurrentCell);
+            CurrentCell++;
+            continue;
+        }
+        
+        // Find largest module that fits remaining space
+        const FRoomSnapshotWallModule* BestResolved = nullptr;
+        const FWallModule* BestModule = nullptr;
+        int32 SpaceLeft = EdgeLength - CurrentCell;
+
+        for (const FRoomSnapshotWallModule& Resolved : Snapshot->WallModules)
+        {
+            const FWallModule& Module = Resolved.Module;
+
+            // Check if the ENTIRE module span overlaps with doorways (single mask test)
+            if (DoesEdgeSpanOverlapDoorway(Edge, CurrentCell, Module.Y_AxisFootprint))
+            {
+                continue;  // Skip this module - it would overlap a doorway
+            }
+            
+            if (Module.Y_AxisFootprint <= SpaceLeft && 
+                !  IsCellRangeOccupied(Edge, CurrentCell, Module.Y_AxisFootprint))
+            {
+                if (!  BestModule || Module.Y_AxisFootprint > BestModule->Y_AxisFootprint)
+                {
+                    BestResolved = &Resolved;
+                    BestModule = &Module;
+                }
+            }
+        }
+
+        if (! BestModule)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("    No wall module fits remaining %d cells on edge %s at cell %d"), 
+                SpaceLeft, *UEnum::GetValueAsString(Edge), CurrentCell);
+            CurrentCell++;  // Skip this cell and try next
+            continue;
+        }
+
+        // Base mesh must have resolved
+        if (!BestResolved->bBaseMeshLoaded)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("    Failed to load base mesh for wall module"));
+            break;
+        }
+
+        PlaceBaseWallModule(Edge, CurrentCell, *BestResolved, WallRotation);
+
+        // Advance to next segment
+        CurrentCell += BestModule->Y_AxisFootprint;
+    }
+}
+
+void FRoomGenerationCore::FillWallEdgeOptimal(EWallEdge Edge)
+{
+    const int32 EdgeLength = UDungeonGenerationHelpers::GetEdgeLength(Edge, GridSize);
+    const FRotator WallRotation = UDungeonGenerationHelpers::GetWallRotationForEdge(Edge);
+
+    auto IsCellBlocked = [this, Edge](int32 Cell)
+    {
+        return DoesEdgeSpanOverlapDoorway(Edge, Cell, 1) || IsCellRangeOccupied(Edge, Cell, 1);
+    };
+
+    // Lives under GenerateWalls' FMemMark
+    TRoomScratchArray<int32> Pieces;
+    int32 CurrentCell = 0;
+    int32 ModulesPlaced = 0;
+    int32 CellsUncovered = 0;
+
+    while (CurrentCell < EdgeLength)
+    {
+        if (IsCellBlocked(CurrentCell)) { ++CurrentCell; continue; }
+
+        // Maximal free run between doorways / forced walls
+        int32 RunEnd = CurrentCell + 1;
+        while (RunEnd < EdgeLength && !IsCellBlocked(RunEnd)) { ++RunEnd; }
+
+        CellsUncovered += Snapshot->WallRunPacker.Solve(RunEnd - CurrentCell, Pieces);
+
+        // Any order of the same pieces covers the run equally well; shuffle so long walls don't always lead with the largest module
+        for (int32 i = Pieces.Num() - 1; i > 0; --i) { Pieces.Swap(i, WallStream.RandRange(0, i)); }
+
+        for (const int32 Footprint : Pieces)
+        {
+            if (Footprint > 0)
+            {
+                // Weighted pick among modules sharing this footprint
+                const FWallFootprintBucket& Bucket = Snapshot->WallFootprintBuckets.FindChecked(Footprint);
+                const int32 BucketIndex = Bucket.Sampler.Sample(WallStream);
+                const FRoomSnapshotWallModule& Resolved = Snapshot->WallModules[Bucket.ModuleIndices[BucketIndex]];
+
+                if (Resolved.bBaseMeshLoaded)
+                {
+                    PlaceBaseWallModule(Edge, CurrentCell, Resolved, WallRotation);
+                    ++ModulesPlaced;
+                }
+                else
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("    Failed to load base mesh for %d-cell wall module, leaving gap at cell %d"), Footprint, CurrentCell);
+                    CellsUncovered += Footprint;
+                }
+            }
+            CurrentCell += FMath::Max(Footprint, 1);
+        }
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("  Packed edge %s: %d modules, %d cells uncovered"),
+        *UEnum::GetValueAsString(Edge), ModulesPlaced, CellsUncovered);
+}
+
+void FRoomGenerationCore::PlaceBaseWallModule(EWallEdge Edge, int32 StartCell, const FRoomSnapshotWallModule& Resolved, const FRotator& WallRotation)
+{
+    const int32 Footprint = Resolved.Module.Y_AxisFootprint;
+
+    // Calculate position for this wall segment
+    FVector BasePosition = UDungeonGenerationHelpers::CalculateWallPosition(Edge, StartCell, Footprint, GridSize, CellSize,
+        Snapshot->NorthWallOffsetX, Snapshot->SouthWallOffsetX, Snapshot->EastWallOffsetY, Snapshot->WestWallOffsetY);
+
+    // Store segment info for Middle/Top spawning
+    FGeneratorWallSegment Segment;
+    Segment.Edge = Edge;
+    Segment.StartCell = StartCell;
+    Segment.SegmentLength = Footprint;
+    Segment.BaseTransform = FTransform(WallRotation, BasePosition, FVector::OneVector);
+    Segment.WallModule = &Resolved;
+    Segment.SourceSnapshot = Snapshot;
+
+    TrackBaseWallSegment(Segment);
+
+    UE_LOG(LogTemp, VeryVerbose, TEXT("    Tracked %d-cell base wall at cell %d"), Footprint, StartCell);
+}
+#pragma endregion
@@ -0,0 +1,251 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Generators/Room/RoomGenerationSnapshot.h"
+#include "Utilities/Helpers/DungeonGenerationHelpers.h"
+#include "Data/Room/DoorData.h"
+#include "Data/Room/RoomData.h"
+#include "Data/Room/WallData.h"
+
+FDoorPositionOffsets FRoomSnapshotDoorStyle::GetOffsetsForEdge(EWallEdge Edge) const
+{
+	switch (Edge)
+	{
+	case EWallEdge::North: return NorthEdgeOffsets;
+	case EWallEdge::South: return SouthEdgeOffsets;
+	case EWallEdge::East:  return EastEdgeOffsets;
+	case EWallEdge::West:  return WestEdgeOffsets;
+	default:               return FDoorPositionOffsets();
+	}
+}
+
+bool FRoomGenerationSnapshot::Build(URoomData* RoomData, FIntPoint InGridSize)
+{
+	check(IsInGameThread());
+
+	// Every LoadSynchronous below is a resident lookup once URoomGenerator::PreloadAssetsAsync has completed
+
+	if (!RoomData)
+	{ UE_LOG(LogTemp, Error, TEXT("FRoomGenerationSnapshot::Build - RoomData is null!")); return false; }
+
+	GridSize = InGridSize;
+	CellSize = CELL_SIZE;
+
+	// PRESET LAYOUT
+	bUsePresetLayout = false;
+	PresetRegions.Reset();
+	PresetRegionRaster.Reset();
+	PresetRegionStyles.Reset();
+	URoomPreset* Preset = nullptr;
+	if (RoomData->bUsePresetLayout && !RoomData->PresetLayout.IsNull())
+	{
+		Preset = RoomData->PresetLayout.LoadSynchronous();
+		if (Preset)
+		{
+			bUsePresetLayout = true;
+			PresetRegions = Preset->Regions;
+			Preset->BuildRegionRaster(GridSize, PresetRegionRaster);
+			ResolvePresetRegionStyles();
+		}
+	}
+
+	// FLOOR
+	ForcedFloorPlacements = RoomData->ForcedFloorPlacements;
+	ForcedEmptyRegions = RoomData->ForcedEmptyRegions;
+	ForcedEmptyFloorCells = RoomData->ForcedEmptyFloorCells;
+
+	// A preset's default style covers the cells outside its regions; otherwise the room's own style does
+	UFloorData* FloorData = Preset ? Preset->DefaultFloorStyle.LoadSynchronous() : nullptr;
+	if (!FloorData) FloorData = RoomData->FloorStyleData.LoadSynchronous();
+	ResolveFloorStyle(FloorData);
+
+	// WALLS + CORNERS
+	UWallData* WallData = RoomData->WallStyleData.LoadSynchronous();
+	bHasWallStyle = WallData != nullptr;
+	WallModules.Reset();
+	WallModuleSampler.Reset();
+	bUseOptimalWallPacker = false;
+	WallFootprintBuckets.Reset();
+	WallRunPacker.Reset();
+	bCornerMeshLoaded = false;
+	DefaultCornerMesh.Reset();
+	if (WallData)
+	{
+		NorthWallOffsetX = WallData->NorthWallOffsetX;
+		SouthWallOffsetX = WallData->SouthWallOffsetX;
+		EastWallOffsetY = WallData->EastWallOffsetY;
+		WestWallOffsetY = WallData->WestWallOffsetY;
+		WallHeight = WallData->WallHeight;
+
+		for (int32 i = 0; i < WallData->AvailableWallModules.Num(); ++i)
+		{
+			WallModules.Add(ResolveWallModule(WallData->AvailableWallModules[i], FString::Printf(TEXT("WallModule[%d]"), i), WallData));
+		}
+		WallModuleSampler = WallData->GetModuleSampler();
+
+		bUseOptimalWallPacker = WallData->bUseOptimalPacker;
+		if (bUseOptimalWallPacker)
+		{
+			WallFootprintBuckets = WallData->GetFootprintBuckets();
+			WallRunPacker = WallData->GetRunPacker(FMath::Max(GridSize.X, GridSize.Y));
+		}
+
+		DefaultCornerMesh = WallData->DefaultCornerMesh;
+		bCornerMeshLoaded = !DefaultCornerMesh.IsNull() && DefaultCornerMesh.LoadSynchronous() != nullptr;
+		SouthWestCornerOffset = WallData->SouthWestCornerOffset;
+		SouthEastCornerOffset = WallData->SouthEastCornerOffset;
+		NorthEastCornerOffset = WallData->NorthEastCornerOffset;
+		NorthWestCornerOffset = WallData->NorthWestCornerOffset;
+		SouthWestCornerRotation = WallData->SouthWestCornerRotation;
+		SouthEastCornerRotation = WallData->SouthEastCornerRotation;
+		NorthEastCornerRotation = WallData->NorthEastCornerRotation;
+		NorthWestCornerRotation = WallData->NorthWestCornerRotation;
+	}
+	else
+	{
+		// Same defaults forced walls and the stacking passes used when no WallData could be loaded
+		NorthWallOffsetX = SouthWallOffsetX = EastWallOffsetY = WestWallOffsetY = 0.0f;
+		WallHeight = 100.0f;
+	}
+
+	ForcedWallPlacements = RoomData->ForcedWallPlacements;
+	ForcedWallModules.Reset();
+	for (int32 i = 0; i < ForcedWallPlacements.Num(); ++i)
+	{
+		ForcedWallModules.Add(ResolveWallModule(ForcedWallPlacements[i].WallModule, FString::Printf(TEXT("ForcedWall[%d]"), i), WallData));
+	}
+
+	// DOORWAYS
+	ForcedDoorways = RoomData->ForcedDoorways;
+	DefaultDoorData = RoomData->DefaultDoorData;
+	bGenerateStandardDoorway = RoomData->bGenerateStandardDoorway;
+	bSetStandardDoorwayEdge = RoomData->bSetStandardDoorwayEdge;
+	StandardDoorwayEdge = RoomData->StandardDoorwayEdge;
+	bMultipleDoorways = RoomData->bMultipleDoorways;
+	NumAutomaticDoorways = RoomData->NumAutomaticDoorways;
+	StandardDoorwayWidth = RoomData->StandardDoorwayWidth;
+
+	DoorStyles.Reset();
+	AddDoorStyle(DefaultDoorData);
+	for (const FFixedDoorLocation& ForcedDoor : ForcedDoorways) { AddDoorStyle(ForcedDoor.DoorData); }
+
+	// CEILING
+	UCeilingData* CeilingData = Preset ? Preset->DefaultCeilingStyle.LoadSynchronous() : nullptr;
+	if (!CeilingData) CeilingData = RoomData->CeilingStyleData.LoadSynchronous();
+	ResolveCeilingStyle(CeilingData);
+
+	ForcedCeilingPlacements = RoomData->ForcedCeilingPlacements;
+	ForcedCeilingMeshLoaded.Reset();
+	for (const FForcedCeilingPlacement& ForcedTile : ForcedCeilingPlacements)
+	{
+		ForcedCeilingMeshLoaded.Add(ForcedTile.TileInfo.Mesh.LoadSynchronous() != nullptr);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("FRoomGenerationSnapshot::Build - %d floor tiles, %d wall modules, %d door styles, %d preset regions (%d styled)"),
+		FloorTilePool.Num(), WallModules.Num(), DoorStyles.Num(), PresetRegions.Num(), PresetRegionStyles.Num());
+	return true;
+}
+
+void FRoomGenerationSnapshot::ResolveFloorStyle(UFloorData* FloorData)
+{
+	bHasFloorStyle = FloorData != nullptr;
+	bUseSinglePassPacker = FloorData && FloorData->bUseSinglePassPacker;
+	FloorTilePool = FloorData ? FloorData->FloorTilePool : TArray<FMeshPlacementInfo>();
+	FloorFootprintBuckets = FloorData ? FloorData->GetFootprintBuckets() : TMap<FIntPoint, FFloorFootprintBucket>();
+}
+
+void FRoomGenerationSnapshot::ResolveCeilingStyle(UCeilingData* CeilingData)
+{
+	bHasCeilingStyle = CeilingData != nullptr;
+	LargeTilePool.Reset();
+	MediumTilePool.Reset();
+	SmallTilePool.Reset();
+	LargeTileSampler.Reset();
+	MediumTileSampler.Reset();
+	SmallTileSampler.Reset();
+	if (CeilingData)
+	{
+		LargeTilePool = CeilingData->LargeTilePool;
+		MediumTilePool = CeilingData->MediumTilePool;
+		SmallTilePool = CeilingData->SmallTilePool;
+		LargeTileSampler = CeilingData->GetLargeTileSampler();
+		MediumTileSampler = CeilingData->GetMediumTileSampler();
+		SmallTileSampler = CeilingData->GetSmallTileSampler();
+		CeilingHeight = CeilingData->CeilingHeight;
+		CeilingRotation = CeilingData->CeilingRotation;
+	}
+}
+
+void FRoomGenerationSnapshot::ResolvePresetRegionStyles()
+{
+	// Only regions that can own raster cells (see URoomPreset::BuildRegionRaster) get a snapshot
+	const int32 NumRasterRegions = FMath::Min(PresetRegions.Num(), static_cast<int32>(URoomPreset::NoRegion));
+	for (int32 RegionIndex = 0; RegionIndex < NumRasterRegions; ++RegionIndex)
+	{
+		const FPresetRegion& Region = PresetRegions[RegionIndex];
+		if (Region.FillPriority < 0) continue;
+
+		const FIntPoint Min(FMath::Max(Region.StartCell.X, 0), FMath::Max(Region.StartCell.Y, 0));
+		const FIntPoint Max(FMath::Min(Region.EndCell.X, GridSize.X - 1), FMath::Min(Region.EndCell.Y, GridSize.Y - 1));
+		if (Max.X < Min.X || Max.Y < Min.Y) continue;
+
+		UFloorData* RegionFloorData = Region.RegionFloorStyle.LoadSynchronous();
+		UCeilingData* RegionCeilingData = Region.RegionCeilingStyle.LoadSynchronous();
+		if (!RegionFloorData && !RegionCeilingData) continue;
+
+		TSharedRef<FRoomGenerationSnapshot> RegionSnapshot = MakeShared<FRoomGenerationSnapshot>();
+		RegionSnapshot->GridSize = Max - Min + FIntPoint(1, 1);
+		RegionSnapshot->CellSize = CellSize;
+		RegionSnapshot->ResolveFloorStyle(RegionFloorData);
+		RegionSnapshot->ResolveCeilingStyle(RegionCeilingData);
+
+		FRoomSnapshotRegionStyle& Style = PresetRegionStyles.AddDefaulted_GetRef();
+		Style.RegionIndex = RegionIndex;
+		Style.Origin = Min;
+		Style.Snapshot = RegionSnapshot;
+	}
+}
+
+FRoomSnapshotWallModule FRoomGenerationSnapshot::ResolveWallModule(const FWallModule& Module, const FString& ContextName, const UWallData* WallData) const
+{
+	FRoomSnapshotWallModule Resolved;
+	Resolved.Module = Module;
+
+	UStaticMesh* BaseMesh = UDungeonGenerationHelpers::LoadAndValidateMesh(Module.BaseMesh, ContextName, false);
+	UStaticMesh* Middle1Mesh = Module.MiddleMesh1.LoadSynchronous();
+	UStaticMesh* Middle2Mesh = Module.MiddleMesh2.LoadSynchronous();
+
+	Resolved.bBaseMeshLoaded = BaseMesh != nullptr;
+	Resolved.bMiddleMesh1Loaded = Middle1Mesh != nullptr;
+	Resolved.bMiddleMesh2Loaded = Middle2Mesh != nullptr;
+	Resolved.bTopMeshLoaded = Module.TopMesh.LoadSynchronous() != nullptr;
+
+	// Socket relative to its own layer; chaining with a parent transform happens during generation
+	const FVector Fallback(0, 0, WallHeight);
+	const FName StackSocketName("TopBackCenter");
+	auto ResolveSocket = [WallData, &StackSocketName, &Fallback](UStaticMesh* Mesh)
+	{
+		return WallData
+			? WallData->GetSocketTransform(Mesh, StackSocketName, Fallback)
+			: UDungeonGenerationHelpers::CalculateSocketWorldTransform(Mesh, StackSocketName, FTransform::Identity, Fallback);
+	};
+	Resolved.BaseTopSocket = ResolveSocket(BaseMesh);
+	Resolved.Middle1TopSocket = ResolveSocket(Middle1Mesh);
+	Resolved.Middle2TopSocket = ResolveSocket(Middle2Mesh);
+
+	return Resolved;
+}
+
+void FRoomGenerationSnapshot::AddDoorStyle(const UDoorData* DoorData)
+{
+	if (!DoorData || DoorStyles.Contains(DoorData)) return;
+
+	FRoomSnapshotDoorStyle& Style = DoorStyles.Add(DoorData);
+	Style.TotalDoorwayWidth = DoorData->GetTotalDoorwayWidth();
+	Style.FrameFootprintY = DoorData->FrameFootprintY;
+	Style.SideFillType = DoorData->SideFillType;
+	Style.FrameRotationOffset = DoorData->FrameRotationOffset;
+	Style.NorthEdgeOffsets = DoorData->NorthEdgeOffsets;
+	Style.SouthEdgeOffsets = DoorData->SouthEdgeOffsets;
+	Style.EastEdgeOffsets = DoorData->EastEdgeOffsets;
+	Style.WestEdgeOffsets = DoorData->WestEdgeOffsets;
+}
@@ -1,14 +1,26 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Generators/Room/RoomGenerator.h"
-#include "Utilities/Helpers/DungeonGenerationHelpers.h" 
-#include "Data/Grid/GridData.h"
-#include "Data/Room/CeilingData.h"
-#include "Data/Room/DoorData.h"
-#include "Data/Room/FloorData.h"
-#include "Data/Room/WallData.h"
-
-bool URoomGenerator::Initialize(URoomData* InRoomData, FIntPoint InGridSize)
+#include "Generators/Room/RoomGenerationCore.h"
+#include "Generators/Room/RoomGenerationSnapshot.h"
+#include "Utilities/Helpers/DungeonGenerationHelpers.h"
+#include "Engine/AssetManager.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+URoomGenerator::URoomGenerator()
+	: RoomData(nullptr)
+	, GridSize(FIntPoint::ZeroValue)
+	, CellSize(CELL_SIZE)
+	, bIsInitialized(false)
+	, RoomSeed(0)
+	, bAsyncGenerationPending(false)
+	, Core(MakeShared<FRoomGenerationCore>())
+	, bPreloadPending(false)
+{
+}
+
+bool URoomGenerator::Initialize(URoomData* InRoomData, FIntPoint InGridSize, int32 InSeed)
 {
 	if (!InRoomData)
 	{
@@ -16,147 +28,159 @@ bool URoomGenerator::Initialize(URoomData* InRoomData, FIntPoint InGridSize)
 		return false;
 	}
 
+	// Handles from a previous RoomData would keep its assets resident for nothing
+	if (RoomData != InRoomData && !bPreloadPending) ReleasePreloadedAssets();
+
 	RoomData = InRoomData;
 	GridSize = InGridSize;
 	CellSize = CELL_SIZE;
+	RoomSeed = InSeed;
 	bIsInitialized = true;
 
-	// Initialize statistics
-	LargeTilesPlaced = 0;
-	MediumTilesPlaced = 0;
-	SmallTilesPlaced = 0;
-	FillerTilesPlaced = 0;
+	// No snapshot yet: each generation entry point (or the async job, after its preload) builds its own, so
+	// initializing never loads assets on the game thread
+	Core->Initialize(GridSize, RoomSeed);
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::Initialize - Initialized with GridSize (%d, %d), CellSize %.2f"), 
-	GridSize.X, GridSize.Y, CellSize);
+	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::Initialize - Initialized with GridSize (%d, %d), CellSize %.2f, Seed %d"), 
+	GridSize.X, GridSize.Y, CellSize, RoomSeed);
 	return true;
 }
 
-#pragma region Room Grid Management
-void URoomGenerator::CreateGrid()
+void URoomGenerator::SetSeed(int32 InSeed)
 {
-	if (!bIsInitialized) { UE_LOG(LogTemp, Error, TEXT("URoomGenerator::CreateGrid - Generator not initialized!")); return; }
-
-	// Calculate total cells needed
-	int32 TotalCells = GridSize.X * GridSize.Y;
-
-	// Initialize grid with all cells set to Empty
-	GridState.Empty(TotalCells);
-	GridState.AddUninitialized(TotalCells);
-
-	for (int32 i = 0; i < TotalCells; ++i) { GridState[i] = EGridCellType::ECT_Empty; }
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::CreateGrid - Created grid with %d cells"), TotalCells);
+	RoomSeed = InSeed;
+	Core->SetSeed(InSeed);
 }
 
-void URoomGenerator:: ClearGrid()
+const FRandomStream& URoomGenerator::GetClutterStream() const
 {
-	GridState.Empty();
-	PlacedFloorMeshes. Empty();
-	PlacedWallMeshes.Empty();
-	PlacedBaseWallSegments.Empty();
-
-	// Reset statistics
-	LargeTilesPlaced = 0;
-	MediumTilesPlaced = 0;
-	SmallTilesPlaced = 0;
-	FillerTilesPlaced = 0;
-	
-	bIsInitialized = false;
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ClearGrid - Grid cleared"));
+	return Core->GetClutterStream();
 }
 
-void URoomGenerator::ResetGridCellStates()
+#pragma region Background Generation
+bool URoomGenerator::PreloadAssetsAsync(FOnRoomAssetsPreloaded OnComplete)
 {
-	if (! bIsInitialized)
-	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::ResetGridCellStates - Not initialized! ")); return; }
+	if (!RoomData)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::PreloadAssetsAsync - RoomData is null!")); return false; }
+
+	if (bPreloadPending)
+	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::PreloadAssetsAsync - Preload already in flight")); return false; }
+
+	bPreloadPending = true;
+	RequestedStylePaths.Reset();
 
-	// Reset all cells to empty
-	int32 CellsReset = 0;
-	for (EGridCellType& Cell : GridState)
+	// The last preload's handles are dropped once this one holds its own, so shared assets are never unpinned in between
+	TArray<TSharedPtr<FStreamableHandle>> PreviousHandles = MoveTemp(PreloadHandles);
+	PreloadHandles.Reset();
+
+	RequestStylePreload(FOnRoomAssetsPreloaded::CreateLambda([PreviousHandles, OnComplete](bool bAllLoaded)
 	{
-		if (Cell != EGridCellType::ECT_Empty)
+		for (const TSharedPtr<FStreamableHandle>& Handle : PreviousHandles)
 		{
-			Cell = EGridCellType:: ECT_Empty;
-			CellsReset++;
+			if (Handle.IsValid()) Handle->ReleaseHandle();
 		}
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ResetGridCellStates - Reset %d cells to empty (Total: %d)"), 
-		CellsReset, GridState.Num());
+		OnComplete.ExecuteIfBound(bAllLoaded);
+	}));
+	return true;
 }
 
-EGridCellType URoomGenerator:: GetCellState(FIntPoint GridCoord) const
+void URoomGenerator::ReleasePreloadedAssets()
 {
-	if (!IsValidGridCoordinate(GridCoord)) return EGridCellType::ECT_Empty;
-	int32 Index = GridCoordToIndex(GridCoord); return GridState[Index];
+	for (const TSharedPtr<FStreamableHandle>& Handle : PreloadHandles)
+	{
+		if (Handle.IsValid()) Handle->ReleaseHandle();
+	}
+	PreloadHandles.Reset();
 }
 
-bool URoomGenerator::SetCellState(FIntPoint GridCoord, EGridCellType NewState)
+bool URoomGenerator::GenerateAllAsync(FOnRoomLayoutGenerated OnComplete)
 {
-	if (!IsValidGridCoordinate(GridCoord))	return false;
+	if (!bIsInitialized)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateAllAsync - Generator not initialized!")); return false; }
 
-	int32 Index = GridCoordToIndex(GridCoord);
-	GridState[Index] = NewState; return true;
-}
+	if (bAsyncGenerationPending)
+	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::GenerateAllAsync - Generation already in flight")); return false; }
 
-bool URoomGenerator::IsValidGridCoordinate(FIntPoint GridCoord) const
-{
-	return GridCoord.X >= 0 && GridCoord.X < GridSize.X && GridCoord.Y >= 0 && GridCoord.Y < GridSize.Y;
+	// Stream everything in first so the snapshot's loads are all resident lookups
+	bAsyncGenerationPending = true;
+	const bool bRequested = PreloadAssetsAsync(FOnRoomAssetsPreloaded::CreateWeakLambda(this, [this, OnComplete](bool bAllLoaded)
+	{
+		// Missing assets are not fatal: the snapshot records them as unloaded, exactly as a synchronous build would
+		LaunchGenerationJob(OnComplete);
+	}));
+
+	if (!bRequested) bAsyncGenerationPending = false;
+	return bRequested;
 }
 
-bool URoomGenerator::IsAreaAvailable(FIntPoint StartCoord, FIntPoint Size) const
+void URoomGenerator::LaunchGenerationJob(FOnRoomLayoutGenerated OnComplete)
 {
-	// Check if entire area fits within grid
-	if (StartCoord.X + Size.X > GridSize. X || StartCoord.Y + Size.Y > GridSize.Y) return false;
-
-	// Check if any cell in the area is occupied
-	for (int32 X = 0; X < Size.X; ++X)
+	// Everything that touches UObjects happens here, on the game thread
+	TSharedPtr<const FRoomGenerationSnapshot> Snapshot = BuildSnapshot();
+	if (!Snapshot.IsValid())
 	{
-		for (int32 Y = 0; Y < Size.Y; ++Y)
-		{
-			FIntPoint CheckCoord(StartCoord.X + X, StartCoord.Y + Y);
-			if (GetCellState(CheckCoord) != EGridCellType::ECT_Empty) return false;
-		}
+		bAsyncGenerationPending = false;
+		OnComplete.ExecuteIfBound(false);
+		return;
 	}
-	return true;
-}
 
-bool URoomGenerator::MarkArea(FIntPoint StartCoord, FIntPoint Size, EGridCellType CellType)
-{
-	// Validate that area is available
-	if (!IsAreaAvailable(StartCoord, Size))	return false;
+	// The job gets its own core, so the current one stays readable (and spawnable) until the swap
+	TSharedRef<FRoomGenerationCore> Job = MakeShared<FRoomGenerationCore>();
+	Job->Initialize(GridSize, RoomSeed);
+	Job->SetSnapshot(Snapshot);
+	Job->SetEmitInstanceBuffers(Core->IsEmittingInstanceBuffers());
+
+	TWeakObjectPtr<URoomGenerator> WeakThis(this);
 
-	// Mark all cells in area
-	for (int32 X = 0; X < Size.X; ++X)
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job, WeakThis, OnComplete]()
 	{
-		for (int32 Y = 0; Y < Size.Y; ++Y)
+		const bool bSuccess = Job->GenerateAll();
+
+		AsyncTask(ENamedThreads::GameThread, [Job, WeakThis, OnComplete, bSuccess]()
 		{
-			FIntPoint CellCoord(StartCoord. X + X, StartCoord. Y + Y);
-			SetCellState(CellCoord, CellType);
-		}
-	}
-	return true;
+			URoomGenerator* Generator = WeakThis.Get();
+			if (!Generator) return;
+
+			Generator->Core = Job;
+			Generator->bAsyncGenerationPending = false;
+			OnComplete.ExecuteIfBound(bSuccess);
+		});
+	});
 }
+#pragma endregion
 
-bool URoomGenerator::ClearArea(FIntPoint StartCoord, FIntPoint Size)
+#pragma region Room Grid Management
+void URoomGenerator::CreateGrid()
 {
-	// Validate coordinates
-	if (StartCoord.X + Size. X > GridSize.X || StartCoord.Y + Size.Y > GridSize.Y) return false;
+	if (!bIsInitialized) { UE_LOG(LogTemp, Error, TEXT("URoomGenerator::CreateGrid - Generator not initialized!")); return; }
+	Core->CreateGrid();
+}
 
-	// Clear all cells in area
-	for (int32 X = 0; X < Size.X; ++X)
-	{
-		for (int32 Y = 0; Y < Size.Y; ++Y)
-		{
-			FIntPoint CellCoord(StartCoord.X + X, StartCoord.Y + Y);
-			SetCellState(CellCoord, EGridCellType::ECT_Empty);
-		}
-	}
-	return true;
+void URoomGenerator::ClearGrid()
+{
+	Core->ClearGrid();
+	bIsInitialized = false;
 }
 
+void URoomGenerator::ResetGridCellStates()
+{
+	Core->ResetGridCellStates();
+}
 
+const FRoomMeshPalette& URoomGenerator::GetMeshPalette() const { return Core->GetMeshPalette(); }
+void URoomGenerator::SetEmitInstanceBuffers(bool bEnable) { Core->SetEmitInstanceBuffers(bEnable); }
+const FMeshInstanceBuffers& URoomGenerator::GetFloorInstances() const { return Core->GetFloorInstances(); }
+const FMeshInstanceBuffers& URoomGenerator::GetWallInstances() const { return Core->GetWallInstances(); }
+const FMeshInstanceBuffers& URoomGenerator::GetCornerInstances() const { return Core->GetCornerInstances(); }
+const FMeshInstanceBuffers& URoomGenerator::GetCeilingInstances() const { return Core->GetCeilingInstances(); }
+
+const TArray<EGridCellType>& URoomGenerator::GetGridState() const { return Core->GetGridState(); }
+EGridCellType URoomGenerator::GetCellState(FIntPoint GridCoord) const { return Core->GetCellState(GridCoord); }
+bool URoomGenerator::SetCellState(FIntPoint GridCoord, EGridCellType NewState) { return Core->SetCellState(GridCoord, NewState); }
+bool URoomGenerator::IsValidGridCoordinate(FIntPoint GridCoord) const { return Core->IsValidGridCoordinate(GridCoord); }
+bool URoomGenerator::IsAreaAvailable(FIntPoint StartCoord, FIntPoint Size) const { return Core->IsAreaAvailable(StartCoord, Size); }
+bool URoomGenerator::MarkArea(FIntPoint StartCoord, FIntPoint Size, EGridCellType CellType) { return Core->MarkArea(StartCoord, Size, CellType); }
+bool URoomGenerator::ClearArea(FIntPoint StartCoord, FIntPoint Size) { return Core->ClearArea(StartCoord, Size); }
 #pragma endregion
 
 #pragma region RoomPreset Layout Management
@@ -174,1890 +198,194 @@ URoomPreset* URoomGenerator::GetPresetLayout() const
 
 const FPresetRegion* URoomGenerator::GetRegionAtCoordinate(FIntPoint GridCoordinate) const
 {
-	URoomPreset* PresetLayout = GetPresetLayout();
-	if (!PresetLayout) return nullptr;
-	return PresetLayout->GetRegionAtCoordinate(GridCoordinate, GridSize);
+	// Answered from the snapshot's copy of the preset regions (no load per query)
+	return Core->GetRegionAtCoordinate(GridCoordinate);
 }
 #pragma endregion
 
 #pragma region Floor Generation
 bool URoomGenerator::GenerateFloor()
 {
-	if (!bIsInitialized)
-	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateFloor - Generator not initialized!")); return false; }
-
-	if (! RoomData || !RoomData->FloorStyleData)
-	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator:: GenerateFloor - FloorData not assigned!")); return false; }
-
-	// Load FloorData and keep strong reference throughout function
-	UFloorData* FloorStyleData = RoomData->FloorStyleData.LoadSynchronous();
-	if (!FloorStyleData)
-	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateFloor - Failed to load FloorStyleData!")); return false; }
-
-	// Validate FloorTilePool exists
-	if (FloorStyleData->FloorTilePool. Num() == 0)
-	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::GenerateFloor - No floor meshes defined in FloorTilePool!")); return false;}
-	
-	// Clear previous placement data
-	ClearPlacedFloorMeshes();
-	
-	int32 FloorLargeTilesPlaced = 0;
-	int32 FloorMediumTilesPlaced = 0;
-	int32 FloorSmallTilesPlaced = 0;
-	int32 FloorFillerTilesPlaced = 0;
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateFloor - Starting floor generation"));
-
- 
-	// PHASE 0:  FORCED EMPTY REGIONS (Mark cells as reserved)
- 	TArray<FIntPoint> ForcedEmptyCells = ExpandForcedEmptyRegions();
-	if (ForcedEmptyCells.Num() > 0)
-	{
-		MarkForcedEmptyCells(ForcedEmptyCells);
-		UE_LOG(LogTemp, Log, TEXT("  Phase 0: Marked %d forced empty cells"), ForcedEmptyCells. Num());
-	}
-	
-	// PHASE 1: FORCED PLACEMENTS (Designer overrides - highest priority)
- 	int32 ForcedCount = ExecuteForcedPlacements();
-	UE_LOG(LogTemp, Log, TEXT("  Phase 1: Placed %d forced meshes"), ForcedCount);
-	
-	// PHASE 2: GREEDY FILL (Large → Medium → Small)
- 	// Use the FloorData pointer we loaded at the top (safer than re-accessing)
-	const TArray<FMeshPlacementInfo>& FloorMeshes = FloorStyleData->FloorTilePool;
-	UE_LOG(LogTemp, Log, TEXT("  Phase 2: Greedy fill with %d tile options"), FloorMeshes.Num());
-
-	// Large tiles (400x400, 200x400, 400x200)
-	FillWithTileSize(FloorMeshes, FIntPoint(4, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 4), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(4, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-
-	// Medium tiles (200x200)
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-
-	// Small tiles (100x200, 200x100, 100x100)
-	FillWithTileSize(FloorMeshes, FIntPoint(1, 2), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(2, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	FillWithTileSize(FloorMeshes, FIntPoint(1, 1), FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	
-	// PHASE 3: GAP FILL (Fill remaining empty cells with any available mesh)
-	int32 GapFillCount = FillRemainingGaps(FloorMeshes, FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	UE_LOG(LogTemp, Log, TEXT("  Phase 3:  Filled %d remaining gaps"), GapFillCount);
- 
-	// FINAL STATISTICS
-	int32 RemainingEmpty = GetCellCountByType(EGridCellType::ECT_Empty);
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateFloor - Floor generation complete"));
-	UE_LOG(LogTemp, Log, TEXT("  Total meshes placed: %d"), PlacedFloorMeshes.Num());
-	UE_LOG(LogTemp, Log, TEXT("  Large:  %d, Medium: %d, Small: %d, Filler: %d"), 
-		FloorLargeTilesPlaced, FloorMediumTilesPlaced, FloorSmallTilesPlaced, FloorFillerTilesPlaced);
-	UE_LOG(LogTemp, Log, TEXT("  Remaining empty cells: %d"), RemainingEmpty);
-
-	return true;
+	if (!RefreshSnapshot()) return false;
+	return Core->GenerateFloor();
 }
 
-void URoomGenerator::ClearPlacedFloorMeshes()
-{
-	PlacedFloorMeshes. Empty();
-	LargeTilesPlaced = 0;
-	MediumTilesPlaced = 0;
-	SmallTilesPlaced = 0;
-	FillerTilesPlaced = 0;
-}
+const TArray<FPlacedMeshInfo>& URoomGenerator::GetPlacedFloorMeshes() const { return Core->GetPlacedFloorMeshes(); }
+void URoomGenerator::ClearPlacedFloorMeshes() { Core->ClearPlacedFloorMeshes(); }
 
 void URoomGenerator::GetFloorStatistics(int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles) const
 {
-	OutLargeTiles = LargeTilesPlaced;
-	OutMediumTiles = MediumTilesPlaced;
-	OutSmallTiles = SmallTilesPlaced;
-	OutFillerTiles = FillerTilesPlaced;
+	Core->GetFloorStatistics(OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
 }
 
 int32 URoomGenerator::ExecuteForcedPlacements()
 {
-	if (! bIsInitialized || !RoomData) 
-	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::ExecuteForcedPlacements - Not initialized! ")); return 0;}
-
-	int32 SuccessfulPlacements = 0;
-	const TMap<FIntPoint, FMeshPlacementInfo>& ForcedPlacements = RoomData->ForcedFloorPlacements;
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ExecuteForcedPlacements - Processing %d forced placements"), ForcedPlacements. Num());
-	for (const auto& Pair : ForcedPlacements)
-	{
-		const FIntPoint StartCoord = Pair.Key;
-		const FMeshPlacementInfo& MeshInfo = Pair.Value;
-
-		// Validate mesh asset
-		if (MeshInfo.MeshAsset. IsNull())
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) has null mesh asset - skipping"), StartCoord.X, StartCoord.Y);
-			continue;
-		}
-
-		// Calculate original footprint
-		FIntPoint OriginalFootprint = CalculateFootprint(MeshInfo);
-
-		UE_LOG(LogTemp, Verbose, TEXT("  Attempting forced placement at (%d,%d) with footprint %dx%d"), 
-		StartCoord.X, StartCoord.Y, OriginalFootprint.X, OriginalFootprint.Y);
-
-		// Try to find a rotation that fits the available space
-		int32 BestRotation = -1;
-		FIntPoint BestFootprint;
-
-		if (MeshInfo.AllowedRotations.Num() > 0)
-		{
-			// Try each allowed rotation to find one that fits
-			for (int32 Rotation :  MeshInfo.AllowedRotations)
-			{
-				FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-
-				// Check if this rotation fits within grid bounds
-				if (StartCoord.X + RotatedFootprint.X <= GridSize. X && StartCoord.Y + RotatedFootprint.Y <= GridSize.Y)
-				{
-					// Check if area is available
-					if (IsAreaAvailable(StartCoord, RotatedFootprint))
-					{
-						BestRotation = Rotation;
-						BestFootprint = RotatedFootprint;
-						UE_LOG(LogTemp, Verbose, TEXT("    Found valid rotation %d° (footprint %dx%d)"), 
-							Rotation, RotatedFootprint.X, RotatedFootprint.Y);
-						break; // Use first valid rotation
-					}
-				}
-			}
-		}
-		else
-		{
-			// No allowed rotations defined, try default (0°)
-			BestRotation = 0;
-			BestFootprint = OriginalFootprint;
-		}
-
-		// Check if we found a valid rotation
-		if (BestRotation == -1)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) cannot fit with any allowed rotation - skipping"), 
-				StartCoord.X, StartCoord.Y);
-			continue;
-		}
-
-		// Validate bounds with best rotation
-		if (StartCoord.X + BestFootprint.X > GridSize.X || 
-		    StartCoord.Y + BestFootprint. Y > GridSize.Y)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) is out of bounds (size %dx%d) - skipping"), 
-				StartCoord.X, StartCoord.Y, BestFootprint. X, BestFootprint.Y);
-			continue;
-		}
-
-		// Final check if area is available
-		if (! IsAreaAvailable(StartCoord, BestFootprint))
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Forced placement at (%d,%d) overlaps existing placement - skipping"), 
-				StartCoord.X, StartCoord.Y);
-			continue;
-		}
-
-		// Place the mesh with best rotation
-		if (TryPlaceMesh(StartCoord, BestFootprint, MeshInfo, BestRotation))
-		{
-			SuccessfulPlacements++;
-			UE_LOG(LogTemp, Log, TEXT("  ✓ Placed forced mesh at (%d,%d) size %dx%d rotation %d°"), 
-				StartCoord.X, StartCoord.Y, BestFootprint. X, BestFootprint.Y, BestRotation);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("  Failed to place forced mesh at (%d,%d) - TryPlaceMesh returned false"), 
-				StartCoord.X, StartCoord.Y);
-		}
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ExecuteForcedPlacements - Placed %d/%d forced meshes"), 
-		SuccessfulPlacements, ForcedPlacements.Num());
-
-	return SuccessfulPlacements;
-}
-
-int32 URoomGenerator::FillRemainingGaps(const TArray<FMeshPlacementInfo>& TilePool,
-	int32& OutLargeTiles,
-	int32& OutMediumTiles,
-	int32& OutSmallTiles,
-	int32& OutFillerTiles)
-{
-if (TilePool.Num() == 0)
-	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator:: FillRemainingGaps - No meshes in tile pool! ")); return 0;}
-
-	int32 PlacedCount = 0;
-
-	// Define sizes to try (largest to smallest for efficiency)
-	TArray<FIntPoint> SizesToTry = {
-		FIntPoint(1, 4), // 100x400
-		FIntPoint(4, 1), // 400x100
-		FIntPoint(1, 2), // 100x200
-		FIntPoint(2, 1), // 200x100
-		FIntPoint(1, 1)  // 100x100
-	};
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::FillRemainingGaps - Starting gap fill"));
-
-	// Try each size in order
-	for (const FIntPoint& TargetSize : SizesToTry)
-	{
-		// Filter tiles that match this size
-		TArray<FMeshPlacementInfo> MatchingTiles;
-
-		for (const FMeshPlacementInfo& MeshInfo : TilePool)
-		{
-			FIntPoint Footprint = CalculateFootprint(MeshInfo);
-
-			// Check if footprint matches target size (or rotated version)
-			if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize.Y) || (Footprint.X == TargetSize.Y && Footprint. Y == TargetSize.X))
-			{
-				MatchingTiles.Add(MeshInfo);
-			}
-		}
-
-		if (MatchingTiles.Num() == 0) continue; // No tiles of this size, try next
-
-		int32 SizePlacedCount = 0;
-
-		// Try to place tiles of this size in all empty spaces
-		for (int32 Y = 0; Y < GridSize.Y; ++Y)
-		{
-			for (int32 X = 0; X < GridSize.X; ++X)
-			{
-				FIntPoint StartCoord(X, Y);
-
-				// Check if area is available
-				if (IsAreaAvailable(StartCoord, TargetSize))
-				{
-					// Select weighted random mesh
-					FMeshPlacementInfo SelectedMesh = SelectWeightedMesh(MatchingTiles);
-					FIntPoint OriginalFootprint = CalculateFootprint(SelectedMesh);
-
-					// Find rotation that matches target size
-					int32 BestRotation = 0;
-					
-					if (SelectedMesh.AllowedRotations.Num() > 0)
-					{
-						// Build list of rotations that would fit the target size
-						TArray<int32> ValidRotations;
-
-						for (int32 Rotation : SelectedMesh.AllowedRotations)
-						{
-							FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-							
-							if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-							{
-								ValidRotations.Add(Rotation);
-							}
-						}
-
-						// Select random rotation from valid options
-						if (ValidRotations.Num() > 0)
-						{
-							int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-							BestRotation = ValidRotations[RandomIndex];
-						}
-					}
-
-					// Try to place mesh with rotation
-					if (TryPlaceMesh(StartCoord, TargetSize, SelectedMesh, BestRotation))
-					{
-						SizePlacedCount++;
-						PlacedCount++;
-
-						// Update statistics
-						int32 TileArea = TargetSize.X * TargetSize.Y;
-						if (TileArea >= 16) OutLargeTiles++;
-						else if (TileArea >= 4) OutMediumTiles++;
-						else if (TileArea >= 2) OutSmallTiles++;
-						else OutFillerTiles++;
-					}
-				}
-			}
-		}
-
-		if (SizePlacedCount > 0)
-		{
-			UE_LOG(LogTemp, Verbose, TEXT("  Filled %d gaps with %dx%d tiles"), SizePlacedCount, TargetSize. X, TargetSize.Y);
-		}
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::FillRemainingGaps - Placed %d gap-fill meshes"), PlacedCount);
-
-	return PlacedCount;
+	if (!RefreshSnapshot()) return 0;
+	return Core->ExecuteForcedPlacements();
 }
 
-TArray<FIntPoint> URoomGenerator::ExpandForcedEmptyRegions() const
+int32 URoomGenerator::FillRemainingGaps(int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles)
 {
-	TArray<FIntPoint> ExpandedCells;
-
-	if (! RoomData) return ExpandedCells;
-
-	// 1. Expand all rectangular regions into individual cells
-	for (const FForcedEmptyRegion& Region : RoomData->ForcedEmptyRegions)
-	{
-		// Calculate bounding box (handles any corner order)
-		int32 MinX = FMath::Min(Region.StartCell.X, Region.EndCell. X);
-		int32 MaxX = FMath::Max(Region.StartCell.X, Region.EndCell.X);
-		int32 MinY = FMath::Min(Region.StartCell.Y, Region.EndCell. Y);
-		int32 MaxY = FMath::Max(Region.StartCell.Y, Region.EndCell.Y);
-
-		// Clamp to valid grid bounds
-		MinX = FMath:: Clamp(MinX, 0, GridSize.X - 1);
-		MaxX = FMath::Clamp(MaxX, 0, GridSize.X - 1);
-		MinY = FMath::Clamp(MinY, 0, GridSize.Y - 1);
-		MaxY = FMath:: Clamp(MaxY, 0, GridSize.Y - 1);
-
-		// Add all cells within the rectangular region
-		for (int32 Y = MinY; Y <= MaxY; ++Y)
-		{
-			for (int32 X = MinX; X <= MaxX; ++X)
-			{
-				FIntPoint Cell(X, Y);
-				ExpandedCells.AddUnique(Cell); // AddUnique prevents duplicates
-			}
-		}
-	}
-
-	// 2. Add individual forced empty cells
-	for (const FIntPoint& Cell : RoomData->ForcedEmptyFloorCells)
-	{
-		// Validate cell is within grid bounds
-		if (Cell.X >= 0 && Cell.X < GridSize.X && Cell.Y >= 0 && Cell.Y < GridSize.Y) {	ExpandedCells.AddUnique(Cell); }
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator:: ExpandForcedEmptyRegions - Expanded to %d cells"), ExpandedCells.Num());
-
-	return ExpandedCells;
+	if (!RefreshSnapshot()) return 0;
+	return Core->FillRemainingGaps(OutLargeTiles, OutMediumTiles, OutSmallTiles, OutFillerTiles);
 }
 
-void URoomGenerator::MarkForcedEmptyCells(const TArray<FIntPoint>& EmptyCells)
-{
-	for (const FIntPoint& Cell :  EmptyCells)
-	{
-		// Mark as Wall type (reserved/boundary marker)
-		SetCellState(Cell, EGridCellType::ECT_Wall);
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::MarkForcedEmptyCells - Marked %d cells as empty"), EmptyCells.Num());
-}
+TArray<FIntPoint> URoomGenerator::ExpandForcedEmptyRegions() const { return Core->ExpandForcedEmptyRegions(); }
+void URoomGenerator::MarkForcedEmptyCells(const TArray<FIntPoint>& EmptyCells) { Core->MarkForcedEmptyCells(EmptyCells); }
 #pragma endregion
 
 #pragma region Wall Generation
 bool URoomGenerator::GenerateWalls()
 {
-	if (!bIsInitialized)
-	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateWalls - Generator not initialized! ")); return false; }
-
-	if (!RoomData || RoomData->WallStyleData.IsNull())
-	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateWalls - WallStyleData not assigned!")); return false; }
-
-	UWallData* WallData = RoomData->WallStyleData.LoadSynchronous();
-	if (!WallData || WallData->AvailableWallModules.Num() == 0)
-	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateWalls - No wall modules defined!"));	return false; }
-	
-	// Clear previous data
-	ClearPlacedWalls();
-	PlacedBaseWallSegments.Empty();  // ✅ Clear tracking array
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateWalls - Starting wall generation"));
-
-	// PHASE 0:   GENERATE DOORWAYS FIRST (Before any walls are placed!)
-	UE_LOG(LogTemp, Log, TEXT("  Phase 0: Generating doorways"));
-	if (! GenerateDoorways())
-	{ UE_LOG(LogTemp, Warning, TEXT("  Doorway generation failed, continuing with walls")); }
-	else
-	{ UE_LOG(LogTemp, Log, TEXT("  Doorways generated:   %d"), PlacedDoorwayMeshes. Num()); }
-	
-	// PHASE 1: FORCED WALL PLACEMENTS
-	int32 ForcedCount = ExecuteForcedWallPlacements();
-	if (ForcedCount > 0) UE_LOG(LogTemp, Log, TEXT("  Phase 0: Placed %d forced walls"), ForcedCount);
-	
-	// PHASE 2: Generate base walls for each edge
-	FillWallEdge(EWallEdge::North);
-	FillWallEdge(EWallEdge::South);
-	FillWallEdge(EWallEdge::East);
-	FillWallEdge(EWallEdge::West);
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateWalls - Base walls tracked:  %d segments"), 
-		PlacedBaseWallSegments.Num());
-
-	// PASS 3: Spawn middle layers using socket-based stacking
-	SpawnMiddleWallLayers();
-
-	// PASS 4: Spawn top layer using socket-based stacking
-	SpawnTopWallLayer();
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateWalls - Complete.  Total wall records: %d"), 
-		PlacedWallMeshes.Num());
-
-	return true;
-}
-
-int32 URoomGenerator::ExecuteForcedWallPlacements()
-{
-	if (!bIsInitialized || !RoomData)
-	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::ExecuteForcedWallPlacements - Not initialized!")); return 0;	}
-
-	// Check if there are any forced placements
-	if (RoomData->ForcedWallPlacements.Num() == 0)
-	{ UE_LOG(LogTemp, Verbose, TEXT("URoomGenerator:: ExecuteForcedWallPlacements - No forced walls to place")); return 0;}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ExecuteForcedWallPlacements - Processing %d forced walls"), 
-		RoomData->ForcedWallPlacements.Num());
-
-	int32 SuccessfulPlacements = 0;
-	int32 FailedPlacements = 0;
-
-	// Get wall offsets once (used for all walls)
-	float NorthOffset = 0.0f;
-	float SouthOffset = 0.0f;
-	float EastOffset = 0.0f;
-	float WestOffset = 0.0f;
-
-	if (RoomData->WallStyleData.IsValid())
-	{
-		UWallData* WallData = RoomData->WallStyleData.LoadSynchronous();
-		if (WallData)
-		{
-			NorthOffset = WallData->NorthWallOffsetX;
-			SouthOffset = WallData->SouthWallOffsetX;
-			EastOffset = WallData->EastWallOffsetY;
-			WestOffset = WallData->WestWallOffsetY;
-		}
-	}
-
-	for (int32 i = 0; i < RoomData->ForcedWallPlacements.Num(); ++i)
-	{
-		const FForcedWallPlacement& ForcedWall = RoomData->ForcedWallPlacements[i];
-		const FWallModule& Module = ForcedWall.WallModule;
-
-		UE_LOG(LogTemp, Verbose, TEXT("  Forced Wall [%d]: Edge=%s, StartCell=%d, Footprint=%d"), i, 
-		*UEnum::GetValueAsString(ForcedWall.Edge), ForcedWall.StartCell, Module.Y_AxisFootprint);
-	 
-		// VALIDATION:  Load Base Mesh
-		UStaticMesh* BaseMesh = UDungeonGenerationHelpers::LoadAndValidateMesh( Module.BaseMesh,
-			FString:: Printf(TEXT("ForcedWall[%d]"), i), true);
-
-		if (!BaseMesh)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED: BaseMesh failed to load"));
-			FailedPlacements++;
-			continue;
-		}
-
-	 
-		// VALIDATION: Check Edge Cells
-		TArray<FIntPoint> EdgeCells = UDungeonGenerationHelpers::GetEdgeCellIndices(ForcedWall.Edge, GridSize);
-
-		if (EdgeCells.Num() == 0)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED: No cells on edge %s"), *UEnum::GetValueAsString(ForcedWall.Edge));
-			FailedPlacements++;
-			continue;
-		}
-	 
-		// VALIDATION: Check Bounds
-	 	int32 Footprint = Module.Y_AxisFootprint;
-		if (ForcedWall.StartCell < 0 || ForcedWall.StartCell + Footprint > EdgeCells.Num())
-		{
-			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED: Out of bounds (StartCell=%d, Footprint=%d, EdgeLength=%d)"),
-				ForcedWall.StartCell, Footprint, EdgeCells. Num());
-			FailedPlacements++;
-			continue;
-		}
-
-		// NOTE: Overlap checking with other forced walls would happen here
-		// For now, we assume designers don't create overlapping forced placements
-	 
-		// PLACEMENT: Calculate Position & Rotation Using Helpers
-		FVector WallPosition = UDungeonGenerationHelpers:: CalculateWallPosition(
-		ForcedWall.Edge, ForcedWall.StartCell, Footprint, GridSize, CellSize,
-		NorthOffset, SouthOffset, EastOffset, WestOffset);
-
-		FRotator WallRotation = UDungeonGenerationHelpers::GetWallRotationForEdge(ForcedWall.Edge);
-	 
-		// PLACEMENT: Create Base Wall Transform
-		FTransform BaseTransform(WallRotation, WallPosition, FVector:: OneVector);
-	 
-		// TRACKING: Store Segment for Middle/Top Spawning
-		FGeneratorWallSegment Segment;
-		Segment.Edge = ForcedWall.Edge;
-		Segment.StartCell = ForcedWall.StartCell;
-		Segment. SegmentLength = Footprint;
-		Segment.BaseTransform = BaseTransform;
-		Segment.BaseMesh = BaseMesh;
-		Segment.WallModule = &Module;  // Store pointer to module data
-
-		PlacedBaseWallSegments.Add(Segment);
-
-		UE_LOG(LogTemp, Verbose, TEXT("    ✓ Forced wall tracked: Edge=%s, StartCell=%d, Footprint=%d"),
-		*UEnum::GetValueAsString(ForcedWall.Edge), ForcedWall.StartCell, Footprint);
-		SuccessfulPlacements++;
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ExecuteForcedWallPlacements - Placed %d/%d forced walls (%d failed)"),
-	SuccessfulPlacements, RoomData->ForcedWallPlacements. Num(), FailedPlacements);
-	return SuccessfulPlacements;
-}
-
-bool URoomGenerator::IsCellRangeOccupied(EWallEdge Edge, int32 StartCell, int32 Length) const
-{
-	// Check if any forced wall overlaps with this range
-	for (const FGeneratorWallSegment& Segment : PlacedBaseWallSegments)
-	{
-		if (Segment.Edge != Edge) continue;
-
-		// Check for overlap:  [Start1, End1) overlaps [Start2, End2) if Start1 < End2 AND Start2 < End1
-		int32 SegmentEnd = Segment.StartCell + Segment.SegmentLength;
-		int32 RangeEnd = StartCell + Length;
-
-		if (StartCell < SegmentEnd && Segment.StartCell < RangeEnd) return true;  // Overlap detected
-	}
-	return false;
+	if (!RefreshSnapshot()) return false;
+	return Core->GenerateWalls();
 }
 
-void URoomGenerator::ClearPlacedWalls()
-{
-	PlacedWallMeshes.Empty();
-}
+const TArray<FPlacedWallInfo>& URoomGenerator::GetPlacedWalls() const { return Core->GetPlacedWalls(); }
 
-void URoomGenerator::SpawnMiddleWallLayers()
+int32 URoomGenerator::ExecuteForcedWallPlacements()
 {
-	if (!RoomData || RoomData->WallStyleData.IsNull()) return;
-
-	// Get fallback height from WallData
-	float FallbackHeight = 100.0f;
-	UWallData* WallData = RoomData->WallStyleData.LoadSynchronous();
-	if (WallData) { FallbackHeight = WallData->WallHeight;}
-
-	int32 Middle1Spawned = 0;
-	int32 Middle2Spawned = 0;
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::SpawnMiddleWallLayers - Processing %d base segments"), PlacedBaseWallSegments.Num());
-
-	for (const FGeneratorWallSegment& Segment : PlacedBaseWallSegments)
-	{
-		if (!Segment.WallModule) continue;
-
-		// MIDDLE 1 LAYER
-		UStaticMesh* Middle1Mesh = Segment.WallModule->MiddleMesh1.LoadSynchronous();
-
-		if (Middle1Mesh)
-		{
-			// ✅ Single line replaces 15+ lines of socket querying
-			FTransform Middle1WorldTransform = UDungeonGenerationHelpers::CalculateSocketWorldTransform(
-				Segment.BaseMesh,
-				FName("TopBackCenter"),
-				Segment.BaseTransform,
-				FVector(0, 0, FallbackHeight));
-
-			// Store wall info
-			FPlacedWallInfo PlacedWall;
-			PlacedWall.Edge = Segment.Edge;
-			PlacedWall.StartCell = Segment.StartCell;
-			PlacedWall.SpanLength = Segment.SegmentLength;
-			PlacedWall.WallModule = *Segment.WallModule;
-			PlacedWall.BottomTransform = Segment.BaseTransform;
-			PlacedWall.Middle1Transform = Middle1WorldTransform;
-
-			PlacedWallMeshes.Add(PlacedWall);
-			Middle1Spawned++;
-
-			// MIDDLE 2 LAYER
-			UStaticMesh* Middle2Mesh = Segment.WallModule->MiddleMesh2.LoadSynchronous();
-
-			if (Middle2Mesh)
-			{
-				// ✅ Single line replaces 10+ lines of socket querying
-				FTransform Middle2WorldTransform = UDungeonGenerationHelpers::CalculateSocketWorldTransform(
-				Middle1Mesh, FName("TopBackCenter"), Middle1WorldTransform, FVector(0, 0, FallbackHeight));
-				PlacedWallMeshes.Last().Middle2Transform = Middle2WorldTransform;
-				Middle2Spawned++;
-			}
-		}
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::SpawnMiddleWallLayers - Middle1: %d, Middle2: %d"), Middle1Spawned, Middle2Spawned);
+	if (!RefreshSnapshot()) return 0;
+	return Core->ExecuteForcedWallPlacements();
 }
 
-void URoomGenerator::SpawnTopWallLayer()
-{
-	if (! RoomData || RoomData->WallStyleData.IsNull()) return;
-
-	// Get fallback height from WallData
-	float FallbackHeight = 100.0f;  // Default fallback
-	UWallData* WallData = RoomData->WallStyleData.LoadSynchronous();
-	if (WallData) {	FallbackHeight = WallData->WallHeight;}
-
-	int32 TopSpawned = 0;
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator:: SpawnTopWallLayer - Processing %d wall segments"), PlacedWallMeshes.Num());
-
-	for (FPlacedWallInfo& Wall :  PlacedWallMeshes)
-	{
-		// Load top mesh (required)
-		UStaticMesh* TopMesh = Wall.WallModule. TopMesh.LoadSynchronous();
-		if (!TopMesh)continue;
-	 
-		// DETERMINE WHICH LAYER TO STACK ON (Priority:  Middle2 > Middle1 > Base)
-		// Load middle meshes to determine stack point
-		UStaticMesh* Middle2Mesh = Wall.WallModule.MiddleMesh2.LoadSynchronous();
-		UStaticMesh* Middle1Mesh = Wall.WallModule. MiddleMesh1.LoadSynchronous();
-
-		UStaticMesh* SnapToMesh = nullptr;
-		FTransform StackBaseTransform;
-
-		// Priority 1: Stack on Middle2 (if it exists)
-		if (Middle2Mesh)
-		{
-			SnapToMesh = Middle2Mesh;
-			StackBaseTransform = Wall.Middle2Transform;
-		}
-		// Priority 2: Stack on Middle1 (if Middle2 doesn't exist)
-		else if (Middle1Mesh)
-		{
-			SnapToMesh = Middle1Mesh;
-			StackBaseTransform = Wall.Middle1Transform;
-		}
-		// Priority 3: Stack directly on Base
-		else
-		{
-			SnapToMesh = Wall.WallModule.BaseMesh. LoadSynchronous();
-			StackBaseTransform = Wall. BottomTransform;
-		}
-	 
-		// CALCULATE TOP TRANSFORM USING SOCKET HELPER
-		FTransform TopWorldTransform = UDungeonGenerationHelpers::CalculateSocketWorldTransform(
-		SnapToMesh, FName("TopBackCenter"), StackBaseTransform, FVector(0, 0, FallbackHeight));
-		// Store transform
-		Wall.TopTransform = TopWorldTransform;
-		TopSpawned++;
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::SpawnTopWallLayer - Top meshes: %d"), TopSpawned);
-}
+bool URoomGenerator::IsCellRangeOccupied(EWallEdge Edge, int32 StartCell, int32 Length) const { return Core->IsCellRangeOccupied(Edge, StartCell, Length); }
+void URoomGenerator::ClearPlacedWalls() { Core->ClearPlacedWalls(); }
+void URoomGenerator::SpawnMiddleWallLayers() { Core->SpawnMiddleWallLayers(); }
+void URoomGenerator::SpawnTopWallLayer() { Core->SpawnTopWallLayer(); }
 #pragma endregion
 
 #pragma region Corner Generation
 bool URoomGenerator::GenerateCorners()
 {
-	 if (!bIsInitialized)
-    {
-        UE_LOG(LogTemp, Error, TEXT("URoomGenerator:: GenerateCorners - Generator not initialized! "));
-        return false;
-    }
-
-    if (! RoomData || RoomData->WallStyleData. IsNull())
-    {
-        UE_LOG(LogTemp, Error, TEXT("URoomGenerator:: GenerateCorners - WallStyleData not assigned!"));
-        return false;
-    }
-
-    UWallData* WallData = RoomData->WallStyleData.LoadSynchronous();
-    if (!WallData)
-    {
-        UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateCorners - Failed to load WallStyleData!"));
-        return false;
-    }
-
-    // Clear previous corners
-    ClearPlacedCorners();
-
-    UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateCorners - Starting corner generation"));
-
-    // Load corner mesh (required)
-    if (WallData->DefaultCornerMesh.IsNull())
-    {
-        UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::GenerateCorners - No default corner mesh defined, skipping corners"));
-        return true; // Not an error, just no corners to place
-    }
-
-    UStaticMesh* CornerMesh = WallData->DefaultCornerMesh.LoadSynchronous();
-    if (!CornerMesh)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::GenerateCorners - Failed to load corner mesh"));
-        return false;
-    }
-
-    // ========================================================================
-    // Define corner data (matching MasterRoom's clockwise order:  SW, SE, NE, NW)
-    // ========================================================================
-    
-    struct FCornerData
-    {
-        ECornerPosition Position;
-        FVector BasePosition;  // Grid corner position (before offset)
-        FRotator Rotation;     // From WallData
-        FVector Offset;        // Per-corner offset from WallData
-        FString Name;          // For logging
-    };
-
-    TArray<FCornerData> Corners = {
-        { 
-            ECornerPosition::SouthWest, 
-            FVector(0.0f, 0.0f, 0.0f),  // Bottom-left
-            WallData->SouthWestCornerRotation, 
-            WallData->SouthWestCornerOffset,
-            TEXT("SouthWest")
-        },
-        { 
-            ECornerPosition::SouthEast, 
-            FVector(0.0f, GridSize.Y * CellSize, 0.0f),  // Bottom-right
-            WallData->SouthEastCornerRotation, 
-            WallData->SouthEastCornerOffset,
-            TEXT("SouthEast")
-        },
-        { 
-            ECornerPosition::NorthEast, 
-            FVector(GridSize.X * CellSize, GridSize.Y * CellSize, 0.0f),  // Top-right
-            WallData->NorthEastCornerRotation, 
-            WallData->NorthEastCornerOffset,
-            TEXT("NorthEast")
-        },
-        { 
-            ECornerPosition:: NorthWest, 
-            FVector(GridSize.X * CellSize, 0.0f, 0.0f),  // Top-left
-            WallData->NorthWestCornerRotation, 
-            WallData->NorthWestCornerOffset,
-            TEXT("NorthWest")
-        }
-    };
-
-    // ========================================================================
-    // Generate each corner
-    // ========================================================================
-    
-    for (const FCornerData& CornerData : Corners)
-    {
-        // Apply designer offset to base position
-        FVector FinalPosition = CornerData. BasePosition + CornerData. Offset;
-
-        // Create transform (local/component space)
-        FTransform CornerTransform(CornerData.Rotation, FinalPosition, FVector:: OneVector);
-
-        // Create placed corner info
-        FPlacedCornerInfo PlacedCorner;
-        PlacedCorner.Corner = CornerData. Position;
-        PlacedCorner.CornerMesh = WallData->DefaultCornerMesh;
-        PlacedCorner.Transform = CornerTransform;
-
-        PlacedCornerMeshes.Add(PlacedCorner);
-
-        UE_LOG(LogTemp, Verbose, TEXT("  Placed %s corner at position %s with rotation (%.0f, %.0f, %.0f)"),
-            *CornerData.Name,
-            *FinalPosition.ToString(),
-            CornerData. Rotation.Roll,
-            CornerData.Rotation. Pitch,
-            CornerData.Rotation.Yaw);
-    }
-
-    UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateCorners - Complete.  Placed %d corners"), PlacedCornerMeshes.Num());
-
-    return true;
+	if (!RefreshSnapshot()) return false;
+	return Core->GenerateCorners();
 }
 
-void URoomGenerator::ClearPlacedCorners()
-{
-	PlacedCornerMeshes.Empty();
-}
+const TArray<FPlacedCornerInfo>& URoomGenerator::GetPlacedCorners() const { return Core->GetPlacedCorners(); }
+void URoomGenerator::ClearPlacedCorners() { Core->ClearPlacedCorners(); }
 #pragma endregion
 
 #pragma region Doorway Generation
-
 bool URoomGenerator::GenerateDoorways()
 {
-    if (!  bIsInitialized)
-    {
-        UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateDoorways - Generator not initialized!  "));
-        return false;
-    }
-
-    if (!  RoomData)
-    {
-        UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateDoorways - RoomData is null! "));
-        return false;
-    }
-
-    // ========================================================================
-    // CHECK FOR CACHED LAYOUT
-    // ========================================================================
-    
-    if (CachedDoorwayLayouts.Num() > 0)
-    {
-        UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateDoorways - Using cached layout (%d doorways), recalculating transforms"),
-            CachedDoorwayLayouts.Num());
-        
-        // Clear old transforms but keep layout
-        PlacedDoorwayMeshes.  Empty();
-        
-        // Recalculate transforms from cached layouts (with current offsets)
-        for (const FDoorwayLayoutInfo& Layout : CachedDoorwayLayouts)
-        {
-            FPlacedDoorwayInfo PlacedDoor = CalculateDoorwayTransforms(Layout);
-            PlacedDoorwayMeshes.Add(PlacedDoor);
-        }
-        
-        MarkDoorwayCells();
-        
-        UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateDoorways - Transforms recalculated with current offsets"));
-        return true;
-    }
-
-    // ========================================================================
-    // NO CACHE - GENERATE NEW LAYOUT
-    // ========================================================================
-
-    UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateDoorways - Generating new doorway layout"));
-
-    // Clear both layout and transforms
-    PlacedDoorwayMeshes. Empty();
-    CachedDoorwayLayouts.  Empty();
-
-    int32 ManualDoorwaysPlaced = 0;
-    int32 AutomaticDoorwaysPlaced = 0;
-
-    // ========================================================================
-    // PHASE 1: Process Manual Doorway Placements
-    // ========================================================================
-
-    for (const FFixedDoorLocation& ForcedDoor : RoomData->ForcedDoorways)
-    {
-        // Validate door data
-        UDoorData* DoorData = ForcedDoor.DoorData ?  ForcedDoor.DoorData : RoomData->DefaultDoorData;
-        
-        if (!DoorData)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("  Forced doorway has no DoorData, skipping"));
-            continue;
-        }
-        
-    	int32 DoorWidth = DoorData->GetTotalDoorwayWidth();
-    	UE_LOG(LogTemp, Log, TEXT("  Manual doorway:  Edge=%s, FrameFootprint=%d, SideFills=%s, TotalWidth=%d"),
-    	*UEnum::GetValueAsString(ForcedDoor.WallEdge), DoorData->FrameFootprintY, *UEnum:: GetValueAsString(DoorData->SideFillType), DoorWidth);
-        // Validate bounds
-        TArray<FIntPoint> EdgeCells = UDungeonGenerationHelpers::GetEdgeCellIndices(ForcedDoor.WallEdge, GridSize);
-        
-        if (ForcedDoor.StartCell < 0 || ForcedDoor.StartCell + DoorWidth > EdgeCells.Num())
-        {
-            UE_LOG(LogTemp, Warning, TEXT("  Forced doorway out of bounds, skipping"));
-            continue;
-        }
-
-        // ✅ Create and cache layout info
-        FDoorwayLayoutInfo LayoutInfo;
-        LayoutInfo.Edge = ForcedDoor.WallEdge;
-        LayoutInfo.StartCell = ForcedDoor.StartCell;
-        LayoutInfo.WidthInCells = DoorWidth;
-        LayoutInfo.DoorData = DoorData;
-        LayoutInfo.bIsStandardDoorway = false;
-        LayoutInfo.ManualOffsets = ForcedDoor.DoorPositionOffsets;  // Store manual offsets
-
-        CachedDoorwayLayouts.Add(LayoutInfo);
-
-        // ✅ Calculate transforms from layout
-        FPlacedDoorwayInfo PlacedDoor = CalculateDoorwayTransforms(LayoutInfo);
-        PlacedDoorwayMeshes.Add(PlacedDoor);
-
-        ManualDoorwaysPlaced++;
-    }
-
-    // ========================================================================
-    // PHASE 2: Generate Automatic Standard Doorway
-    // ========================================================================
-
-    if (RoomData->bGenerateStandardDoorway && RoomData->DefaultDoorData)
-    {
-        // Determine edges to use
-        TArray<EWallEdge> EdgesToUse;
-        
-        if (RoomData->bSetStandardDoorwayEdge)
-        {
-            EdgesToUse. Add(RoomData->StandardDoorwayEdge);
-            UE_LOG(LogTemp, Log, TEXT("  Using manual edge:   %s"), 
-                *UEnum::GetValueAsString(RoomData->StandardDoorwayEdge));
-        }
-        else if (RoomData->bMultipleDoorways)
-        {
-            int32 NumDoorways = FMath:: Clamp(RoomData->NumAutomaticDoorways, 2, 4);
-            
-            TArray<EWallEdge> AllEdges = {
-                EWallEdge:: North, EWallEdge::  South, 
-                EWallEdge:: East, EWallEdge:: West
-            };
-            
-            FRandomStream Stream(FMath:: Rand());
-            for (int32 i = AllEdges.Num() - 1; i > 0; --i)
-            {
-                int32 j = Stream.RandRange(0, i);
-                AllEdges. Swap(i, j);
-            }
-            
-            for (int32 i = 0; i < NumDoorways && i < AllEdges.Num(); ++i)
-            {
-                EdgesToUse.Add(AllEdges[i]);
-            }
-            
-            UE_LOG(LogTemp, Log, TEXT("  Generating %d automatic doorways"), NumDoorways);
-        }
-        else
-        {
-            FRandomStream Stream(FMath::  Rand());
-            TArray<EWallEdge> AllEdges = {
-                EWallEdge::North, EWallEdge::South, 
-                EWallEdge:: East, EWallEdge:: West
-            };
-            EWallEdge ChosenEdge = AllEdges[Stream.RandRange(0, AllEdges.Num() - 1)];
-            EdgesToUse.Add(ChosenEdge);
-            
-            UE_LOG(LogTemp, Log, TEXT("  Using random edge:  %s"), 
-                *UEnum::GetValueAsString(ChosenEdge));
-        }
-        
-        // Generate doorway on each chosen edge
-        for (EWallEdge ChosenEdge : EdgesToUse)
-        {
-            TArray<FIntPoint> EdgeCells = UDungeonGenerationHelpers::GetEdgeCellIndices(ChosenEdge, GridSize);
-            int32 EdgeLength = EdgeCells.Num();
-
-            int32 StartCell = (EdgeLength - RoomData->StandardDoorwayWidth) / 2;
-            StartCell = FMath:: Clamp(StartCell, 0, EdgeLength - RoomData->StandardDoorwayWidth);
-
-            // Check for overlap with existing doorways
-            bool bOverlaps = false;
-            for (const FDoorwayLayoutInfo& ExistingLayout : CachedDoorwayLayouts)
-            {
-                if (ExistingLayout.Edge == ChosenEdge)
-                {
-                    int32 ExistingStart = ExistingLayout.StartCell;
-                    int32 ExistingEnd = ExistingStart + ExistingLayout.WidthInCells;
-                    int32 NewStart = StartCell;
-                    int32 NewEnd = StartCell + RoomData->StandardDoorwayWidth;
-
-                    if (NewStart < ExistingEnd && ExistingStart < NewEnd)
-                    {
-                        bOverlaps = true;
-                        UE_LOG(LogTemp, Warning, TEXT("  Doorway on %s would overlap, skipping"),
-                            *UEnum::  GetValueAsString(ChosenEdge));
-                        break;
-                    }
-                }
-            }
-
-            if (!bOverlaps)
-            {
-                // ✅ Create and cache layout info
-                FDoorwayLayoutInfo LayoutInfo;
-                LayoutInfo.Edge = ChosenEdge;
-                LayoutInfo.StartCell = StartCell;
-                LayoutInfo. WidthInCells = RoomData->StandardDoorwayWidth;
-                LayoutInfo.DoorData = RoomData->DefaultDoorData;
-                LayoutInfo.bIsStandardDoorway = true;
-                // No manual offsets for automatic doorways
-
-                CachedDoorwayLayouts.Add(LayoutInfo);
-
-                // ✅ Calculate transforms from layout
-                FPlacedDoorwayInfo PlacedDoor = CalculateDoorwayTransforms(LayoutInfo);
-                PlacedDoorwayMeshes. Add(PlacedDoor);
-
-                AutomaticDoorwaysPlaced++;
-            }
-        }
-    }
-
-    // ========================================================================
-    // PHASE 3: Mark Doorway Cells
-    // ========================================================================
-
-    MarkDoorwayCells();
-
-    UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateDoorways - Complete.   Cached %d layouts, placed %d doorways"),
-        CachedDoorwayLayouts.Num(), PlacedDoorwayMeshes.Num());
-
-    return true;
+	if (!RefreshSnapshot()) return false;
+	return Core->GenerateDoorways();
 }
 
-FPlacedDoorwayInfo URoomGenerator::CalculateDoorwayTransforms(const FDoorwayLayoutInfo& Layout)
-{
-    FPlacedDoorwayInfo PlacedDoor;
-    PlacedDoor.Edge = Layout.Edge;
-    PlacedDoor.StartCell = Layout.StartCell;
-    PlacedDoor.  WidthInCells = Layout.WidthInCells;
-    PlacedDoor. DoorData = Layout.DoorData;
-    PlacedDoor.bIsStandardDoorway = Layout.bIsStandardDoorway;
-
-    // Calculate base position (no offsets)
-    FVector BasePosition = UDungeonGenerationHelpers::  CalculateDoorwayPosition(
-        Layout.Edge,
-        Layout.StartCell,
-        Layout.WidthInCells,
-        GridSize,
-        CellSize
-    );
-
-    // ✅ Get offsets based on doorway type
-    FDoorPositionOffsets Offsets;
-    
-    if (Layout.bIsStandardDoorway)
-    {
-        // Automatic doorway:   use edge-specific offsets from DoorData
-        Offsets = Layout.DoorData->GetOffsetsForEdge(Layout.  Edge);
-        
-        UE_LOG(LogTemp, VeryVerbose, TEXT("    Using edge-specific offsets for %s:  Frame=%s, Actor=%s"),
-            *UEnum::GetValueAsString(Layout. Edge),
-            *Offsets.  FramePositionOffset. ToString(),
-            *Offsets. ActorPositionOffset.  ToString());
-    }
-    else
-    {
-        // Manual doorway:  use stored manual offsets
-        Offsets = Layout.ManualOffsets;
-        
-        UE_LOG(LogTemp, VeryVerbose, TEXT("    Using manual offsets:  Frame=%s, Actor=%s"),
-            *Offsets. FramePositionOffset.ToString(),
-            *Offsets. ActorPositionOffset. ToString());
-    }
-
-    // Apply offsets to base position
-    FVector FinalFramePosition = BasePosition + Offsets.  FramePositionOffset;
-    FVector FinalActorPosition = BasePosition + Offsets.ActorPositionOffset;
-
-    // Calculate rotation
-    FRotator Rotation = UDungeonGenerationHelpers::GetWallRotationForEdge(Layout.Edge);
-    Rotation += Layout.DoorData->FrameRotationOffset;
-
-    // Store transforms
-    PlacedDoor. FrameTransform = FTransform(Rotation, FinalFramePosition, FVector:: OneVector);
-    PlacedDoor.ActorTransform = FTransform(Rotation, FinalActorPosition, FVector::OneVector);
-
-    return PlacedDoor;
-}
+void URoomGenerator::MarkDoorwayCells() { Core->MarkDoorwayCells(); }
+bool URoomGenerator::IsCellPartOfDoorway(FIntPoint Cell) const { return Core->IsCellPartOfDoorway(Cell); }
+const TArray<FPlacedDoorwayInfo>& URoomGenerator::GetPlacedDoorways() const { return Core->GetPlacedDoorways(); }
+void URoomGenerator::ClearPlacedDoorways() { Core->ClearPlacedDoorways(); }
+#pragma endregion
 
-void URoomGenerator::MarkDoorwayCells()
+#pragma region Ceiling Generation
+bool URoomGenerator::GenerateCeiling()
 {
-    for (const FPlacedDoorwayInfo& Doorway : PlacedDoorwayMeshes)
-    {
-        TArray<FIntPoint> EdgeCells = UDungeonGenerationHelpers::GetEdgeCellIndices(Doorway.Edge, GridSize);
-
-        for (int32 i = 0; i < Doorway.WidthInCells; ++i)
-        {
-            int32 CellIndex = Doorway.StartCell + i;
-            if (CellIndex >= 0 && CellIndex < EdgeCells.Num())
-            {
-                FIntPoint Cell = EdgeCells[CellIndex];
-                
-                // Mark in grid state (if cell is within interior grid)
-                // Note:  Boundary cells (virtual) are outside interior grid bounds
-                // So we only mark if cell is within (0, GridSize-1)
-                if (Cell.X >= 0 && Cell.X < GridSize. X && Cell.Y >= 0 && Cell.Y < GridSize.Y)
-                {
-                    int32 GridIndex = Cell.Y * GridSize.X + Cell.X;
-                    if (GridState. IsValidIndex(GridIndex))
-                    {
-                        GridState[GridIndex] = EGridCellType::ECT_Doorway;
-                    }
-                }
-                
-                UE_LOG(LogTemp, VeryVerbose, TEXT("    Marked doorway cell:  (%d, %d)"), Cell.X, Cell.Y);
-            }
-        }
-    }
+	if (!RefreshSnapshot()) return false;
+	return Core->GenerateCeiling();
 }
 
-bool URoomGenerator::IsCellPartOfDoorway(FIntPoint Cell) const
+int32 URoomGenerator::ExecuteForcedCeilingPlacements(FGridOccupancy& CeilingOccupied)
 {
-	for (const FPlacedDoorwayInfo& Doorway :  PlacedDoorwayMeshes)
-	{
-		TArray<FIntPoint> EdgeCells = UDungeonGenerationHelpers::GetEdgeCellIndices(Doorway. Edge, GridSize);
+	if (!RefreshSnapshot()) return 0;
+	return Core->ExecuteForcedCeilingPlacements(CeilingOccupied);
+}
 
-		for (int32 i = 0; i < Doorway.WidthInCells; ++i)
-		{
-			int32 CellIndex = Doorway.StartCell + i;
-			if (CellIndex >= 0 && CellIndex < EdgeCells.Num())
-			{
-				FIntPoint DoorwayCell = EdgeCells[CellIndex];
-                
-				// ✅ ADD LOGGING: 
-				if (Cell == DoorwayCell)
-				{
-					UE_LOG(LogTemp, Warning, TEXT("    Cell (%d,%d) IS part of doorway on edge %s at index %d"),
-						Cell. X, Cell.Y, *UEnum::GetValueAsString(Doorway.Edge), CellIndex);
-					return true;
-				}
-			}
-		}
-	}
+const TArray<FPlacedCeilingInfo>& URoomGenerator::GetPlacedCeilingTiles() const { return Core->GetPlacedCeilingTiles(); }
+void URoomGenerator::ClearPlacedCeiling() { Core->ClearPlacedCeiling(); }
+#pragma endregion
 
-	return false;
-}
+#pragma region Coordinate Conversion
+FVector URoomGenerator::GridToLocalPosition(FIntPoint GridCoord) const { return Core->GridToLocalPosition(GridCoord); }
+FIntPoint URoomGenerator::LocalToGridPosition(FVector LocalPos) const { return Core->LocalToGridPosition(LocalPos); }
 
-void URoomGenerator::ClearPlacedDoorways()
+FIntPoint URoomGenerator::GetRotatedFootprint(FIntPoint OriginalFootprint, int32 Rotation)
 {
-    PlacedDoorwayMeshes.Empty();
-	CachedDoorwayLayouts. Empty(); 
+	return FRoomGenerationCore::GetRotatedFootprint(OriginalFootprint, Rotation);
 }
 #pragma endregion
 
-#pragma region Ceiling Generation
-bool URoomGenerator::GenerateCeiling()
+#pragma region Room Statistics
+int32 URoomGenerator::GetCellCountByType(EGridCellType CellType) const { return Core->GetCellCountByType(CellType); }
+float URoomGenerator::GetOccupancyPercentage() const { return Core->GetOccupancyPercentage(); }
+#pragma endregion
+
+#pragma region Internal Helpers
+TSharedPtr<const FRoomGenerationSnapshot> URoomGenerator::BuildSnapshot() const
 {
-    if (! bIsInitialized)
-    {
-        UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateCeiling - Generator not initialized!  "));
-        return false;
-    }
-
-    if (! RoomData || RoomData->CeilingStyleData.IsNull())
-    {
-        UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::GenerateCeiling - No CeilingStyleData assigned"));
-        return false;
-    }
-
-    UCeilingData* CeilingData = RoomData->CeilingStyleData.LoadSynchronous();
-    if (!CeilingData)
-    {
-        UE_LOG(LogTemp, Error, TEXT("URoomGenerator::GenerateCeiling - Failed to load CeilingStyleData"));
-        return false;
-    }
-
-    // Clear previous ceiling data
-    ClearPlacedCeiling();
-
-    UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateCeiling - Starting ceiling generation"));
-
-    // Create occupancy grid
-    TArray<bool> CeilingOccupied;
-    CeilingOccupied.Init(false, GridSize.X * GridSize.Y);
-
-    FRandomStream Stream(FMath::  Rand());
-
-    int32 CeilingLargeTilesPlaced = 0;
-    int32 CeilingMediumTilesPlaced = 0;
-    int32 CeilingSmallTilesPlaced = 0;
-
-    // ========================================================================
-    // HELPER LAMBDAS
-    // ========================================================================
-
-    auto IsCellOccupied = [&](int32 X, int32 Y) -> bool
-    {
-        if (X < 0 || X >= GridSize.X || Y < 0 || Y >= GridSize.Y) return true;
-        return CeilingOccupied[Y * GridSize.X + X];
-    };
-
-    auto MarkCellsOccupied = [&](int32 StartX, int32 StartY, FIntPoint Size)
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                int32 X = StartX + dx;
-                int32 Y = StartY + dy;
-                if (X >= 0 && X < GridSize.X && Y >= 0 && Y < GridSize.Y)
-                {
-                    CeilingOccupied[Y * GridSize.X + X] = true;
-                }
-            }
-        }
-    };
-
-    auto IsAreaAvailable = [&](int32 StartX, int32 StartY, FIntPoint Size) -> bool
-    {
-        for (int32 dy = 0; dy < Size.Y; dy++)
-        {
-            for (int32 dx = 0; dx < Size.X; dx++)
-            {
-                if (IsCellOccupied(StartX + dx, StartY + dy))
-                    return false;
-            }
-        }
-        return true;
-    };
-
-    auto SelectWeightedTile = [&](const TArray<FCeilingTile>& Pool) -> const FCeilingTile*
-    {
-        if (Pool.  Num() == 0) return nullptr;
-
-        float TotalWeight = 0.0f;
-        for (const FCeilingTile& Tile : Pool)
-            TotalWeight += Tile.PlacementWeight;
-
-        if (TotalWeight <= 0.0f)
-            return &Pool[Stream.RandRange(0, Pool.Num() - 1)];
-
-        float RandomValue = Stream.FRand() * TotalWeight;
-        float CurrentWeight = 0.0f;
-
-        for (const FCeilingTile& Tile : Pool)
-        {
-            CurrentWeight += Tile.PlacementWeight;
-            if (RandomValue <= CurrentWeight)
-                return &Tile;
-        }
-
-        return &Pool.  Last();
-    };
-
-	// Pass 0 Forced Placements
-	int32 ForcedCount = ExecuteForcedCeilingPlacements(CeilingOccupied);
-	if (ForcedCount > 0)
-	{
-		UE_LOG(LogTemp, Log, TEXT("  Phase 0: Placed %d forced ceiling tiles"), ForcedCount);
-	}
-	
-    // ========================================================================
-    // PASS 1:  LARGE TILES (4x4)
-    // ========================================================================
-
-    if (CeilingData->LargeTilePool.Num() > 0)
-    {
-        for (int32 Y = 0; Y <= GridSize.Y - 4; Y++)
-        {
-            for (int32 X = 0; X <= GridSize.X - 4; X++)
-            {
-                // ✅ CHANGED:    Use GridFootprint instead of hardcoded size
-                FIntPoint TargetSize(4, 4);
-                
-                if (IsAreaAvailable(X, Y, TargetSize))
-                {
-                    const FCeilingTile* SelectedTile = SelectWeightedTile(CeilingData->LargeTilePool);
-
-                    if (SelectedTile && ! SelectedTile->Mesh. IsNull())
-                    {
-                        // ✅ CHANGED:   Use GridFootprint from tile
-                        FIntPoint TileFootprint = SelectedTile->GridFootprint;
-                        
-                        // Calculate center position based on actual footprint
-                        FVector TilePosition = FVector(
-                            (X + TileFootprint.X / 2.0f) * CellSize,
-                            (Y + TileFootprint.Y / 2.0f) * CellSize,
-                            CeilingData->CeilingHeight
-                        );
-
-                        FTransform TileTransform(CeilingData->CeilingRotation, TilePosition, FVector(1.0f));
-
-                        FPlacedCeilingInfo PlacedTile;
-                        PlacedTile.GridCoordinate = FIntPoint(X, Y);
-                        PlacedTile.TileSize = TileFootprint;  // ✅ Use actual footprint
-                        PlacedTile. Mesh = SelectedTile->Mesh;
-                        PlacedTile.Transform = TileTransform;
-
-                        PlacedCeilingTiles.Add(PlacedTile);
-                        MarkCellsOccupied(X, Y, TileFootprint);  // ✅ Use actual footprint
-                        CeilingLargeTilesPlaced++;
-                    }
-                }
-            }
-        }
-    }
-
-    // ========================================================================
-    // PASS 2:  MEDIUM TILES (2x2)
-    // ========================================================================
-
-    if (CeilingData->MediumTilePool.Num() > 0)
-    {
-        for (int32 Y = 0; Y <= GridSize.Y - 2; Y++)
-        {
-            for (int32 X = 0; X <= GridSize.X - 2; X++)
-            {
-                // ✅ CHANGED:   Use GridFootprint
-                FIntPoint TargetSize(2, 2);
-                
-                if (IsAreaAvailable(X, Y, TargetSize))
-                {
-                    const FCeilingTile* SelectedTile = SelectWeightedTile(CeilingData->MediumTilePool);
-
-                    if (SelectedTile && !SelectedTile->Mesh.IsNull())
-                    {
-                        // ✅ CHANGED:   Use GridFootprint from tile
-                        FIntPoint TileFootprint = SelectedTile->GridFootprint;
-                        
-                        FVector TilePosition = FVector(
-                            (X + TileFootprint.X / 2.0f) * CellSize,
-                            (Y + TileFootprint.Y / 2.0f) * CellSize,
-                            CeilingData->CeilingHeight
-                        );
-
-                        FTransform TileTransform(CeilingData->CeilingRotation, TilePosition, FVector(1.0f));
-
-                        FPlacedCeilingInfo PlacedTile;
-                        PlacedTile.GridCoordinate = FIntPoint(X, Y);
-                        PlacedTile.TileSize = TileFootprint;
-                        PlacedTile. Mesh = SelectedTile->Mesh;
-                        PlacedTile.Transform = TileTransform;
-
-                        PlacedCeilingTiles.Add(PlacedTile);
-                        MarkCellsOccupied(X, Y, TileFootprint);
-                        CeilingMediumTilesPlaced++;
-                    }
-                }
-            }
-        }
-    }
-
-    // ========================================================================
-    // PASS 3:  SMALL TILES (1x1)
-    // ========================================================================
-
-    if (CeilingData->SmallTilePool.Num() > 0)
-    {
-        for (int32 Y = 0; Y < GridSize.Y; Y++)
-        {
-            for (int32 X = 0; X < GridSize.X; X++)
-            {
-                if (!  IsCellOccupied(X, Y))
-                {
-                    const FCeilingTile* SelectedTile = SelectWeightedTile(CeilingData->SmallTilePool);
-
-                    if (SelectedTile && ! SelectedTile->Mesh. IsNull())
-                    {
-                        // ✅ CHANGED:   Use GridFootprint from tile
-                        FIntPoint TileFootprint = SelectedTile->GridFootprint;
-                        
-                        FVector TilePosition = FVector(
-                            (X + TileFootprint.X / 2.0f) * CellSize,
-                            (Y + TileFootprint.Y / 2.0f) * CellSize,
-                            CeilingData->CeilingHeight
-                        );
-
-                        FTransform TileTransform(CeilingData->CeilingRotation, TilePosition, FVector(1.0f));
-
-                        FPlacedCeilingInfo PlacedTile;
-                        PlacedTile. GridCoordinate = FIntPoint(X, Y);
-                        PlacedTile.TileSize = TileFootprint;
-                        PlacedTile.Mesh = SelectedTile->Mesh;
-                        PlacedTile.Transform = TileTransform;
-
-                        PlacedCeilingTiles.Add(PlacedTile);
-                        MarkCellsOccupied(X, Y, TileFootprint);
-                        CeilingSmallTilesPlaced++;
-                    }
-                }
-            }
-        }
-    }
-
-    UE_LOG(LogTemp, Log, TEXT("URoomGenerator::GenerateCeiling - Complete:    %d large, %d medium, %d small = %d total"),
-        CeilingLargeTilesPlaced, CeilingMediumTilesPlaced, CeilingSmallTilesPlaced, PlacedCeilingTiles. Num());
-
-    return true;
+	TSharedPtr<FRoomGenerationSnapshot> Snapshot = MakeShared<FRoomGenerationSnapshot>();
+	if (!Snapshot->Build(RoomData, GridSize)) return nullptr;
+	return Snapshot;
 }
 
-int32 URoomGenerator::ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupied)
+bool URoomGenerator::RefreshSnapshot()
 {
-	if (!bIsInitialized || !RoomData)
-	{
-		UE_LOG(LogTemp, Error, TEXT("URoomGenerator::ExecuteForcedCeilingPlacements - Not initialized! "));
-		return 0;
-	}
-
-	// Check if there are any forced placements
-	if (RoomData->ForcedCeilingPlacements.Num() == 0)
-	{
-		UE_LOG(LogTemp, Verbose, TEXT("URoomGenerator:: ExecuteForcedCeilingPlacements - No forced ceiling tiles"));
-		return 0;
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ExecuteForcedCeilingPlacements - Processing %d forced tiles"),
-		RoomData->ForcedCeilingPlacements. Num());
-
-	int32 SuccessfulPlacements = 0;
-	int32 FailedPlacements = 0;
-
-	// Load ceiling data for height/rotation
-	UCeilingData* CeilingData = RoomData->CeilingStyleData. LoadSynchronous();
-	if (!CeilingData)
-	{
-		UE_LOG(LogTemp, Error, TEXT("ExecuteForcedCeilingPlacements - Failed to load CeilingStyleData"));
-		return 0;
-	}
-
-	for (int32 i = 0; i < RoomData->ForcedCeilingPlacements.Num(); ++i)
-	{
-		const FForcedCeilingPlacement& ForcedTile = RoomData->ForcedCeilingPlacements[i];
-		const FCeilingTile& TileInfo = ForcedTile.TileInfo;
-
-		UE_LOG(LogTemp, Log, TEXT("  Forced Tile [%d]: Coord=(%d,%d), Footprint=(%d,%d), AllowedRotations=%d"),
-			i, ForcedTile.GridCoordinate.X, ForcedTile.GridCoordinate.Y,
-			TileInfo.GridFootprint.X, TileInfo. GridFootprint.Y,
-			ForcedTile. AllowedRotations.Num());
-
-		// VALIDATION: Load mesh
-		UStaticMesh* Mesh = TileInfo. Mesh.LoadSynchronous();
-		if (!Mesh)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED:  Mesh failed to load"));
-			FailedPlacements++;
-			continue;
-		}
-
-		// ✅ FIXED:  Determine rotation with proper logic
-		FRotator TileRotation = CeilingData->CeilingRotation;  // Start with base rotation
-		int32 AdditionalYaw = 0;  // Track additional rotation for logging
-		
-		if (ForcedTile.AllowedRotations.Num() > 0)
-		{
-			// Pick random rotation from allowed list
-			int32 RandomIndex = FMath:: RandRange(0, ForcedTile.AllowedRotations.Num() - 1);
-			AdditionalYaw = ForcedTile.AllowedRotations[RandomIndex];
-			
-			// Add to base rotation
-			TileRotation. Yaw += AdditionalYaw;
-			
-			// ✅ NEW: Log the selected rotation
-			UE_LOG(LogTemp, Log, TEXT("    Selected rotation: %d° (from %d options, index %d)"),
-				AdditionalYaw, ForcedTile.AllowedRotations.Num(), RandomIndex);
-			UE_LOG(LogTemp, Log, TEXT("    Final rotation:  Pitch=%.1f, Yaw=%.1f, Roll=%.1f"),
-				TileRotation.Pitch, TileRotation.Yaw, TileRotation.Roll);
-		}
-		else
-		{
-			// ✅ NEW: Log default rotation usage
-			UE_LOG(LogTemp, Log, TEXT("    Using default CeilingData rotation:  Pitch=%.1f, Yaw=%.1f, Roll=%.1f"),
-				TileRotation.Pitch, TileRotation.Yaw, TileRotation.Roll);
-		}
-
-		// VALIDATION:  Check bounds (use potentially rotated footprint)
-		int32 StartX = ForcedTile. GridCoordinate.X;
-		int32 StartY = ForcedTile.GridCoordinate.Y;
-		
-		// ✅ IMPORTANT: Get rotated footprint for bounds checking
-		FIntPoint EffectiveFootprint = GetRotatedFootprint(TileInfo. GridFootprint, AdditionalYaw);
-		
-		int32 EndX = StartX + EffectiveFootprint.X;
-		int32 EndY = StartY + EffectiveFootprint.Y;
-
-		if (EndX > GridSize.X || EndY > GridSize.Y || StartX < 0 || StartY < 0)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("    SKIPPED:  Out of bounds (Start=%d,%d, End=%d,%d, GridSize=%d,%d)"),
-				StartX, StartY, EndX, EndY, GridSize.X, GridSize.Y);
-			FailedPlacements++;
-			continue;
-		}
-
-		// VALIDATION: Check if area is available (use rotated footprint)
-		bool bCanPlace = true;
-		for (int32 dy = 0; dy < EffectiveFootprint.Y; ++dy)
-		{
-			for (int32 dx = 0; dx < EffectiveFootprint.X; ++dx)
-			{
-				int32 CheckX = StartX + dx;
-				int32 CheckY = StartY + dy;
-				int32 Index = CheckY * GridSize.X + CheckX;
-
-				if (CeilingOccupied. IsValidIndex(Index) && CeilingOccupied[Index])
-				{
-					bCanPlace = false;
-					UE_LOG(LogTemp, Warning, TEXT("    SKIPPED:  Cell (%d,%d) already occupied"), CheckX, CheckY);
-					break;
-				}
-			}
-			if (!bCanPlace) break;
-		}
-
-		if (! bCanPlace)
-		{
-			FailedPlacements++;
-			continue;
-		}
-
-		// PLACEMENT: Calculate transform (use rotated footprint for centering)
-		FVector TilePosition = FVector(
-			(StartX + EffectiveFootprint.X / 2.0f) * CellSize,
-			(StartY + EffectiveFootprint.Y / 2.0f) * CellSize,
-			CeilingData->CeilingHeight
-		);
-
-		FTransform TileTransform(TileRotation, TilePosition, FVector(1.0f));
-
-		// TRACKING: Store placed tile
-		FPlacedCeilingInfo PlacedTile;
-		PlacedTile.GridCoordinate = FIntPoint(StartX, StartY);
-		PlacedTile.TileSize = EffectiveFootprint;  // ✅ Use rotated footprint
-		PlacedTile.Mesh = TileInfo.Mesh;
-		PlacedTile.Transform = TileTransform;
-
-		PlacedCeilingTiles.Add(PlacedTile);
-
-		// OCCUPANCY: Mark cells as occupied (use rotated footprint)
-		for (int32 dy = 0; dy < EffectiveFootprint.Y; ++dy)
-		{
-			for (int32 dx = 0; dx < EffectiveFootprint. X; ++dx)
-			{
-				int32 MarkX = StartX + dx;
-				int32 MarkY = StartY + dy;
-				int32 Index = MarkY * GridSize.X + MarkX;
-
-				if (CeilingOccupied.IsValidIndex(Index))
-				{
-					CeilingOccupied[Index] = true;
-				}
-			}
-		}
+	if (!bIsInitialized)
+	{ UE_LOG(LogTemp, Error, TEXT("URoomGenerator::RefreshSnapshot - Generator not initialized!")); return false; }
 
-		UE_LOG(LogTemp, Log, TEXT("    ✓ Placed forced tile at (%d,%d) size (%dx%d) rotation (%.0f°)"),
-			StartX, StartY, EffectiveFootprint.X, EffectiveFootprint.Y, TileRotation.Yaw);
-		SuccessfulPlacements++;
-	}
+	if (bAsyncGenerationPending)
+	{ UE_LOG(LogTemp, Warning, TEXT("URoomGenerator::RefreshSnapshot - Async generation in flight, ignoring call")); return false; }
 
-	UE_LOG(LogTemp, Log, TEXT("URoomGenerator::ExecuteForcedCeilingPlacements - Placed %d/%d tiles (%d failed)"),
-		SuccessfulPlacements, RoomData->ForcedCeilingPlacements.Num(), FailedPlacements);
+	// Rebuilt per call so designer edits to RoomData apply on the next generate, as before
+	TSharedPtr<const FRoomGenerationSnapshot> Snapshot = BuildSnapshot();
+	if (!Snapshot.IsValid()) return false;
 
-	return SuccessfulPlacements;
+	Core->SetSnapshot(Snapshot);
+	return true;
 }
-#pragma endregion
 
-#pragma region Internal Floor Generation
-void URoomGenerator::FillWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, 
-	FIntPoint TargetSize,
-	int32& OutLargeTiles,
-	int32& OutMediumTiles,
-	int32& OutSmallTiles,
-	int32& OutFillerTiles)
+void URoomGenerator::RequestStylePreload(FOnRoomAssetsPreloaded OnComplete)
 {
-	// Filter tiles that match target size
-	TArray<FMeshPlacementInfo> MatchingTiles;
+	TArray<FSoftObjectPath> StylePaths;
+	UDungeonGenerationHelpers::CollectRoomStyleAssetPaths(RoomData, StylePaths);
 
-	for (const FMeshPlacementInfo& MeshInfo : TilePool)
+	// Only what this preload has not asked for yet (resident styles too, so the new handles pin them); a preset
+	// exposes its region styles one level down
+	StylePaths.RemoveAll([this](const FSoftObjectPath& Path)
 	{
-		FIntPoint Footprint = CalculateFootprint(MeshInfo);
+		return RequestedStylePaths.Contains(Path);
+	});
 
-		// Check if footprint matches target size (or rotated version)
-		if ((Footprint.X == TargetSize.X && Footprint.Y == TargetSize.Y) ||
-			(Footprint.X == TargetSize.Y && Footprint. Y == TargetSize.X))
-		{
-			MatchingTiles.Add(MeshInfo);
-		}
-	}
-
-	if (MatchingTiles.Num() == 0) return; // No tiles of this size
-
-	UE_LOG(LogTemp, Verbose, TEXT("URoomGenerator::FillWithTileSize - Filling with %dx%d tiles (%d options)"), 
-		TargetSize.X, TargetSize.Y, MatchingTiles.Num());
-
-	// Try to place tiles of this size across the grid
-	for (int32 Y = 0; Y < GridSize.Y; ++Y)
+	if (StylePaths.Num() == 0)
 	{
-		for (int32 X = 0; X < GridSize.X; ++X)
-		{
-			FIntPoint StartCoord(X, Y);
-
-			// Check if area is available for target size
-			if (IsAreaAvailable(StartCoord, TargetSize))
-			{
-				// Select weighted random mesh
-				FMeshPlacementInfo SelectedMesh = SelectWeightedMesh(MatchingTiles);
-				FIntPoint OriginalFootprint = CalculateFootprint(SelectedMesh);
-
-				// Find rotation that matches target size
-				int32 BestRotation = 0;
-				
-				if (SelectedMesh.AllowedRotations.Num() > 0)
-				{
-					// Build list of rotations that would fit the target size
-					TArray<int32> ValidRotations;
-
-					for (int32 Rotation :  SelectedMesh.AllowedRotations)
-					{
-						FIntPoint RotatedFootprint = GetRotatedFootprint(OriginalFootprint, Rotation);
-						
-						if (RotatedFootprint.X == TargetSize.X && RotatedFootprint.Y == TargetSize.Y)
-						{
-							ValidRotations.Add(Rotation);
-						}
-					}
-
-					// Select random rotation from valid options
-					if (ValidRotations.Num() > 0)
-					{
-						int32 RandomIndex = FMath::RandRange(0, ValidRotations.Num() - 1);
-						BestRotation = ValidRotations[RandomIndex];
-					}
-				}
-
-				// Try to place mesh with selected rotation
-				if (TryPlaceMesh(StartCoord, TargetSize, SelectedMesh, BestRotation))
-				{
-					// Update statistics
-					int32 TileArea = TargetSize.X * TargetSize.Y;
-					if (TileArea >= 16) OutLargeTiles++;
-					else if (TileArea >= 4) OutMediumTiles++;
-					else if (TileArea >= 2) OutSmallTiles++;
-					else OutFillerTiles++;
-				}
-			}
-		}
+		RequestMeshPreload(OnComplete);
+		return;
 	}
+
+	RequestedStylePaths.Append(StylePaths);
+	PreloadHandles.Add(UAssetManager::GetStreamableManager().RequestAsyncLoad(StylePaths,
+		FStreamableDelegate::CreateWeakLambda(this, [this, OnComplete]() { RequestStylePreload(OnComplete); })));
 }
 
-FMeshPlacementInfo URoomGenerator::SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool)
+void URoomGenerator::RequestMeshPreload(FOnRoomAssetsPreloaded OnComplete)
 {
-	if (Pool.Num() == 0) return FMeshPlacementInfo(); // Return empty if no options
-
-	if (Pool.Num() == 1) return Pool[0]; // Only one option
+	TArray<FSoftObjectPath> MeshPaths;
+	UDungeonGenerationHelpers::CollectRoomMeshPaths(RoomData, MeshPaths);
 
-	// Calculate total weight
-	float TotalWeight = 0.0f;
-	for (const FMeshPlacementInfo& MeshInfo : Pool) { TotalWeight += MeshInfo.PlacementWeight; }
-
-	// Random value between 0 and total weight
-	float RandomValue = FMath::FRandRange(0.0f, TotalWeight);
-
-	// Select mesh based on weight
-	float CurrentWeight = 0.0f;
-	for (const FMeshPlacementInfo& MeshInfo : Pool)
+	auto Finish = [this, OnComplete, MeshPaths]()
 	{
-		CurrentWeight += MeshInfo.PlacementWeight;
-		if (RandomValue <= CurrentWeight) return MeshInfo;
-	}
-
-	// Fallback to last mesh
-	return Pool. Last();
-}
+		int32 MissingCount = 0;
+		for (const FSoftObjectPath& Path : MeshPaths)
+		{
+			if (!Path.ResolveObject()) ++MissingCount;
+		}
 
-bool URoomGenerator::TryPlaceMesh(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation)
-{
-	// Check if area is available
-	if (! IsAreaAvailable(StartCoord, Size)) return false;
-
-	// Mark area as occupied
-	if (!MarkArea(StartCoord, Size, EGridCellType::ECT_FloorMesh)) return false;
-	
-	// Create placed mesh info
-	FPlacedMeshInfo PlacedMesh;
-	PlacedMesh.GridPosition = StartCoord;
-	PlacedMesh.Size = Size;
-	PlacedMesh.Rotation = Rotation;
-	PlacedMesh.MeshInfo = MeshInfo;
-
-	// FIXED: Calculate center of entire mesh footprint, not just first cell
-	// Formula: TopLeftCorner + (MeshSize * CellSize * 0.5)
-	// Example: 2x2 mesh at (0,0) = (0,0) + (200*0.5, 200*0.5) = (100, 100)
-	float OffsetX = (Size.X * CellSize) * 0.5f;
-	float OffsetY = (Size.Y * CellSize) * 0.5f;
-	
-	FVector LocalPos = FVector( StartCoord. X * CellSize + OffsetX, StartCoord.Y * CellSize + OffsetY, 0.0f);
-
-	PlacedMesh.WorldTransform = FTransform(FRotator(0, Rotation, 0), 
-		LocalPos,FVector::OneVector );
-
-	// Store placed mesh
-	PlacedFloorMeshes.Add(PlacedMesh);
+		UE_LOG(LogTemp, Log, TEXT("URoomGenerator::PreloadAssetsAsync - %d meshes resident, %d failed to load"),
+			MeshPaths.Num() - MissingCount, MissingCount);
 
-	return true;
-}
-
-FIntPoint URoomGenerator::CalculateFootprint(const FMeshPlacementInfo& MeshInfo) const
-{
-	// If footprint is explicitly defined, use it
-	if (MeshInfo.GridFootprint.X > 0 && MeshInfo. GridFootprint.Y > 0) return MeshInfo.GridFootprint;
+		bPreloadPending = false;
+		OnComplete.ExecuteIfBound(MissingCount == 0);
+	};
 
-	// Otherwise, calculate from mesh bounds
-	if (! MeshInfo.MeshAsset. IsNull())
+	if (MeshPaths.Num() == 0)
 	{
-		// For now, return default 1x1 if bounds not available
-		// TODO: Load mesh and calculate actual bounds
-		return FIntPoint(1, 1);
+		Finish();
+		return;
 	}
 
-	// Fallback
-	return FIntPoint(1, 1);
-}
-#pragma endregion
-
-#pragma region Coordinate Conversion
-
-FVector URoomGenerator::GridToLocalPosition(FIntPoint GridCoord) const
-{
-	// Calculate center of cell
-	float LocalX = GridCoord.X * CellSize + (CellSize * 0.5f);
-	float LocalY = GridCoord.Y * CellSize + (CellSize * 0.5f);
-	return FVector(LocalX, LocalY, 0.0f);
-}
-
-FIntPoint URoomGenerator::LocalToGridPosition(FVector LocalPos) const
-{
-	// Floor division to get grid coordinate
-	int32 GridX = FMath::FloorToInt(LocalPos.X / CellSize);
-	int32 GridY = FMath:: FloorToInt(LocalPos. Y / CellSize);
-	return FIntPoint(GridX, GridY);
-}
-
-FIntPoint URoomGenerator::GetRotatedFootprint(FIntPoint OriginalFootprint, int32 Rotation)
-{
-	// Normalize rotation to 0-359 range
-	Rotation = Rotation % 360;
-	if (Rotation < 0) Rotation += 360;
-
-	// For 90 and 270 degree rotations, swap X and Y
-	if (Rotation == 90 || Rotation == 270) return FIntPoint(OriginalFootprint.Y, OriginalFootprint.X);
-
-	// For 0 and 180 degree rotations, keep original
-	return OriginalFootprint;
-}
-#pragma endregion
-
-#pragma region Room Statistics
-
-int32 URoomGenerator::GetCellCountByType(EGridCellType CellType) const
-{
-	int32 Count = 0;
-	for (const EGridCellType& Cell : GridState)
-	{ if (Cell == CellType) ++Count; } return Count;
-}
-
-float URoomGenerator::GetOccupancyPercentage() const
-{
-	int32 TotalCells = GetTotalCellCount();
-	if (TotalCells == 0) return 0.0f;
-
-	int32 OccupiedCells = GetCellCountByType(EGridCellType::ECT_FloorMesh);
-	return (static_cast<float>(OccupiedCells) / static_cast<float>(TotalCells)) * 100.0f;
-}
-#pragma endregion
-
-#pragma region Internal Helpers
-
-int32 URoomGenerator::GridCoordToIndex(FIntPoint GridCoord) const
-{
-	// Row-major order: Index = Y * Width + X
-	return GridCoord.Y * GridSize.X + GridCoord.X;
-}
-
-FIntPoint URoomGenerator:: IndexToGridCoord(int32 Index) const
-{
-	// Reverse row-major order
-	int32 X = Index % GridSize.X;
-	int32 Y = Index / GridSize.X;
-	return FIntPoint(X, Y);
-}
-
-void URoomGenerator::FillWallEdge(EWallEdge Edge)
-{
-    if (!  RoomData || RoomData->WallStyleData.IsNull()) return;
-
-    UWallData* WallData = RoomData->WallStyleData.LoadSynchronous();
-    if (!WallData || WallData->AvailableWallModules. Num() == 0) return;
-
-    TArray<FIntPoint> EdgeCells = UDungeonGenerationHelpers::GetEdgeCellIndices(Edge, GridSize);
-    if (EdgeCells.Num() == 0) return;
-
-    FRotator WallRotation = UDungeonGenerationHelpers:: GetWallRotationForEdge(Edge);
-    UE_LOG(LogTemp, Verbose, TEXT("  Filling edge %s with %d cells"),
-        *UEnum::GetValueAsString(Edge), EdgeCells.Num());
-
-    // Greedy bin packing: Fill with largest modules first (BASE LAYER ONLY)
-    int32 CurrentCell = 0;
-
-    while (CurrentCell < EdgeCells. Num())
-    {
-        // ✅ FIXED:   Check if THIS SPECIFIC CELL is part of a doorway
-        FIntPoint CellToCheck = EdgeCells[CurrentCell];
-        
-        if (IsCellPartOfDoorway(CellToCheck))
-        {
-            UE_LOG(LogTemp, Warning, TEXT("    Skipping cell %d (%d,%d) - part of doorway"),
-                CurrentCell, CellToCheck.X, CellToCheck.Y);
-            CurrentCell++;
-            continue;
-        }
-        
-        // Skip cells occupied by forced walls
-        if (IsCellRangeOccupied(Edge, CurrentCell, 1))
-        {
-            UE_LOG(LogTemp, VeryVerbose, TEXT("    Skipping cell %d (occupied by forced wall)"), CurrentCell);
-            CurrentCell++;
-            continue;
-        }
-        
-        // Find largest module that fits remaining space
-        const FWallModule* BestModule = nullptr;
-        int32 SpaceLeft = EdgeCells.Num() - CurrentCell;
-
-        for (const FWallModule& Module : WallData->AvailableWallModules)
-        {
-            // ✅ FIXED:  Check if the ENTIRE module span overlaps with doorways
-            bool bModuleOverlapsDoorway = false;
-            
-            for (int32 i = 0; i < Module. Y_AxisFootprint; ++i)
-            {
-                int32 CheckIndex = CurrentCell + i;
-                if (CheckIndex < EdgeCells.Num())
-                {
-                    FIntPoint CheckCell = EdgeCells[CheckIndex];
-                    if (IsCellPartOfDoorway(CheckCell))
-                    {
-                        bModuleOverlapsDoorway = true;
-                        break;
-                    }
-                }
-            }
-            
-            if (bModuleOverlapsDoorway)
-            {
-                continue;  // Skip this module - it would overlap a doorway
-            }
-            
-            if (Module.Y_AxisFootprint <= SpaceLeft && 
-                !  IsCellRangeOccupied(Edge, CurrentCell, Module.Y_AxisFootprint))
-            {
-                if (!  BestModule || Module.Y_AxisFootprint > BestModule->Y_AxisFootprint)
-                {
-                    BestModule = &Module;
-                }
-            }
-        }
-
-        if (! BestModule)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("    No wall module fits remaining %d cells on edge %s at cell %d"), 
-                SpaceLeft, *UEnum::GetValueAsString(Edge), CurrentCell);
-            CurrentCell++;  // Skip this cell and try next
-            continue;
-        }
-
-        // Load base mesh
-        UStaticMesh* BaseMesh = BestModule->BaseMesh.LoadSynchronous();
-        if (!BaseMesh)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("    Failed to load base mesh for wall module"));
-            break;
-        }
-
-        // Calculate position for this wall segment
-        FVector BasePosition = UDungeonGenerationHelpers:: CalculateWallPosition(
-            Edge,
-            CurrentCell,
-            BestModule->Y_AxisFootprint,
-            GridSize,
-            CellSize,
-            WallData->NorthWallOffsetX,
-            WallData->SouthWallOffsetX,
-            WallData->EastWallOffsetY,
-            WallData->WestWallOffsetY
-        );
-
-        // Create base wall transform
-        FTransform BaseTransform(WallRotation, BasePosition, FVector:: OneVector);
-
-        // Store segment info for Middle/Top spawning
-        FGeneratorWallSegment Segment;
-        Segment.Edge = Edge;
-        Segment. StartCell = CurrentCell;
-        Segment. SegmentLength = BestModule->Y_AxisFootprint;
-        Segment.BaseTransform = BaseTransform;
-        Segment.BaseMesh = BaseMesh;
-        Segment.WallModule = BestModule;
-
-        PlacedBaseWallSegments.Add(Segment);
-
-        UE_LOG(LogTemp, VeryVerbose, TEXT("    Tracked %d-cell base wall at cell %d"),
-            BestModule->Y_AxisFootprint, CurrentCell);
-
-        // Advance to next segment
-        CurrentCell += BestModule->Y_AxisFootprint;
-    }
+	// One request for the whole room, so the loader can batch and order the package reads itself
+	PreloadHandles.Add(UAssetManager::GetStreamableManager().RequestAsyncLoad(MeshPaths,
+		FStreamableDelegate::CreateWeakLambda(this, Finish)));
 }
 #pragma endregion
@@ -2,25 +2,541 @@
 
 
 #include "Spawners/Dungeon/DungeonSpawner.h"
+#include "Generators/Dungeon/DungeonCorridorRouter.h"
+#include "Generators/Room/RoomGenerator.h"
+#include "Generators/Room/RoomGenerationCore.h"
+#include "Generators/Room/RoomGenerationSnapshot.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Data/Room/DoorData.h"
+#include "Data/Room/RoomData.h"
+#include "RoomActors/DoorwayActor.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 
+/* Output of one room job; each job writes only its own slot of the shared results array */
+struct FDungeonRoomBuildResult
+{
+	// The room's own core (palette and placement records); null if the room was never launched
+	TSharedPtr<FRoomGenerationCore> Core;
+
+	// Room cell (0,0) relative to the spawner, in cm
+	FVector RoomOffset = FVector::ZeroVector;
+
+	// Floor, wall, corner and ceiling instances already moved into spawner space (indexed by the core's palette ids)
+	FMeshInstanceBuffers Instances[4];
+
+	bool bSuccess = false;
+};
+
+/* Output of the corridor task: floor and wall instances in spawner space over a palette of their own */
+struct FDungeonCorridorBuildResult
+{
+	FRoomMeshPalette Palette;
+	FMeshInstanceBuffers FloorInstances;
+	FMeshInstanceBuffers WallInstances;
+	int32 NumCorridors = 0;
+};
+
+namespace DungeonSpawner
+{
+	// Copy room-space instance buffers, moving every transform by Offset (runs on the room's worker)
+	static void OffsetInstances(const FMeshInstanceBuffers& Source, const FVector& Offset, FMeshInstanceBuffers& OutInstances)
+	{
+		OutInstances.Transforms.SetNum(Source.Transforms.Num());
+		for (int32 MeshId = 0; MeshId < Source.Transforms.Num(); ++MeshId)
+		{
+			TArray<FTransform>& Batch = OutInstances.Transforms[MeshId];
+			Batch = Source.Transforms[MeshId];
+			for (FTransform& Transform : Batch) { Transform.AddToTranslation(Offset); }
+		}
+	}
+
+	// Append a buffer set to the merged one, remapping its palette ids into the merged palette
+	static void MergeInstances(const FRoomMeshPalette& SourcePalette, const FMeshInstanceBuffers& Source,
+		FRoomMeshPalette& MergedPalette, FMeshInstanceBuffers& OutMerged)
+	{
+		for (int32 MeshId = 0; MeshId < Source.Transforms.Num(); ++MeshId)
+		{
+			if (Source.Transforms[MeshId].Num() == 0) continue;
+
+			const FRoomMeshId MergedId = MergedPalette.Intern(SourcePalette.GetMesh(static_cast<FRoomMeshId>(MeshId)));
+			if (MergedId == FRoomMeshPalette::InvalidId) continue;
+
+			if (!OutMerged.Transforms.IsValidIndex(MergedId)) OutMerged.Transforms.SetNum(MergedId + 1);
+			OutMerged.Transforms[MergedId].Append(Source.Transforms[MeshId]);
+		}
+	}
+}
 
 // Sets default values
 ADungeonSpawner::ADungeonSpawner()
 {
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Generation is event driven; nothing to tick
+	PrimaryActorTick.bCanEverTick = false;
+
+	DoorwayActorClass = ADoorwayActor::StaticClass();
+	DungeonGenerator = nullptr;
+	GenerationId = 0;
+	bGenerationPending = false;
+	PendingPreloads = 0;
+	GenerationStartTime = 0.0;
+
+	SpawnStage = ERoomSpawnStage::Done;
+	bSpawnStageStarted = false;
+	SpawnMeshId = 0;
+	SpawnInstanceIndex = 0;
+	SpawnRoomIndex = 0;
+	SpawnDoorwayIndex = 0;
+	SpawnedInstanceCount = 0;
+	SpawnedDoorwayCount = 0;
+	bSpawnSucceeded = false;
 }
 
 // Called when the game starts or when spawned
 void ADungeonSpawner::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	if (bGenerateOnBeginPlay)
+	{
+		GenerateDungeonAsync(bUseRandomSeed ? FMath::Rand() : DungeonSeed, FOnDungeonSpawnComplete());
+	}
+}
+
+void ADungeonSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Room jobs still running finish on their own; their results are dropped
+	++GenerationId;
+	bGenerationPending = false;
+	CancelTimeSlicedSpawn();
+
+	// Don't keep the rooms' meshes pinned once the actor is gone
+	ReleasePreloadedAssets();
+	Super::EndPlay(EndPlayReason);
+}
+
+#pragma region Runtime Generation
+bool ADungeonSpawner::GenerateDungeonAsync(int32 Seed, const FOnDungeonSpawnComplete& OnComplete)
+{
+	if (bGenerationPending)
+	{ UE_LOG(LogTemp, Warning, TEXT("ADungeonSpawner::GenerateDungeonAsync - Generation already in flight")); return false; }
+
+	if (!DungeonGenerator)
+	{
+		DungeonGenerator = NewObject<UDungeonGenerator>(this, TEXT("DungeonGenerator"));
+		if (!DungeonGenerator)
+		{ UE_LOG(LogTemp, Error, TEXT("ADungeonSpawner::GenerateDungeonAsync - Failed to create DungeonGenerator!")); return false; }
+	}
+
+	// Queued spawn work belongs to the previous dungeon
+	CancelTimeSlicedSpawn();
+
+	GenerationStartTime = FPlatformTime::Seconds();
+
+	// Keep the seed visible so the dungeon can be reproduced
+	DungeonSeed = Seed;
+	if (!DungeonGenerator->GenerateLayout(LayoutSettings, DungeonSeed))
+	{ UE_LOG(LogTemp, Error, TEXT("ADungeonSpawner::GenerateDungeonAsync - Layout generation failed!")); return false; }
+
+	bGenerationPending = true;
+	const int32 RequestId = ++GenerationId;
+
+	// One batched preload per distinct RoomData; the rooms launch once the last of them has finished
+	TArray<URoomData*> RoomDatas;
+	for (const FDungeonRoomNode& Room : DungeonGenerator->GetLayout().Rooms) { RoomDatas.AddUnique(Room.RoomData); }
+
+	PendingPreloads = RoomDatas.Num();
+	for (URoomData* RoomData : RoomDatas)
+	{
+		URoomGenerator*& Preloader = PreloadGenerators.FindOrAdd(RoomData);
+		if (!Preloader)
+		{
+			Preloader = NewObject<URoomGenerator>(this);
+			Preloader->Initialize(RoomData, FIntPoint(4, 4));
+		}
+
+		// A preload left over from a discarded request counts as done; the snapshot build loads anything still missing.
+		// Each preload releases the preloader's previous handles once it holds its own
+		const bool bRequested = Preloader->PreloadAssetsAsync(
+			FOnRoomAssetsPreloaded::CreateUObject(this, &ADungeonSpawner::HandleRoomAssetsPreloaded, RequestId, OnComplete));
+		if (!bRequested) HandleRoomAssetsPreloaded(false, RequestId, OnComplete);
+	}
+
+	return true;
+}
+
+void ADungeonSpawner::HandleRoomAssetsPreloaded(bool bAllLoaded, int32 RequestId, FOnDungeonSpawnComplete OnComplete)
+{
+	if (RequestId != GenerationId) return;
+	if (--PendingPreloads > 0) return;
+
+	LaunchRoomJobs(RequestId, OnComplete);
+}
+
+void ADungeonSpawner::LaunchRoomJobs(int32 RequestId, FOnDungeonSpawnComplete OnComplete)
+{
+	const FDungeonLayout& Layout = DungeonGenerator->GetLayout();
+	TSharedRef<TArray<FDungeonRoomBuildResult>> Results = MakeShared<TArray<FDungeonRoomBuildResult>>();
+	Results->SetNum(Layout.Rooms.Num());
+
+	// Snapshots are immutable, so every room with the same RoomData and size shares one (built here, on the game thread)
+	TMap<TPair<URoomData*, FIntPoint>, TSharedPtr<const FRoomGenerationSnapshot>> Snapshots;
+	TArray<UE::Tasks::FTask> RoomTasks;
+	RoomTasks.Reserve(Layout.Rooms.Num());
+
+	for (int32 RoomIndex = 0; RoomIndex < Layout.Rooms.Num(); ++RoomIndex)
+	{
+		const FDungeonRoomNode& Room = Layout.Rooms[RoomIndex];
+		TSharedPtr<const FRoomGenerationSnapshot>& Snapshot = Snapshots.FindOrAdd(MakeTuple(Room.RoomData, Room.GridSize));
+		if (!Snapshot.IsValid())
+		{
+			TSharedPtr<FRoomGenerationSnapshot> NewSnapshot = MakeShared<FRoomGenerationSnapshot>();
+			if (NewSnapshot->Build(Room.RoomData, Room.GridSize)) Snapshot = NewSnapshot;
+		}
+		if (!Snapshot.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ADungeonSpawner - Room %d: snapshot build failed, skipping"), RoomIndex);
+			continue;
+		}
+
+		// Every job owns its core outright (grid, placement arrays, streams, palette); the layout's doorways replace
+		// the room's own forced/automatic ones so both ends of every connection line up
+		TSharedRef<FRoomGenerationCore> Core = MakeShared<FRoomGenerationCore>();
+		Core->Initialize(Room.GridSize, Room.Seed);
+		Core->SetSnapshot(Snapshot);
+		Core->SetEmitInstanceBuffers(true);
+		if (Room.Doorways.Num() > 0) Core->SetDoorwayLayouts(Room.Doorways);
+
+		const FVector RoomOffset(Room.GridOrigin.X * CELL_SIZE, Room.GridOrigin.Y * CELL_SIZE, 0.0f);
+		RoomTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [Results, RoomIndex, Core, RoomOffset]()
+		{
+			FDungeonRoomBuildResult& Result = (*Results)[RoomIndex];
+			Result.bSuccess = Core->GenerateAll();
+			Result.RoomOffset = RoomOffset;
+
+			// Moving instances into spawner space here keeps the game-thread merge to plain appends
+			DungeonSpawner::OffsetInstances(Core->GetFloorInstances(), RoomOffset, Result.Instances[0]);
+			DungeonSpawner::OffsetInstances(Core->GetWallInstances(), RoomOffset, Result.Instances[1]);
+			DungeonSpawner::OffsetInstances(Core->GetCornerInstances(), RoomOffset, Result.Instances[2]);
+			DungeonSpawner::OffsetInstances(Core->GetCeilingInstances(), RoomOffset, Result.Instances[3]);
+			Result.Core = Core;
+		}));
+	}
+
+	// Corridors only need the room graph, so they route on a task of their own next to the rooms (on a copy of the
+	// layout, which the game thread may clear meanwhile)
+	TSharedRef<FDungeonCorridorBuildResult> CorridorResult = MakeShared<FDungeonCorridorBuildResult>();
+	if (bRouteCorridors && Layout.Connections.Num() > 0)
+	{
+		TSharedRef<const FDungeonLayout> LayoutCopy = MakeShared<FDungeonLayout>(Layout);
+		RoomTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [LayoutCopy, CorridorResult, FloorMesh = CorridorFloorMesh, WallMesh = CorridorWallMesh]()
+		{
+			FDungeonCorridorRouter Router;
+			Router.Build(*LayoutCopy);
+			CorridorResult->NumCorridors = Router.RouteAll();
+			Router.EmitPlacements(FloorMesh, WallMesh, CorridorResult->Palette, CorridorResult->FloorInstances, CorridorResult->WallInstances);
+		}));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ADungeonSpawner - Launched %d room jobs (%d distinct snapshots)"), Layout.Rooms.Num(), Snapshots.Num());
+
+	// Merge once every room is done; stale requests are filtered by id on the game thread
+	TWeakObjectPtr<ADungeonSpawner> WeakThis(this);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, RequestId, Results, CorridorResult, OnComplete]()
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, RequestId, Results, CorridorResult, OnComplete]()
+		{
+			if (ADungeonSpawner* Spawner = WeakThis.Get()) Spawner->HandleRoomsGenerated(RequestId, Results, CorridorResult, OnComplete);
+		});
+	}, UE::Tasks::Prerequisites(RoomTasks));
 }
 
-// Called every frame
-void ADungeonSpawner::Tick(float DeltaTime)
+void ADungeonSpawner::HandleRoomsGenerated(int32 RequestId, TSharedRef<TArray<FDungeonRoomBuildResult>> Results,
+	TSharedRef<FDungeonCorridorBuildResult> CorridorResult, FOnDungeonSpawnComplete OnComplete)
 {
-	Super::Tick(DeltaTime);
+	if (RequestId != GenerationId) return;
+	bGenerationPending = false;
+
+	// Remap each built room's palette ids into one dungeon palette and append its (already offset) instances
+	ResetSpawnState();
+	int32 NumBuilt = 0;
+	int32 NumFailed = 0;
+
+	for (const FDungeonRoomBuildResult& Result : *Results)
+	{
+		// A room whose generation failed partway is dropped whole rather than spawned half-built
+		if (!Result.Core.IsValid() || !Result.bSuccess) { ++NumFailed; continue; }
+		++NumBuilt;
+
+		for (int32 Category = 0; Category < 4; ++Category)
+		{
+			DungeonSpawner::MergeInstances(Result.Core->GetMeshPalette(), Result.Instances[Category], SpawnPalette, SpawnInstances[Category]);
+		}
+	}
+
+	// Corridor floors and walls share components with the rooms' floors and walls
+	DungeonSpawner::MergeInstances(CorridorResult->Palette, CorridorResult->FloorInstances, SpawnPalette, SpawnInstances[0]);
+	DungeonSpawner::MergeInstances(CorridorResult->Palette, CorridorResult->WallInstances, SpawnPalette, SpawnInstances[1]);
+
+	for (FMeshInstanceBuffers& Instances : SpawnInstances) { Instances.Transforms.SetNum(SpawnPalette.Num()); }
+
+	SpawnRoomResults = Results;
+	SpawnedInstanceCount = 0;
+	SpawnedDoorwayCount = 0;
+	bSpawnSucceeded = NumBuilt > 0;
+	PendingSpawnComplete = OnComplete;
+
+	UE_LOG(LogTemp, Log, TEXT("ADungeonSpawner - Built %d rooms (%d failed) and %d corridors in %.1f ms (seed %d)"),
+		NumBuilt, NumFailed, CorridorResult->NumCorridors, (FPlatformTime::Seconds() - GenerationStartTime) * 1000.0, DungeonSeed);
+
+	UWorld* World = GetWorld();
+	URoomSpawnScheduler* Scheduler = bTimeSliceSpawning && World && World->IsGameWorld() ? World->GetSubsystem<URoomSpawnScheduler>() : nullptr;
+	if (Scheduler)
+	{
+		SpawnStage = ERoomSpawnStage::Floor;
+		bSpawnStageStarted = false;
+		SpawnMeshId = 0;
+		SpawnInstanceIndex = 0;
+		SpawnRoomIndex = 0;
+		SpawnDoorwayIndex = 0;
+		Scheduler->Enqueue(this);
+		return;
+	}
+
+	const FVector DungeonOrigin = GetActorLocation();
+	SpawnedInstanceCount += UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, SpawnPalette, SpawnInstances[0],
+		FloorMeshComponents, TEXT("FloorISM_"), DungeonOrigin, bUseHierarchicalInstancing, FloorInstanceSettings);
+	SpawnedInstanceCount += UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, SpawnPalette, SpawnInstances[1],
+		WallMeshComponents, TEXT("WallISM_"), DungeonOrigin, bUseHierarchicalInstancing, WallInstanceSettings);
+	SpawnedInstanceCount += UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, SpawnPalette, SpawnInstances[2],
+		CornerMeshComponents, TEXT("CornerISM_"), DungeonOrigin, bUseHierarchicalInstancing, CornerInstanceSettings);
+	SpawnedInstanceCount += UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, SpawnPalette, SpawnInstances[3],
+		CeilingMeshComponents, TEXT("Ceiling_"), DungeonOrigin, bUseHierarchicalInstancing, CeilingInstanceSettings);
+
+	DestroyDoorwayActors();
+	SpawnedDoorwayCount = SpawnAllDoorwayActors();
+	CompleteDungeonSpawn();
 }
 
+bool ADungeonSpawner::SpawnNextBatch(double Deadline)
+{
+	if (SpawnStage == ERoomSpawnStage::Done) return true;
+	if (!SpawnRoomResults.IsValid()) { CancelTimeSlicedSpawn(); return true; }
+
+	const FVector DungeonOrigin = GetActorLocation();
+	const int32 BatchSize = FMath::Max(SpawnBatchSize, 1);
+
+	// One batch of one mesh of a category; components of meshes the new dungeon dropped are released on stage entry
+	auto SpawnInstanceBatch = [&](const FMeshInstanceBuffers& Buffers, TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& Components,
+		const TCHAR* ComponentNamePrefix, const FISMCategorySettings& Settings)
+	{
+		if (!bSpawnStageStarted)
+		{
+			UDungeonSpawnerHelpers::ReleaseUnusedISMComponents(SpawnPalette, Buffers, Components, bUseHierarchicalInstancing);
+			bSpawnStageStarted = true;
+		}
+
+		while (Buffers.Transforms.IsValidIndex(SpawnMeshId) && Buffers.Transforms[SpawnMeshId].Num() == 0) { SpawnMeshId++; }
+		if (!Buffers.Transforms.IsValidIndex(SpawnMeshId)) { AdvanceSpawnStage(); return; }
+
+		const TArray<FTransform>& Batch = Buffers.Transforms[SpawnMeshId];
+		const TSoftObjectPtr<UStaticMesh>& MeshAsset = SpawnPalette.GetMesh(static_cast<FRoomMeshId>(SpawnMeshId));
+		const bool bKeptComponent = Components.Contains(MeshAsset);
+		UInstancedStaticMeshComponent* ISM = UDungeonSpawnerHelpers::GetOrCreateISMComponent(this, MeshAsset,
+			Components, ComponentNamePrefix, true, bUseHierarchicalInstancing, Settings);
+
+		// New components were configured on creation; kept ones pick up edited settings on their first batch
+		if (ISM && bKeptComponent && SpawnInstanceIndex == 0) UDungeonSpawnerHelpers::ApplyISMCategorySettings(ISM, Settings);
+
+		// A mesh that failed to load is skipped whole
+		const int32 Written = ISM
+			? UDungeonSpawnerHelpers::UpdateMeshInstanceRange(ISM, Batch, SpawnInstanceIndex, BatchSize, DungeonOrigin)
+			: Batch.Num() - SpawnInstanceIndex;
+		SpawnInstanceIndex += Written;
+		if (ISM) SpawnedInstanceCount += Written;
+
+		if (SpawnInstanceIndex >= Batch.Num())
+		{
+			UDungeonSpawnerHelpers::TrimMeshInstances(ISM, Batch.Num());
+			SpawnMeshId++;
+			SpawnInstanceIndex = 0;
+		}
+	};
+
+	do
+	{
+		switch (SpawnStage)
+		{
+		case ERoomSpawnStage::Floor:
+			SpawnInstanceBatch(SpawnInstances[0], FloorMeshComponents, TEXT("FloorISM_"), FloorInstanceSettings);
+			break;
+		case ERoomSpawnStage::Walls:
+			SpawnInstanceBatch(SpawnInstances[1], WallMeshComponents, TEXT("WallISM_"), WallInstanceSettings);
+			break;
+		case ERoomSpawnStage::Doorways:
+		{
+			if (!bSpawnStageStarted) { DestroyDoorwayActors(); bSpawnStageStarted = true; }
+
+			// Next doorway of the next room that built successfully
+			const TArray<FDungeonRoomBuildResult>& Results = *SpawnRoomResults;
+			while (Results.IsValidIndex(SpawnRoomIndex) && (!Results[SpawnRoomIndex].Core.IsValid() || !Results[SpawnRoomIndex].bSuccess
+				|| SpawnDoorwayIndex >= Results[SpawnRoomIndex].Core->GetPlacedDoorways().Num()))
+			{
+				SpawnRoomIndex++;
+				SpawnDoorwayIndex = 0;
+			}
+
+			if (Results.IsValidIndex(SpawnRoomIndex))
+			{
+				const FDungeonRoomBuildResult& Result = Results[SpawnRoomIndex];
+				if (SpawnDoorwayActor(Result.Core->GetPlacedDoorways()[SpawnDoorwayIndex++], Result.RoomOffset)) SpawnedDoorwayCount++;
+			}
+			else AdvanceSpawnStage();
+			break;
+		}
+		case ERoomSpawnStage::Corners:
+			SpawnInstanceBatch(SpawnInstances[2], CornerMeshComponents, TEXT("CornerISM_"), CornerInstanceSettings);
+			break;
+		case ERoomSpawnStage::Ceiling:
+			SpawnInstanceBatch(SpawnInstances[3], CeilingMeshComponents, TEXT("Ceiling_"), CeilingInstanceSettings);
+			break;
+		default:
+			break;
+		}
+	}
+	while (SpawnStage != ERoomSpawnStage::Done && FPlatformTime::Seconds() < Deadline);
+
+	if (SpawnStage != ERoomSpawnStage::Done) return false;
+
+	CompleteDungeonSpawn();
+	return true;
+}
+
+void ADungeonSpawner::ClearDungeon()
+{
+	++GenerationId;
+	bGenerationPending = false;
+	CancelTimeSlicedSpawn();
+
+	UDungeonSpawnerHelpers::ClearISMComponentMap(FloorMeshComponents);
+	UDungeonSpawnerHelpers::ClearISMComponentMap(WallMeshComponents);
+	UDungeonSpawnerHelpers::ClearISMComponentMap(CornerMeshComponents);
+	UDungeonSpawnerHelpers::ClearISMComponentMap(CeilingMeshComponents);
+	DestroyDoorwayActors();
+
+	if (DungeonGenerator) DungeonGenerator->ClearLayout();
+	ReleasePreloadedAssets();
+}
+#pragma endregion
+
+#pragma region Editor Functions
+#if WITH_EDITOR
+void ADungeonSpawner::GenerateDungeon()
+{
+	GenerateDungeonAsync(bUseRandomSeed ? FMath::Rand() : DungeonSeed, FOnDungeonSpawnComplete());
+}
+#endif
+#pragma endregion
+
+#pragma region Internal Helpers
+bool ADungeonSpawner::SpawnDoorwayActor(const FPlacedDoorwayInfo& PlacedDoor, const FVector& RoomOffset)
+{
+	if (!DoorwayActorClass || !PlacedDoor.DoorData) return false;
+
+	// Room space → dungeon space → world space
+	FTransform WorldTransform = PlacedDoor.FrameTransform;
+	WorldTransform.AddToTranslation(RoomOffset + GetActorLocation());
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = this;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ADoorwayActor* DoorwayActor = GetWorld()->SpawnActor<ADoorwayActor>(DoorwayActorClass, WorldTransform, SpawnParams);
+	if (!DoorwayActor) return false;
+
+	DoorwayActor->InitializeDoorway(PlacedDoor.DoorData, PlacedDoor.Edge, PlacedDoor.bIsStandardDoorway);
+	SpawnedDoorwayActors.Add(DoorwayActor);
+	return true;
+}
+
+void ADungeonSpawner::DestroyDoorwayActors()
+{
+	for (ADoorwayActor* DoorwayActor : SpawnedDoorwayActors)
+	{
+		if (IsValid(DoorwayActor)) DoorwayActor->Destroy();
+	}
+	SpawnedDoorwayActors.Empty();
+}
+
+int32 ADungeonSpawner::SpawnAllDoorwayActors()
+{
+	if (!SpawnRoomResults.IsValid()) return 0;
+
+	int32 DoorwaysSpawned = 0;
+	for (const FDungeonRoomBuildResult& Result : *SpawnRoomResults)
+	{
+		if (!Result.Core.IsValid() || !Result.bSuccess) continue;
+		for (const FPlacedDoorwayInfo& PlacedDoor : Result.Core->GetPlacedDoorways())
+		{
+			if (SpawnDoorwayActor(PlacedDoor, Result.RoomOffset)) DoorwaysSpawned++;
+		}
+	}
+	return DoorwaysSpawned;
+}
+
+void ADungeonSpawner::CompleteDungeonSpawn()
+{
+	UE_LOG(LogTemp, Log, TEXT("ADungeonSpawner - Spawned %d instances across %d meshes and %d doorway actors, %.1f ms after the request (seed %d)"),
+		SpawnedInstanceCount, SpawnPalette.Num(), SpawnedDoorwayCount, (FPlatformTime::Seconds() - GenerationStartTime) * 1000.0, DungeonSeed);
+
+	const bool bSuccess = bSpawnSucceeded;
+	FOnDungeonSpawnComplete OnComplete = MoveTemp(PendingSpawnComplete);
+	PendingSpawnComplete.Unbind();
+	SpawnStage = ERoomSpawnStage::Done;
+	ResetSpawnState();
+
+	OnComplete.ExecuteIfBound(bSuccess);
+}
+
+void ADungeonSpawner::CancelTimeSlicedSpawn()
+{
+	if (SpawnStage == ERoomSpawnStage::Done) return;
+
+	if (UWorld* World = GetWorld())
+	{
+		if (URoomSpawnScheduler* Scheduler = World->GetSubsystem<URoomSpawnScheduler>()) Scheduler->Cancel(this);
+	}
+	SpawnStage = ERoomSpawnStage::Done;
+	ResetSpawnState();
+
+	FOnDungeonSpawnComplete OnComplete = MoveTemp(PendingSpawnComplete);
+	PendingSpawnComplete.Unbind();
+	OnComplete.ExecuteIfBound(false);
+}
+
+void ADungeonSpawner::AdvanceSpawnStage()
+{
+	SpawnStage = static_cast<ERoomSpawnStage>(static_cast<uint8>(SpawnStage) + 1);
+	bSpawnStageStarted = false;
+	SpawnMeshId = 0;
+	SpawnInstanceIndex = 0;
+	SpawnRoomIndex = 0;
+	SpawnDoorwayIndex = 0;
+}
+
+void ADungeonSpawner::ResetSpawnState()
+{
+	SpawnPalette.Reset();
+	for (FMeshInstanceBuffers& Instances : SpawnInstances) { Instances.Transforms.Empty(); }
+	SpawnRoomResults.Reset();
+}
+
+void ADungeonSpawner::ReleasePreloadedAssets()
+{
+	for (const TPair<URoomData*, URoomGenerator*>& Preloader : PreloadGenerators)
+	{
+		if (Preloader.Value) Preloader.Value->ReleasePreloadedAssets();
+	}
+	PreloadGenerators.Empty();
+}
+#pragma endregion
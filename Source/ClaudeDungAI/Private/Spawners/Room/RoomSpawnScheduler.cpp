@@ -0,0 +1,54 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Spawners/Room/RoomSpawnScheduler.h"
+#include "Spawners/Room/RoomSpawner.h"
+#include "Spawners/Dungeon/DungeonSpawner.h"
+
+void URoomSpawnScheduler::Enqueue(ARoomSpawner* Spawner)
+{
+	if (Spawner) Queue.AddUnique(Spawner);
+}
+
+void URoomSpawnScheduler::Enqueue(ADungeonSpawner* Spawner)
+{
+	if (Spawner) Queue.AddUnique(Spawner);
+}
+
+void URoomSpawnScheduler::Cancel(ARoomSpawner* Spawner)
+{
+	Queue.Remove(Spawner);
+}
+
+void URoomSpawnScheduler::Cancel(ADungeonSpawner* Spawner)
+{
+	Queue.Remove(Spawner);
+}
+
+bool URoomSpawnScheduler::IsQueued(const AActor* Spawner) const
+{
+	return Queue.ContainsByPredicate([Spawner](const TWeakObjectPtr<AActor>& Queued) { return Queued.Get() == Spawner; });
+}
+
+void URoomSpawnScheduler::Tick(float DeltaTime)
+{
+	const double Deadline = FPlatformTime::Seconds() + FrameBudgetMs * 0.001;
+
+	while (Queue.Num() > 0)
+	{
+		const TWeakObjectPtr<AActor> WeakSpawner = Queue[0];
+
+		bool bFinished = true;
+		if (ARoomSpawner* RoomSpawner = Cast<ARoomSpawner>(WeakSpawner.Get())) bFinished = RoomSpawner->SpawnNextBatch(Deadline);
+		else if (ADungeonSpawner* DungeonSpawner = Cast<ADungeonSpawner>(WeakSpawner.Get())) bFinished = DungeonSpawner->SpawnNextBatch(Deadline);
+
+		// Completion callbacks may cancel or enqueue spawners, so remove by value rather than by index
+		if (bFinished) Queue.Remove(WeakSpawner);
+
+		if (FPlatformTime::Seconds() >= Deadline) break;
+	}
+}
+
+TStatId URoomSpawnScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URoomSpawnScheduler, STATGROUP_Tickables);
+}
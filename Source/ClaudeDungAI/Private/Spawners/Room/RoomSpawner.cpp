@@ -1,6 +1,7 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Spawners/Room/RoomSpawner.h"
+#include "Spawners/Room/RoomSpawnScheduler.h"
 #include "Generators/Room/RoomGenerator.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/TextRenderComponent.h"
@@ -18,16 +19,26 @@ ARoomSpawner::ARoomSpawner()
 	// Create debug helpers component
 	DebugHelpers = CreateDefaultSubobject<UDebugHelpers>(TEXT("DebugHelpers"));
 
+#if WITH_EDITOR
 	// NEW: Bind delegate so DebugHelpers can request text components
 	DebugHelpers->OnCreateTextComponent.BindUObject(this, &ARoomSpawner::CreateTextRenderComponent);
 
 	// ✅ NEW: Bind destruction delegate
 	DebugHelpers->OnDestroyTextComponent. BindUObject(this, &ARoomSpawner::DestroyTextRenderComponent);
+#endif
 
 	DoorwayActorClass = ADoorwayActor::StaticClass();
 	
 	// Initialize flags
 	bIsGenerated = false;
+
+	SpawnStage = ERoomSpawnStage::Done;
+	bSpawnStageStarted = false;
+	SpawnMeshId = 0;
+	SpawnInstanceIndex = 0;
+	SpawnDoorwayIndex = 0;
+	SpawnUnitsDone = 0;
+	SpawnUnitsTotal = 0;
 }
 bool ARoomSpawner::EnsureGeneratorReady()
 {
@@ -50,8 +61,11 @@ bool ARoomSpawner::EnsureGeneratorReady()
 	// Initialize if needed
 	if (!RoomGenerator->IsInitialized())
 	{
-		DebugHelpers->LogVerbose(TEXT("Initializing RoomGenerator..."));
-		if (!RoomGenerator->Initialize(RoomData, RoomGridSize))
+		// Keep the rolled seed visible so a room can be reproduced
+		if (bUseRandomSeed) RoomSeed = FMath::Rand();
+
+		DebugHelpers->LogVerbose(FString::Printf(TEXT("Initializing RoomGenerator (Seed %d)..."), RoomSeed));
+		if (!RoomGenerator->Initialize(RoomData, RoomGridSize, RoomSeed))
 		{ DebugHelpers->LogCritical(TEXT("Failed to initialize RoomGenerator!")); return false;}
 
 		DebugHelpers->LogVerbose(TEXT("Creating grid cells..."));
@@ -60,6 +74,331 @@ bool ARoomSpawner::EnsureGeneratorReady()
 	return true;
 }
 
+void ARoomSpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (bGenerateOnBeginPlay)
+	{
+		GenerateRoomAsync(bUseRandomSeed ? FMath::Rand() : RoomSeed, FOnRoomSpawnComplete());
+	}
+}
+
+void ARoomSpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelTimeSlicedSpawn();
+
+	// Don't keep this room's meshes pinned once the actor is gone
+	if (RoomGenerator) RoomGenerator->ReleasePreloadedAssets();
+	Super::EndPlay(EndPlayReason);
+}
+
+#pragma region Runtime Generation
+bool ARoomSpawner::GenerateRoomAsync(int32 Seed, const FOnRoomSpawnComplete& OnComplete)
+{
+	if (!RoomData)
+	{ DebugHelpers->LogCritical(TEXT("GenerateRoomAsync - RoomData is not assigned!")); return false; }
+
+	if (RoomGridSize.X < 4 || RoomGridSize.Y < 4)
+	{ DebugHelpers->LogCritical(TEXT("GenerateRoomAsync - GridSize is too small (min 4x4)!")); return false; }
+
+	if (!RoomGenerator)
+	{
+		RoomGenerator = NewObject<URoomGenerator>(this, TEXT("RoomGenerator"));
+		if (!RoomGenerator)
+		{ DebugHelpers->LogCritical(TEXT("GenerateRoomAsync - Failed to create RoomGenerator!")); return false; }
+	}
+
+	if (RoomGenerator->IsGeneratingAsync())
+	{ DebugHelpers->LogImportant(TEXT("GenerateRoomAsync - Generation already in flight")); return false; }
+
+	// Queued spawn work reads the generator's current buffers, which the new layout replaces
+	CancelTimeSlicedSpawn();
+
+	// Keep the seed visible so the room can be reproduced in the editor
+	RoomSeed = Seed;
+	if (!RoomGenerator->Initialize(RoomData, RoomGridSize, RoomSeed))
+	{ DebugHelpers->LogCritical(TEXT("GenerateRoomAsync - Failed to initialize RoomGenerator!")); return false; }
+
+	// Instance buffers are packed on the worker, so the game thread only hands them to the ISM components
+	RoomGenerator->SetEmitInstanceBuffers(true);
+	return RoomGenerator->GenerateAllAsync(FOnRoomLayoutGenerated::CreateUObject(this, &ARoomSpawner::HandleRoomLayoutGenerated, OnComplete));
+}
+
+void ARoomSpawner::HandleRoomLayoutGenerated(bool bSuccess, FOnRoomSpawnComplete OnComplete)
+{
+	if (!bSuccess)
+	{
+		DebugHelpers->LogCritical(TEXT("GenerateRoomAsync - Room layout generation failed!"));
+		OnComplete.ExecuteIfBound(false);
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	URoomSpawnScheduler* Scheduler = bTimeSliceSpawning && World && World->IsGameWorld() ? World->GetSubsystem<URoomSpawnScheduler>() : nullptr;
+	if (Scheduler)
+	{
+		// Every instance and doorway actor is one unit of progress
+		SpawnUnitsTotal = RoomGenerator->GetPlacedDoorways().Num();
+		for (const FMeshInstanceBuffers* Buffers : { &RoomGenerator->GetFloorInstances(), &RoomGenerator->GetWallInstances(),
+			&RoomGenerator->GetCornerInstances(), &RoomGenerator->GetCeilingInstances() })
+		{
+			for (const TArray<FTransform>& Batch : Buffers->Transforms) { SpawnUnitsTotal += Batch.Num(); }
+		}
+
+		SpawnStage = ERoomSpawnStage::Floor;
+		bSpawnStageStarted = false;
+		SpawnMeshId = 0;
+		SpawnInstanceIndex = 0;
+		SpawnDoorwayIndex = 0;
+		SpawnUnitsDone = 0;
+		PendingSpawnComplete = OnComplete;
+		Scheduler->Enqueue(this);
+		return;
+	}
+
+	const FVector RoomOrigin = GetActorLocation();
+	const FRoomMeshPalette& Palette = RoomGenerator->GetMeshPalette();
+
+	int32 SpawnedCount = 0;
+	SpawnedCount += UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, Palette, RoomGenerator->GetFloorInstances(),
+		FloorMeshComponents, TEXT("FloorISM_"), RoomOrigin, bUseHierarchicalInstancing, FloorInstanceSettings);
+	SpawnedCount += UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, Palette, RoomGenerator->GetWallInstances(),
+		WallMeshComponents, TEXT("WallISM_"), RoomOrigin, bUseHierarchicalInstancing, WallInstanceSettings);
+	SpawnedCount += UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, Palette, RoomGenerator->GetCornerInstances(),
+		CornerMeshComponents, TEXT("CornerISM_"), RoomOrigin, bUseHierarchicalInstancing, CornerInstanceSettings);
+	SpawnedCount += UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, Palette, RoomGenerator->GetCeilingInstances(),
+		CeilingMeshComponents, TEXT("Ceiling_"), RoomOrigin, bUseHierarchicalInstancing, CeilingInstanceSettings);
+
+	DestroyDoorwayActors();
+	int32 DoorwaysSkipped = 0;
+	const int32 DoorwaysSpawned = SpawnDoorwayActors(DoorwaysSkipped);
+
+	DebugHelpers->LogImportant(FString::Printf(TEXT("GenerateRoomAsync - Spawned %d mesh instances, %d doorway actors (%d skipped)"),
+		SpawnedCount, DoorwaysSpawned, DoorwaysSkipped));
+	CompleteRoomSpawn(OnComplete);
+}
+
+void ARoomSpawner::CompleteRoomSpawn(FOnRoomSpawnComplete OnComplete)
+{
+	bIsGenerated = true;
+	DebugHelpers->LogImportant(FString::Printf(TEXT("GenerateRoomAsync - Room spawned (seed %d)"), RoomSeed));
+	OnComplete.ExecuteIfBound(true);
+}
+
+bool ARoomSpawner::IsGeneratingRoom() const
+{
+	return SpawnStage != ERoomSpawnStage::Done || (RoomGenerator && RoomGenerator->IsGeneratingAsync());
+}
+
+float ARoomSpawner::GetSpawnProgress() const
+{
+	if (SpawnStage == ERoomSpawnStage::Done) return 1.0f;
+	return SpawnUnitsTotal > 0 ? static_cast<float>(SpawnUnitsDone) / SpawnUnitsTotal : 0.0f;
+}
+
+void ARoomSpawner::CancelTimeSlicedSpawn()
+{
+	if (SpawnStage == ERoomSpawnStage::Done) return;
+
+	if (UWorld* World = GetWorld())
+	{
+		if (URoomSpawnScheduler* Scheduler = World->GetSubsystem<URoomSpawnScheduler>()) Scheduler->Cancel(this);
+	}
+	SpawnStage = ERoomSpawnStage::Done;
+
+	FOnRoomSpawnComplete OnComplete = MoveTemp(PendingSpawnComplete);
+	PendingSpawnComplete.Unbind();
+	OnComplete.ExecuteIfBound(false);
+}
+
+void ARoomSpawner::AdvanceSpawnStage()
+{
+	SpawnStage = static_cast<ERoomSpawnStage>(static_cast<uint8>(SpawnStage) + 1);
+	bSpawnStageStarted = false;
+	SpawnMeshId = 0;
+	SpawnInstanceIndex = 0;
+	SpawnDoorwayIndex = 0;
+}
+
+bool ARoomSpawner::SpawnNextBatch(double Deadline)
+{
+	if (SpawnStage == ERoomSpawnStage::Done) return true;
+	if (!RoomGenerator) { CancelTimeSlicedSpawn(); return true; }
+
+	const FVector RoomOrigin = GetActorLocation();
+	const FRoomMeshPalette& Palette = RoomGenerator->GetMeshPalette();
+	const int32 BatchSize = FMath::Max(SpawnBatchSize, 1);
+
+	// One batch of one mesh of a category; components of meshes the new layout dropped are released on stage entry
+	auto SpawnInstanceBatch = [&](const FMeshInstanceBuffers& Buffers, TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& Components,
+		const TCHAR* ComponentNamePrefix, const FISMCategorySettings& Settings)
+	{
+		if (!bSpawnStageStarted)
+		{
+			UDungeonSpawnerHelpers::ReleaseUnusedISMComponents(Palette, Buffers, Components, bUseHierarchicalInstancing);
+			bSpawnStageStarted = true;
+		}
+
+		while (Buffers.Transforms.IsValidIndex(SpawnMeshId) && Buffers.Transforms[SpawnMeshId].Num() == 0) { SpawnMeshId++; }
+		if (!Buffers.Transforms.IsValidIndex(SpawnMeshId)) { AdvanceSpawnStage(); return; }
+
+		const TArray<FTransform>& Batch = Buffers.Transforms[SpawnMeshId];
+		const TSoftObjectPtr<UStaticMesh>& MeshAsset = Palette.GetMesh(static_cast<FRoomMeshId>(SpawnMeshId));
+		const bool bKeptComponent = Components.Contains(MeshAsset);
+		UInstancedStaticMeshComponent* ISM = UDungeonSpawnerHelpers::GetOrCreateISMComponent(this, MeshAsset,
+			Components, ComponentNamePrefix, true, bUseHierarchicalInstancing, Settings);
+
+		// New components were configured on creation; kept ones pick up edited settings on their first batch
+		if (ISM && bKeptComponent && SpawnInstanceIndex == 0) UDungeonSpawnerHelpers::ApplyISMCategorySettings(ISM, Settings);
+
+		// A mesh that failed to load is skipped whole
+		const int32 Written = ISM
+			? UDungeonSpawnerHelpers::UpdateMeshInstanceRange(ISM, Batch, SpawnInstanceIndex, BatchSize, RoomOrigin)
+			: Batch.Num() - SpawnInstanceIndex;
+		SpawnInstanceIndex += Written;
+		SpawnUnitsDone += Written;
+
+		if (SpawnInstanceIndex >= Batch.Num())
+		{
+			UDungeonSpawnerHelpers::TrimMeshInstances(ISM, Batch.Num());
+			SpawnMeshId++;
+			SpawnInstanceIndex = 0;
+		}
+	};
+
+	do
+	{
+		switch (SpawnStage)
+		{
+		case ERoomSpawnStage::Floor:
+			SpawnInstanceBatch(RoomGenerator->GetFloorInstances(), FloorMeshComponents, TEXT("FloorISM_"), FloorInstanceSettings);
+			break;
+		case ERoomSpawnStage::Walls:
+			SpawnInstanceBatch(RoomGenerator->GetWallInstances(), WallMeshComponents, TEXT("WallISM_"), WallInstanceSettings);
+			break;
+		case ERoomSpawnStage::Doorways:
+		{
+			if (!bSpawnStageStarted) { DestroyDoorwayActors(); bSpawnStageStarted = true; }
+
+			const TArray<FPlacedDoorwayInfo>& Doorways = RoomGenerator->GetPlacedDoorways();
+			if (SpawnDoorwayIndex < Doorways.Num())
+			{
+				SpawnDoorwayActor(Doorways[SpawnDoorwayIndex++]);
+				SpawnUnitsDone++;
+			}
+			else AdvanceSpawnStage();
+			break;
+		}
+		case ERoomSpawnStage::Corners:
+			SpawnInstanceBatch(RoomGenerator->GetCornerInstances(), CornerMeshComponents, TEXT("CornerISM_"), CornerInstanceSettings);
+			break;
+		case ERoomSpawnStage::Ceiling:
+			SpawnInstanceBatch(RoomGenerator->GetCeilingInstances(), CeilingMeshComponents, TEXT("Ceiling_"), CeilingInstanceSettings);
+			break;
+		default:
+			break;
+		}
+	}
+	while (SpawnStage != ERoomSpawnStage::Done && FPlatformTime::Seconds() < Deadline);
+
+	OnSpawnProgress.Broadcast(GetSpawnProgress());
+	if (SpawnStage != ERoomSpawnStage::Done) return false;
+
+	FOnRoomSpawnComplete OnComplete = MoveTemp(PendingSpawnComplete);
+	PendingSpawnComplete.Unbind();
+	CompleteRoomSpawn(OnComplete);
+	return true;
+}
+#pragma endregion
+
+#pragma region Doorway Actors
+int32 ARoomSpawner::SpawnDoorwayActors(int32& OutSkipped)
+{
+    OutSkipped = 0;
+    if (!RoomGenerator) return 0;
+
+    // Validate doorway actor class
+    if (! DoorwayActorClass)
+    {
+        DebugHelpers->LogCritical(TEXT("DoorwayActorClass is not set!"));
+        return 0;
+    }
+
+    int32 DoorwaysSpawned = 0;
+
+    for (const FPlacedDoorwayInfo& PlacedDoor : RoomGenerator->GetPlacedDoorways())
+    {
+        if (SpawnDoorwayActor(PlacedDoor)) DoorwaysSpawned++;
+        else OutSkipped++;
+    }
+
+    return DoorwaysSpawned;
+}
+
+bool ARoomSpawner::SpawnDoorwayActor(const FPlacedDoorwayInfo& PlacedDoor)
+{
+    // Validate doorway actor class and door data
+    if (!DoorwayActorClass) return false;
+    if (!PlacedDoor.DoorData)
+    {
+        DebugHelpers->LogVerbose(TEXT("  Doorway has null DoorData - skipping"));
+        return false;
+    }
+
+    // Calculate world transform (room space → world space)
+    FTransform WorldTransform = PlacedDoor. FrameTransform;
+    WorldTransform.AddToTranslation(GetActorLocation());
+
+    // Spawn parameters
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Owner = this;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    // Spawn doorway actor
+    ADoorwayActor* DoorwayActor = GetWorld()->SpawnActor<ADoorwayActor>(
+        DoorwayActorClass,
+        WorldTransform,
+        SpawnParams
+    );
+
+    if (!DoorwayActor)
+    {
+        DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn doorway on edge %s"),
+            *UEnum::GetValueAsString(PlacedDoor.Edge)));
+        return false;
+    }
+
+    // Initialize doorway with configuration
+    DoorwayActor->InitializeDoorway(
+        PlacedDoor.DoorData,
+        PlacedDoor.Edge,
+        PlacedDoor.bIsStandardDoorway
+    );
+
+    // Store reference
+    SpawnedDoorwayActors.Add(DoorwayActor);
+
+    FString DoorType = PlacedDoor.bIsStandardDoorway ? TEXT("Standard") : TEXT("Manual");
+    DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned %s doorway on edge %s"),
+        *DoorType, *UEnum::GetValueAsString(PlacedDoor.Edge)));
+    return true;
+}
+
+void ARoomSpawner::DestroyDoorwayActors()
+{
+	for (ADoorwayActor* DoorwayActor : SpawnedDoorwayActors)
+	{
+		if (IsValid(DoorwayActor))
+		{
+			DoorwayActor->Destroy();
+		}
+	}
+
+	SpawnedDoorwayActors.Empty();
+}
+#pragma endregion
+
 #if WITH_EDITOR
 #pragma region In Editor Functions
 
@@ -155,13 +494,15 @@ void ARoomSpawner::GenerateFloorMeshes()
 		return;
 	}
 	
-	// CLEANUP: Clear existing floor meshes
-	ClearFloorMeshes();
+	// CLEANUP: Reset floor layout only; ISM components are kept and updated in place below
+	RoomGenerator->ClearPlacedFloorMeshes();
+	RoomGenerator->ResetGridCellStates();
 	
 	// Generate Floor Layout
 	DebugHelpers->LogImportant(TEXT("Generating floor layout..."));
 	if (! RoomGenerator->GenerateFloor())
 	{
+		ClearFloorMeshes();
 		DebugHelpers->LogCritical(TEXT("Floor generation failed!"));
 		DebugHelpers->LogSectionHeader(TEXT("GENERATE FLOOR MESHES"));
 		return;
@@ -174,32 +515,17 @@ void ARoomSpawner::GenerateFloorMeshes()
 	// Get room origin for world space conversion
 	FVector RoomOrigin = GetActorLocation();
 	
-	// SPAWNING: Create ISM components and add instances
-	for (const FPlacedMeshInfo& PlacedMesh : PlacedMeshes)
+	// SPAWNING: Per-mesh transform arrays from the generator, rewritten into each ISM component in place
+	const int32 SpawnedCount = UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, RoomGenerator->GetMeshPalette(),
+	RoomGenerator->GetFloorInstances(), FloorMeshComponents, TEXT("FloorISM_"), RoomOrigin,
+	bUseHierarchicalInstancing, FloorInstanceSettings);
+	if (SpawnedCount < PlacedMeshes.Num())
 	{
-		// Get or create ISM component for this mesh
-		UInstancedStaticMeshComponent* ISM = UDungeonSpawnerHelpers::GetOrCreateISMComponent(this,
-		PlacedMesh.MeshInfo.MeshAsset,FloorMeshComponents,TEXT("FloorISM_"),true);
-
-		if (ISM)
-		{
-			int32 InstanceIndex = UDungeonSpawnerHelpers:: SpawnMeshInstance( ISM, PlacedMesh.WorldTransform, RoomOrigin);
-
-			if (InstanceIndex >= 0)
-			{
-				DebugHelpers->LogVerbose(FString::Printf( TEXT("  Spawned floor mesh at grid position (%d, %d), instance %d"),
-				PlacedMesh.GridPosition.X, PlacedMesh. GridPosition.Y, InstanceIndex));
-			}
-			else
-			{
-				DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn floor mesh at grid position (%d, %d)"),
-				PlacedMesh.GridPosition.X, PlacedMesh.GridPosition.Y));
-			}
-		}
+		DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn %d floor meshes (mesh failed to load)"), PlacedMeshes.Num() - SpawnedCount));
 	}
 	
 	DebugHelpers->LogImportant(FString::Printf(TEXT("Floor meshes generated: %d instances across %d unique meshes"),
-	PlacedMeshes.Num(),	FloorMeshComponents.Num())); DebugHelpers->LogSectionHeader(TEXT("GENERATE FLOOR MESHES"));
+	SpawnedCount, FloorMeshComponents.Num())); DebugHelpers->LogSectionHeader(TEXT("GENERATE FLOOR MESHES"));
 }
 
 void ARoomSpawner::ClearFloorMeshes()
@@ -232,13 +558,14 @@ void ARoomSpawner::GenerateWallMeshes()
 		return;
 	}
 	
-	// Clear existing wall meshes
-	ClearWallMeshes();
+	// Reset wall layout only; ISM components are kept and updated in place below
+	RoomGenerator->ClearPlacedWalls();
 	
 	// Generate wall layout (logic only)
 	DebugHelpers->LogImportant(TEXT("Generating wall layout..."));
 	if (! RoomGenerator->GenerateWalls())
 	{
+		ClearWallMeshes();
 		DebugHelpers->LogCritical(TEXT("Wall generation failed!"));
 		DebugHelpers->LogSectionHeader(TEXT("GENERATE WALL MESHES"));
 		return;
@@ -251,86 +578,16 @@ void ARoomSpawner::GenerateWallMeshes()
 	// Get room origin for world space conversion
 	FVector RoomOrigin = GetActorLocation();
 	
-	// Spawn wall segments
-	for (const FPlacedWallInfo& PlacedWall : PlacedWalls) { SpawnWallSegment(PlacedWall, RoomOrigin);}
+	// Every layer of every segment arrives grouped by mesh; each group is spawned in one call
+	const int32 SpawnedCount = UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, RoomGenerator->GetMeshPalette(),
+	RoomGenerator->GetWallInstances(), WallMeshComponents, TEXT("WallISM_"), RoomOrigin,
+	bUseHierarchicalInstancing, WallInstanceSettings);
 	
-	DebugHelpers->LogImportant(TEXT("Wall meshes generated successfully!"));
+	DebugHelpers->LogImportant(FString::Printf(TEXT("Wall meshes generated successfully! (%d instances across %d unique meshes)"),
+	SpawnedCount, WallMeshComponents.Num()));
 	DebugHelpers->LogSectionHeader(TEXT("GENERATE WALL MESHES"));
 }
 
-void ARoomSpawner::SpawnWallSegment(const FPlacedWallInfo& PlacedWall, const FVector& RoomOrigin)
-{
-	// SPAWN BOTTOM MESH (Required - Base Layer)
-	UInstancedStaticMeshComponent* BottomISM = UDungeonSpawnerHelpers::GetOrCreateISMComponent(this,
-	PlacedWall.WallModule.BaseMesh,WallMeshComponents,TEXT("WallISM_"), true);
-
-	if (BottomISM)
-	{
-		// Wall uses BottomTransform (check your FPlacedWallInfo struct)
-		int32 InstanceIndex = UDungeonSpawnerHelpers::SpawnMeshInstance( BottomISM, PlacedWall.BottomTransform, RoomOrigin);
-
-		if (InstanceIndex >= 0)
-		{
-			DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned base mesh at edge %d, cell %d (instance %d)"), 
-			(int32)PlacedWall.Edge, PlacedWall.StartCell, InstanceIndex));
-		}
-	}
-	
-	// SPAWN MIDDLE1 MESH (Optional - First Middle Layer)
-	if (! PlacedWall.WallModule.MiddleMesh1. IsNull())
-	{
-		UInstancedStaticMeshComponent* Middle1ISM = UDungeonSpawnerHelpers::GetOrCreateISMComponent( this,
-		PlacedWall.WallModule.MiddleMesh1, WallMeshComponents, TEXT("WallISM_"), true);
-
-		if (Middle1ISM)
-		{
-			int32 InstanceIndex = UDungeonSpawnerHelpers:: SpawnMeshInstance( Middle1ISM, PlacedWall.Middle1Transform, RoomOrigin);
-
-			if (InstanceIndex >= 0)
-			{
-				DebugHelpers->LogVerbose(FString::Printf( TEXT("  Spawned middle1 mesh at edge %d, cell %d (instance %d)"), 
-				(int32)PlacedWall.Edge, PlacedWall.StartCell, InstanceIndex));
-			}
-		}
-	}
-
-	// SPAWN MIDDLE2 MESH (Optional - Second Middle Layer)
-	if (!PlacedWall.WallModule. MiddleMesh2.IsNull())
-	{
-		UInstancedStaticMeshComponent* Middle2ISM = UDungeonSpawnerHelpers::GetOrCreateISMComponent( this,
-		PlacedWall.WallModule.MiddleMesh2, WallMeshComponents, TEXT("WallISM_"), true);
-
-		if (Middle2ISM)
-		{
-			int32 InstanceIndex = UDungeonSpawnerHelpers::SpawnMeshInstance( Middle2ISM, PlacedWall.Middle2Transform, RoomOrigin);
-
-			if (InstanceIndex >= 0)
-			{
-				DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned middle2 mesh at edge %d, cell %d (instance %d)"), 
-				(int32)PlacedWall.Edge, PlacedWall. StartCell, InstanceIndex));
-			}
-		}
-	}
-	
-	// SPAWN TOP MESH (Optional - Top Layer/Cap)
-	if (!PlacedWall.WallModule.TopMesh.IsNull())
-	{
-		UInstancedStaticMeshComponent* TopISM = UDungeonSpawnerHelpers:: GetOrCreateISMComponent( this,
-		PlacedWall.WallModule.TopMesh, WallMeshComponents, TEXT("WallISM_"), true);
-
-		if (TopISM)
-		{
-			int32 InstanceIndex = UDungeonSpawnerHelpers::SpawnMeshInstance( TopISM, PlacedWall.TopTransform, RoomOrigin);
-
-			if (InstanceIndex >= 0)
-			{
-				DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned top mesh at edge %d, cell %d (instance %d)"), 
-				(int32)PlacedWall.Edge, PlacedWall.StartCell, InstanceIndex));
-			}
-		}
-	}
-}
-
 void ARoomSpawner::ClearWallMeshes()
 {
 	// Clear all wall ISM components
@@ -354,13 +611,14 @@ void ARoomSpawner::GenerateCornerMeshes()
         return;
     }
 
-    // Clear existing corners
-    ClearCornerMeshes();
+    // Reset corner layout only; ISM components are kept and updated in place below
+    RoomGenerator->ClearPlacedCorners();
 
     // Generate corner layout (logic only)
     DebugHelpers->LogImportant(TEXT("Generating corner layout..."));
     if (!RoomGenerator->GenerateCorners())
     {
+        ClearCornerMeshes();
         DebugHelpers->LogCritical(TEXT("Corner generation failed!"));
         DebugHelpers->LogSectionHeader(TEXT("GENERATE CORNER MESHES"));
         return;
@@ -371,6 +629,7 @@ void ARoomSpawner::GenerateCornerMeshes()
     
     if (PlacedCorners.Num() == 0)
     {
+        UDungeonSpawnerHelpers::ClearISMComponentMap(CornerMeshComponents);
         DebugHelpers->LogImportant(TEXT("No corners to spawn (no corner mesh assigned)"));
         DebugHelpers->LogSectionHeader(TEXT("GENERATE CORNER MESHES"));
         return;
@@ -381,37 +640,13 @@ void ARoomSpawner::GenerateCornerMeshes()
     // Get room origin for world space conversion
     FVector RoomOrigin = GetActorLocation();
 
-    // Spawn corner meshes
-    for (const FPlacedCornerInfo& PlacedCorner : PlacedCorners)
+    // Grouped by mesh (usually all four share one); rewrite each ISM component's instances in place
+    const int32 SpawnedCount = UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, RoomGenerator->GetMeshPalette(),
+        RoomGenerator->GetCornerInstances(), CornerMeshComponents, TEXT("CornerISM_"), RoomOrigin,
+        bUseHierarchicalInstancing, CornerInstanceSettings);
+    if (SpawnedCount < PlacedCorners.Num())
     {
-        // Get or create ISM component for corner mesh
-        UInstancedStaticMeshComponent* ISM = UDungeonSpawnerHelpers::GetOrCreateISMComponent(
-            this,
-            PlacedCorner. CornerMesh,
-            CornerMeshComponents,
-            TEXT("CornerISM_"),
-            true
-        );
-
-        if (ISM)
-        {
-            int32 InstanceIndex = UDungeonSpawnerHelpers::SpawnMeshInstance(
-                ISM,
-                PlacedCorner. Transform,
-                RoomOrigin
-            );
-
-            if (InstanceIndex >= 0)
-            {
-                DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned %s corner (instance %d)"),
-                    *UEnum::GetValueAsString(PlacedCorner.Corner), InstanceIndex));
-            }
-            else
-            {
-                DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn %s corner"),
-                    *UEnum::GetValueAsString(PlacedCorner. Corner)));
-            }
-        }
+        DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn %d corners"), PlacedCorners.Num() - SpawnedCount));
     }
 
     DebugHelpers->LogImportant(TEXT("Corner meshes generated successfully!"));
@@ -470,74 +705,8 @@ void ARoomSpawner::GenerateDoorwayMeshes()
 
     DebugHelpers->LogImportant(FString::Printf(TEXT("Spawning %d doorway actors... "), FinalDoorways.Num()));
 
-    // Validate doorway actor class
-    if (! DoorwayActorClass)
-    {
-        DebugHelpers->LogCritical(TEXT("DoorwayActorClass is not set!"));
-        DebugHelpers->LogSectionHeader(TEXT("GENERATE DOORWAY MESHES"));
-        return;
-    }
-
-    // Get room origin for world space positioning
-    FVector RoomOrigin = GetActorLocation();
-
-    int32 DoorwaysSpawned = 0;
     int32 DoorwaysSkipped = 0;
-
-    // ========================================================================
-    // SPAWN DOORWAY ACTORS
-    // ========================================================================
-
-    for (const FPlacedDoorwayInfo& PlacedDoor : FinalDoorways)
-    {
-        // Validate door data
-        if (!PlacedDoor.DoorData)
-        {
-            DebugHelpers->LogVerbose(TEXT("  Doorway has null DoorData - skipping"));
-            DoorwaysSkipped++;
-            continue;
-        }
-
-        // Calculate world transform (room space → world space)
-        FTransform WorldTransform = PlacedDoor. FrameTransform;
-        WorldTransform.AddToTranslation(RoomOrigin);
-
-        // Spawn parameters
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.Owner = this;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-        // Spawn doorway actor
-        ADoorwayActor* DoorwayActor = GetWorld()->SpawnActor<ADoorwayActor>(
-            DoorwayActorClass,
-            WorldTransform,
-            SpawnParams
-        );
-
-        if (DoorwayActor)
-        {
-            // Initialize doorway with configuration
-            DoorwayActor->InitializeDoorway(
-                PlacedDoor.DoorData,
-                PlacedDoor.Edge,
-                PlacedDoor.bIsStandardDoorway
-            );
-
-            // Store reference
-            SpawnedDoorwayActors.Add(DoorwayActor);
-            DoorwaysSpawned++;
-
-            FString DoorType = PlacedDoor.bIsStandardDoorway ? TEXT("Standard") : TEXT("Manual");
-            DebugHelpers->LogVerbose(FString::Printf(TEXT("  Spawned %s doorway on edge %s"),
-                *DoorType, *UEnum::GetValueAsString(PlacedDoor.Edge)));
-        }
-        else
-        {
-            DebugHelpers->LogVerbose(FString::Printf(TEXT("  Failed to spawn doorway on edge %s"),
-                *UEnum::GetValueAsString(PlacedDoor.Edge)));
-            DoorwaysSkipped++;
-        }
-    }
+    const int32 DoorwaysSpawned = SpawnDoorwayActors(DoorwaysSkipped);
 
     DebugHelpers->LogImportant(FString::Printf(TEXT("Doorway spawning complete:  %d actors spawned, %d skipped"),
         DoorwaysSpawned, DoorwaysSkipped));
@@ -547,16 +716,7 @@ void ARoomSpawner::GenerateDoorwayMeshes()
 void ARoomSpawner::ClearDoorwayMeshes()
 {
 	// ✅ CHANGED:  Destroy spawned doorway actors instead of clearing ISM components
-    
-	for (ADoorwayActor* DoorwayActor : SpawnedDoorwayActors)
-	{
-		if (IsValid(DoorwayActor))
-		{
-			DoorwayActor->Destroy();
-		}
-	}
-
-	SpawnedDoorwayActors.Empty();
+	DestroyDoorwayActors();
 	
 	// Layout is cached and persists until ClearRoomGrid()
 	// Transforms will be recalculated with current offsets on next spawn
@@ -577,14 +737,13 @@ void ARoomSpawner::GenerateCeilingMeshes()
         return;
     }
 
-    // Clear existing ceiling meshes
-    ClearCeilingMeshes();
-
+    // Existing ceiling components are kept and updated in place below
     DebugHelpers->LogImportant(TEXT("Generating ceiling layout..."));
 
     // Generate ceiling layout in RoomGenerator
     if (! RoomGenerator->GenerateCeiling())
     {
+        ClearCeilingMeshes();
         DebugHelpers->LogCritical(TEXT("Ceiling generation failed!"));
         DebugHelpers->LogSectionHeader(TEXT("GENERATE CEILING MESHES"));
         return;
@@ -595,6 +754,7 @@ void ARoomSpawner::GenerateCeilingMeshes()
 
     if (PlacedTiles. Num() == 0)
     {
+        ClearCeilingMeshes();
         DebugHelpers->LogImportant(TEXT("No ceiling tiles to spawn"));
         DebugHelpers->LogSectionHeader(TEXT("GENERATE CEILING MESHES"));
         return;
@@ -605,54 +765,12 @@ void ARoomSpawner::GenerateCeilingMeshes()
     // Get room origin for world space
     FVector RoomOrigin = GetActorLocation();
 
-    int32 TilesSpawned = 0;
-    int32 TilesSkipped = 0;
-
-    // Spawn each ceiling tile
-    for (const FPlacedCeilingInfo& PlacedTile : PlacedTiles)
-    {
-        // Load mesh
-        UStaticMesh* Mesh = PlacedTile.Mesh. LoadSynchronous();
-        if (!Mesh)
-        {
-            TilesSkipped++;
-            continue;
-        }
-
-        // ✅ FIXED:    Use PlacedTile.Transform directly (it's already component-space)
-        // Don't modify it - let the helper handle world space conversion
-        
-        // Get or create ISM component
-        UInstancedStaticMeshComponent* ISM = UDungeonSpawnerHelpers:: GetOrCreateISMComponent(
-            this,
-            PlacedTile.Mesh,
-            CeilingMeshComponents,
-            TEXT("Ceiling_"),
-            true
-        );
-
-        if (ISM)
-        {
-            // ✅ FIXED:   Pass transform and origin separately (like floors do)
-            int32 InstanceIndex = UDungeonSpawnerHelpers:: SpawnMeshInstance(
-                ISM, 
-                PlacedTile.Transform,  // ← Component-space (includes rotation)
-                RoomOrigin);            // ← Helper adds this to position
-
-            if (InstanceIndex >= 0)
-            {
-                TilesSpawned++;
-            }
-            else
-            {
-                TilesSkipped++;
-            }
-        }
-        else
-        {
-            TilesSkipped++;
-        }
-    }
+    // Grouped by mesh in component space; the helper adds the room origin
+    // Components are reused across regenerations, only meshes that dropped out lose theirs
+    const int32 TilesSpawned = UDungeonSpawnerHelpers::SyncMeshInstanceBatches(this, RoomGenerator->GetMeshPalette(),
+        RoomGenerator->GetCeilingInstances(), CeilingMeshComponents, TEXT("Ceiling_"), RoomOrigin,
+        bUseHierarchicalInstancing, CeilingInstanceSettings);
+    const int32 TilesSkipped = PlacedTiles.Num() - TilesSpawned;
 
     DebugHelpers->LogImportant(FString::Printf(TEXT("Ceiling generation complete:   %d tiles spawned, %d skipped"),
         TilesSpawned, TilesSkipped));
@@ -3,6 +3,11 @@
 #include "Utilities/Helpers/DungeonGenerationHelpers.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshSocket.h"
+#include "Data/Room/WallData.h"
+#include "Data/Room/RoomData.h"
+#include "Data/Room/FloorData.h"
+#include "Data/Room/DoorData.h"
+#include "Data/Room/CeilingData.h"
 
 // ========================================================================
 // GRID & CELL OPERATIONS
@@ -10,35 +15,37 @@
 
 TArray<FIntPoint> UDungeonGenerationHelpers::GetEdgeCellIndices(EWallEdge Edge, FIntPoint GridSize)
 {
+	const int32 EdgeLength = GetEdgeLength(Edge, GridSize);
+
 	TArray<FIntPoint> Cells;
+	Cells.Reserve(EdgeLength);
+	for (int32 Index = 0; Index < EdgeLength; ++Index) { Cells.Add(GetEdgeCell(Edge, Index, GridSize)); }
+    
+	return Cells;
+}
 
+int32 UDungeonGenerationHelpers::GetEdgeLength(EWallEdge Edge, FIntPoint GridSize)
+{
 	switch (Edge)
 	{
-	case EWallEdge::North:   // North = +X direction, X = GridSize (beyond max)
-		for (int32 Y = 0; Y < GridSize.Y; ++Y)
-			Cells.Add(FIntPoint(GridSize.X, Y));
-		break;
-        
-	case EWallEdge:: South:  // South = -X direction, X = -1 (before min)
-		for (int32 Y = 0; Y < GridSize.Y; ++Y)
-			Cells.Add(FIntPoint(-1, Y));
-		break;
-        
-	case EWallEdge::East:   // East = +Y direction, Y = GridSize (beyond max)
-		for (int32 X = 0; X < GridSize.X; ++X)
-			Cells.Add(FIntPoint(X, GridSize.Y));
-		break;
-        
-	case EWallEdge:: West:   // West = -Y direction, Y = -1 (before min)
-		for (int32 X = 0; X < GridSize.X; ++X)
-			Cells.Add(FIntPoint(X, -1));
-		break;
-            
-	default: 
-		break;
+	case EWallEdge::North:
+	case EWallEdge::South: return FMath::Max(GridSize.Y, 0);
+	case EWallEdge::East:
+	case EWallEdge::West:  return FMath::Max(GridSize.X, 0);
+	default:               return 0;
+	}
+}
+
+FIntPoint UDungeonGenerationHelpers::GetEdgeCell(EWallEdge Edge, int32 Index, FIntPoint GridSize)
+{
+	switch (Edge)
+	{
+	case EWallEdge::North: return FIntPoint(GridSize.X, Index); // North = +X direction, X = GridSize (beyond max)
+	case EWallEdge::South: return FIntPoint(-1, Index);         // South = -X direction, X = -1 (before min)
+	case EWallEdge::East:  return FIntPoint(Index, GridSize.Y); // East = +Y direction, Y = GridSize (beyond max)
+	case EWallEdge::West:  return FIntPoint(Index, -1);         // West = -Y direction, Y = -1 (before min)
+	default:               return FIntPoint::ZeroValue;
 	}
-    
-	return Cells;
 }
 
 bool UDungeonGenerationHelpers::IsValidGridCoordinate(FIntPoint Coord, FIntPoint GridSize)
@@ -234,6 +241,135 @@ UStaticMesh* UDungeonGenerationHelpers::LoadAndValidateMesh(
 	return Mesh;
 }
 
+// ========================================================================
+// ASSET PRELOADING
+// ========================================================================
+
+void UDungeonGenerationHelpers::CollectRoomStyleAssetPaths(const URoomData* RoomData, TArray<FSoftObjectPath>& OutPaths)
+{
+	if (!RoomData) return;
+
+	TSet<FSoftObjectPath> Seen(OutPaths);
+	auto AddPath = [&OutPaths, &Seen](const auto& Asset)
+	{
+		if (Asset.IsNull()) return;
+		const FSoftObjectPath Path = Asset.ToSoftObjectPath();
+		if (!Seen.Contains(Path)) { Seen.Add(Path); OutPaths.Add(Path); }
+	};
+
+	AddPath(RoomData->FloorStyleData);
+	AddPath(RoomData->WallStyleData);
+	AddPath(RoomData->DoorStyleData);
+	AddPath(RoomData->CeilingStyleData);
+
+	if (!RoomData->bUsePresetLayout) return;
+	AddPath(RoomData->PresetLayout);
+
+	if (const URoomPreset* Preset = RoomData->PresetLayout.Get())
+	{
+		AddPath(Preset->DefaultFloorStyle);
+		AddPath(Preset->DefaultCeilingStyle);
+		for (const FPresetRegion& Region : Preset->Regions)
+		{
+			AddPath(Region.RegionFloorStyle);
+			AddPath(Region.RegionCeilingStyle);
+			AddPath(Region.RegionWallStyle);
+		}
+	}
+}
+
+void UDungeonGenerationHelpers::CollectRoomMeshPaths(const URoomData* RoomData, TArray<FSoftObjectPath>& OutPaths)
+{
+	if (!RoomData) return;
+
+	TSet<FSoftObjectPath> Seen(OutPaths);
+	auto AddPath = [&OutPaths, &Seen](const TSoftObjectPtr<UStaticMesh>& Mesh)
+	{
+		if (Mesh.IsNull()) return;
+		const FSoftObjectPath Path = Mesh.ToSoftObjectPath();
+		if (!Seen.Contains(Path)) { Seen.Add(Path); OutPaths.Add(Path); }
+	};
+
+	auto AddModule = [&AddPath](const FWallModule& Module)
+	{
+		AddPath(Module.BaseMesh);
+		AddPath(Module.MiddleMesh1);
+		AddPath(Module.MiddleMesh2);
+		AddPath(Module.TopMesh);
+	};
+
+	auto AddFloorStyle = [&AddPath](const UFloorData* FloorData)
+	{
+		if (!FloorData) return;
+		for (const FMeshPlacementInfo& Info : FloorData->FloorTilePool) { AddPath(Info.MeshAsset); }
+		for (const FMeshPlacementInfo& Info : FloorData->ClutterMeshPool) { AddPath(Info.MeshAsset); }
+	};
+
+	auto AddCeilingStyle = [&AddPath](const UCeilingData* CeilingData)
+	{
+		if (!CeilingData) return;
+		for (const FCeilingTile& Tile : CeilingData->LargeTilePool) { AddPath(Tile.Mesh); }
+		for (const FCeilingTile& Tile : CeilingData->MediumTilePool) { AddPath(Tile.Mesh); }
+		for (const FCeilingTile& Tile : CeilingData->SmallTilePool) { AddPath(Tile.Mesh); }
+	};
+
+	auto AddWallStyle = [&AddPath, &AddModule](const UWallData* WallData)
+	{
+		if (!WallData) return;
+		for (const FWallModule& Module : WallData->AvailableWallModules) { AddModule(Module); }
+		AddPath(WallData->DefaultCornerMesh);
+		AddPath(WallData->WallColumnMesh);
+	};
+
+	// STYLE ASSETS
+	AddFloorStyle(RoomData->FloorStyleData.Get());
+	AddWallStyle(RoomData->WallStyleData.Get());
+	AddCeilingStyle(RoomData->CeilingStyleData.Get());
+
+	if (RoomData->bUsePresetLayout)
+	{
+		if (const URoomPreset* Preset = RoomData->PresetLayout.Get())
+		{
+			AddFloorStyle(Preset->DefaultFloorStyle.Get());
+			AddCeilingStyle(Preset->DefaultCeilingStyle.Get());
+			for (const FPresetRegion& Region : Preset->Regions)
+			{
+				AddFloorStyle(Region.RegionFloorStyle.Get());
+				AddCeilingStyle(Region.RegionCeilingStyle.Get());
+				AddWallStyle(Region.RegionWallStyle.Get());
+			}
+		}
+	}
+
+	// DESIGNER OVERRIDES
+	for (const TPair<FIntPoint, FMeshPlacementInfo>& Forced : RoomData->ForcedFloorPlacements) { AddPath(Forced.Value.MeshAsset); }
+	for (const FForcedWallPlacement& Forced : RoomData->ForcedWallPlacements) { AddModule(Forced.WallModule); }
+	for (const FForcedCeilingPlacement& Forced : RoomData->ForcedCeilingPlacements) { AddPath(Forced.TileInfo.Mesh); }
+	for (const FMeshPlacementInfo& Info : RoomData->InteriorMeshPool) { AddPath(Info.MeshAsset); }
+
+	// DOORS (style pools can nest, so walk them breadth-first and visit each once)
+	TArray<const UDoorData*> PendingDoors;
+	TSet<const UDoorData*> VisitedDoors;
+	PendingDoors.Add(RoomData->DoorStyleData.Get());
+	PendingDoors.Add(RoomData->DefaultDoorData);
+	for (const FFixedDoorLocation& ForcedDoor : RoomData->ForcedDoorways) { PendingDoors.Add(ForcedDoor.DoorData); }
+
+	for (int32 i = 0; i < PendingDoors.Num(); ++i)
+	{
+		const UDoorData* DoorData = PendingDoors[i];
+		if (!DoorData || VisitedDoors.Contains(DoorData)) continue;
+		VisitedDoors.Add(DoorData);
+
+		AddPath(DoorData->FrameSideMesh);
+		AddPath(DoorData->LeftSideMesh);
+		AddPath(DoorData->RightSideMesh);
+		AddPath(DoorData->CornerMesh);
+		for (const FWallModule& Module : DoorData->LeftSideModules) { AddModule(Module); }
+		for (const FWallModule& Module : DoorData->RightSideModules) { AddModule(Module); }
+		PendingDoors.Append(DoorData->DoorStylePool);
+	}
+}
+
 // ========================================================================
 // SOCKET OPERATIONS
 // ========================================================================
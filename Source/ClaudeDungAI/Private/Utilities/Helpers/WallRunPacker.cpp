@@ -0,0 +1,81 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Utilities/Helpers/WallRunPacker.h"
+
+void FWallRunPacker::Build(TConstArrayView<int32> InFootprints)
+{
+	Reset();
+
+	for (const int32 Footprint : InFootprints)
+	{
+		if (Footprint > 0) Footprints.AddUnique(Footprint);
+	}
+	Footprints.Sort(TGreater<int32>());
+}
+
+void FWallRunPacker::Reset()
+{
+	Footprints.Reset();
+	Holes.Reset();
+	Pieces.Reset();
+	Choice.Reset();
+}
+
+void FWallRunPacker::EnsureLength(int32 MaxLength)
+{
+	// Length 0 is the empty packing
+	if (Choice.Num() == 0)
+	{
+		Holes.Add(0);
+		Pieces.Add(0);
+		Choice.Add(0);
+	}
+
+	for (int32 Length = Choice.Num(); Length <= MaxLength; ++Length)
+	{
+		// Leaving the first cell uncovered is always possible
+		int32 BestHoles = Holes[Length - 1] + 1;
+		int32 BestPieces = Pieces[Length - 1];
+		int32 BestChoice = 0;
+
+		// Largest first with a strict compare, so ties keep the larger module
+		for (const int32 Footprint : Footprints)
+		{
+			if (Footprint > Length) continue;
+
+			const int32 CandidateHoles = Holes[Length - Footprint];
+			const int32 CandidatePieces = Pieces[Length - Footprint] + 1;
+			if (CandidateHoles < BestHoles || (CandidateHoles == BestHoles && CandidatePieces < BestPieces))
+			{
+				BestHoles = CandidateHoles;
+				BestPieces = CandidatePieces;
+				BestChoice = Footprint;
+			}
+		}
+
+		Holes.Add(BestHoles);
+		Pieces.Add(BestPieces);
+		Choice.Add(BestChoice);
+	}
+}
+
+int32 FWallRunPacker::Solve(int32 RunLength, TArray<int32, TMemStackAllocator<>>& OutPieces) const
+{
+	OutPieces.Reset();
+	if (RunLength <= 0) return 0;
+
+	if (RunLength > GetMaxLength())
+	{
+		FWallRunPacker Extended = *this;
+		Extended.EnsureLength(RunLength);
+		return Extended.Solve(RunLength, OutPieces);
+	}
+
+	for (int32 Remaining = RunLength; Remaining > 0; )
+	{
+		const int32 Piece = Choice[Remaining];
+		OutPieces.Add(Piece);
+		Remaining -= FMath::Max(Piece, 1);
+	}
+	return Holes[RunLength];
+}
@@ -0,0 +1,69 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Utilities/Helpers/WeightedAliasTable.h"
+
+void FWeightedAliasTable::Build(TConstArrayView<float> Weights)
+{
+	const int32 Count = Weights.Num();
+	Probability.SetNumUninitialized(Count);
+	Alias.SetNumUninitialized(Count);
+	if (Count == 0) return;
+
+	double TotalWeight = 0.0;
+	for (const float Weight : Weights) { TotalWeight += FMath::Max(Weight, 0.0f); }
+
+	// All weights zero: uniform selection
+	if (TotalWeight <= 0.0)
+	{
+		for (int32 i = 0; i < Count; ++i) { Probability[i] = 1.0f; Alias[i] = i; }
+		return;
+	}
+
+	// Scale so the average column holds exactly 1.0, then split into under- and over-full columns
+	TArray<double, TInlineAllocator<32>> Scaled;
+	TArray<int32, TInlineAllocator<32>> Small;
+	TArray<int32, TInlineAllocator<32>> Large;
+	Scaled.SetNumUninitialized(Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Scaled[i] = FMath::Max(Weights[i], 0.0f) * Count / TotalWeight;
+		if (Scaled[i] < 1.0) Small.Add(i);
+		else Large.Add(i);
+	}
+
+	// Pair each under-full column with an over-full donor
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+		const int32 Less = Small.Pop(EAllowShrinking::No);
+		const int32 More = Large.Pop(EAllowShrinking::No);
+
+		Probability[Less] = static_cast<float>(Scaled[Less]);
+		Alias[Less] = More;
+
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+		if (Scaled[More] < 1.0) Small.Add(More);
+		else Large.Add(More);
+	}
+
+	// Leftovers are full columns (up to rounding error)
+	for (const int32 i : Large) { Probability[i] = 1.0f; Alias[i] = i; }
+	for (const int32 i : Small) { Probability[i] = 1.0f; Alias[i] = i; }
+}
+
+void FWeightedAliasTable::Reset()
+{
+	Probability.Reset();
+	Alias.Reset();
+}
+
+int32 FWeightedAliasTable::SampleFromUnit(float Unit) const
+{
+	const int32 Count = Probability.Num();
+	if (Count == 0) return INDEX_NONE;
+
+	// Integer part picks the column, fractional part decides column vs alias
+	const float Scaled = Unit * Count;
+	const int32 Column = FMath::Clamp(static_cast<int32>(Scaled), 0, Count - 1);
+	return (Scaled - Column) < Probability[Column] ? Column : Alias[Column];
+}
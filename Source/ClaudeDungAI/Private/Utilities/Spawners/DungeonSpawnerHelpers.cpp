@@ -3,12 +3,14 @@
 #include "Utilities/Spawners/DungeonSpawnerHelpers.h"
 #include "Utilities/Helpers/DungeonGenerationHelpers.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
 
  
 // INSTANCED STATIC MESH COMPONENT MANAGEMENT
 UInstancedStaticMeshComponent* UDungeonSpawnerHelpers::GetOrCreateISMComponent(AActor* Owner, const TSoftObjectPtr<UStaticMesh>& MeshAsset,
-TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap,const FString& ComponentNamePrefix,bool bLogWarnings)
+TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap,const FString& ComponentNamePrefix,bool bLogWarnings,
+bool bHierarchical, const FISMCategorySettings& Settings)
 {
 	if (!Owner)
 	{
@@ -34,8 +36,15 @@ TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap,
 
 	// Create new ISM component
 	FString ComponentName = FString::Printf(TEXT("%s%s"), *ComponentNamePrefix, *MeshAsset. GetAssetName());
-	
-	UInstancedStaticMeshComponent* NewISM = NewObject<UInstancedStaticMeshComponent>(Owner, FName(*ComponentName));
+
+	// HISM builds a cluster tree over its instances so whole clusters are frustum/distance culled
+	UClass* ComponentClass = bHierarchical ? UHierarchicalInstancedStaticMeshComponent::StaticClass() : UInstancedStaticMeshComponent::StaticClass();
+
+	// A component just released for this mesh (possibly of the other class) still owns the name until it is collected
+	FName ComponentFName(*ComponentName);
+	if (StaticFindObjectFast(nullptr, Owner, ComponentFName)) ComponentFName = MakeUniqueObjectName(Owner, ComponentClass, ComponentFName);
+
+	UInstancedStaticMeshComponent* NewISM = NewObject<UInstancedStaticMeshComponent>(Owner, ComponentClass, ComponentFName);
 
 	if (!NewISM)
 	{
@@ -49,6 +58,7 @@ TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap,
 
 	// Set mesh
 	NewISM->SetStaticMesh(StaticMesh);
+	ApplyISMCategorySettings(NewISM, Settings);
 
 	// Store component for reuse
 	ComponentMap. Add(MeshAsset, NewISM);
@@ -56,6 +66,21 @@ TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap,
 	return NewISM;
 }
 
+void UDungeonSpawnerHelpers::ApplyISMCategorySettings(UInstancedStaticMeshComponent* ISMComponent, const FISMCategorySettings& Settings)
+{
+	if (!ISMComponent) return;
+
+	ISMComponent->SetCullDistances(Settings.StartCullDistance, Settings.EndCullDistance);
+	ISMComponent->SetCastShadow(Settings.bCastShadows);
+	ISMComponent->SetCollisionEnabled(Settings.CollisionEnabled);
+
+	if (ISMComponent->InstanceLODDistanceScale != Settings.LODDistanceScale)
+	{
+		ISMComponent->InstanceLODDistanceScale = Settings.LODDistanceScale;
+		ISMComponent->MarkRenderStateDirty();
+	}
+}
+
 void UDungeonSpawnerHelpers::ClearISMComponentMap(TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap)
 {
 	// Destroy all components
@@ -87,18 +112,130 @@ const FVector& WorldOffset)
 
 int32 UDungeonSpawnerHelpers::SpawnMeshInstances(UInstancedStaticMeshComponent* ISMComponent, const TArray<FTransform>& LocalTransforms,
 const FVector& WorldOffset)
+{
+	if (!ISMComponent || LocalTransforms.Num() == 0) return 0;
+
+	// One call marks render state dirty once for the whole array instead of once per instance
+	ISMComponent->AddInstances(LocalToWorldTransforms(LocalTransforms, WorldOffset), false);
+	return LocalTransforms.Num();
+}
+
+int32 UDungeonSpawnerHelpers::UpdateMeshInstances(UInstancedStaticMeshComponent* ISMComponent, const TArray<FTransform>& LocalTransforms,
+const FVector& WorldOffset)
 {
 	if (!ISMComponent) return 0;
-	int32 SpawnedCount = 0;
 
-	for (const FTransform& LocalTransform : LocalTransforms)
+	TArray<FTransform> WorldTransforms = LocalToWorldTransforms(LocalTransforms, WorldOffset);
+	const int32 ExistingCount = ISMComponent->GetInstanceCount();
+	const int32 KeptCount = FMath::Min(ExistingCount, WorldTransforms.Num());
+
+	// Surplus instances go from the back so the kept indices stay stable
+	if (ExistingCount > KeptCount)
 	{
-		int32 InstanceIndex = SpawnMeshInstance(ISMComponent, LocalTransform, WorldOffset);
-		if (InstanceIndex >= 0) SpawnedCount++;
+		TArray<int32> SurplusIndices;
+		SurplusIndices.Reserve(ExistingCount - KeptCount);
+		for (int32 Index = ExistingCount - 1; Index >= KeptCount; --Index) { SurplusIndices.Add(Index); }
+		ISMComponent->RemoveInstances(SurplusIndices);
+	}
+
+	// Missing instances are appended in one call
+	if (WorldTransforms.Num() > KeptCount)
+	{
+		TArray<FTransform> AddedTransforms(WorldTransforms.GetData() + KeptCount, WorldTransforms.Num() - KeptCount);
+		ISMComponent->AddInstances(AddedTransforms, false);
+	}
+
+	// Everything that was already there is moved in place (one render state update)
+	if (KeptCount > 0)
+	{
+		WorldTransforms.SetNum(KeptCount);
+		ISMComponent->BatchUpdateInstancesTransforms(0, WorldTransforms, false, true, true);
+	}
+
+	return LocalTransforms.Num();
+}
+
+int32 UDungeonSpawnerHelpers::SyncMeshInstanceBatches(AActor* Owner, const FRoomMeshPalette& Palette, const FMeshInstanceBuffers& Buffers,
+TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, const FString& ComponentNamePrefix,
+const FVector& WorldOffset, bool bHierarchical, const FISMCategorySettings& Settings)
+{
+	ReleaseUnusedISMComponents(Palette, Buffers, ComponentMap, bHierarchical);
+
+	int32 SpawnedCount = 0;
+	for (int32 MeshId = 0; MeshId < Buffers.Transforms.Num(); ++MeshId)
+	{
+		const TArray<FTransform>& Batch = Buffers.Transforms[MeshId];
+		if (Batch.Num() == 0) continue;
+
+		const TSoftObjectPtr<UStaticMesh>& MeshAsset = Palette.GetMesh(static_cast<FRoomMeshId>(MeshId));
+		const bool bKeptComponent = ComponentMap.Contains(MeshAsset);
+		UInstancedStaticMeshComponent* ISM = GetOrCreateISMComponent(Owner, MeshAsset, ComponentMap, ComponentNamePrefix, true, bHierarchical, Settings);
+
+		// New components were configured on creation; kept ones pick up edited settings here
+		if (bKeptComponent) ApplyISMCategorySettings(ISM, Settings);
+		SpawnedCount += UpdateMeshInstances(ISM, Batch, WorldOffset);
 	}
 
 	return SpawnedCount;
 }
+
+void UDungeonSpawnerHelpers::ReleaseUnusedISMComponents(const FRoomMeshPalette& Palette, const FMeshInstanceBuffers& Buffers,
+TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, bool bHierarchical)
+{
+	// Only components whose mesh dropped out of the layout (or whose class no longer matches the mode) are destroyed
+	for (auto It = ComponentMap.CreateIterator(); It; ++It)
+	{
+		const FRoomMeshId MeshId = Palette.Find(It.Key());
+		const bool bStillUsed = Buffers.Transforms.IsValidIndex(MeshId) && Buffers.Transforms[MeshId].Num() > 0;
+		const bool bClassMatches = IsValid(It.Value()) && It.Value()->IsA<UHierarchicalInstancedStaticMeshComponent>() == bHierarchical;
+		if (bStillUsed && bClassMatches) continue;
+
+		if (IsValid(It.Value())) It.Value()->DestroyComponent();
+		It.RemoveCurrent();
+	}
+}
+
+int32 UDungeonSpawnerHelpers::UpdateMeshInstanceRange(UInstancedStaticMeshComponent* ISMComponent, const TArray<FTransform>& LocalTransforms,
+int32 StartIndex, int32 Count, const FVector& WorldOffset)
+{
+	if (!ISMComponent) return 0;
+	Count = FMath::Min(Count, LocalTransforms.Num() - StartIndex);
+	if (StartIndex < 0 || Count <= 0) return 0;
+
+	TArray<FTransform, TInlineAllocator<64>> WorldTransforms;
+	WorldTransforms.Reserve(Count);
+	for (int32 Index = StartIndex; Index < StartIndex + Count; ++Index)
+	{
+		WorldTransforms.Add(LocalToWorldTransform(LocalTransforms[Index], WorldOffset));
+	}
+
+	// Part of the slice the component already has instances for is moved in place, the remainder appended
+	const int32 KeptCount = FMath::Clamp(ISMComponent->GetInstanceCount() - StartIndex, 0, Count);
+	if (KeptCount > 0)
+	{
+		ISMComponent->BatchUpdateInstancesTransforms(StartIndex, TArrayView<const FTransform>(WorldTransforms.GetData(), KeptCount), false, true, true);
+	}
+	if (Count > KeptCount)
+	{
+		ISMComponent->AddInstances(TArray<FTransform>(WorldTransforms.GetData() + KeptCount, Count - KeptCount), false);
+	}
+
+	return Count;
+}
+
+void UDungeonSpawnerHelpers::TrimMeshInstances(UInstancedStaticMeshComponent* ISMComponent, int32 NumInstances)
+{
+	if (!ISMComponent) return;
+
+	const int32 ExistingCount = ISMComponent->GetInstanceCount();
+	if (ExistingCount <= NumInstances) return;
+
+	// Surplus instances go from the back so the kept indices stay stable
+	TArray<int32> SurplusIndices;
+	SurplusIndices.Reserve(ExistingCount - NumInstances);
+	for (int32 Index = ExistingCount - 1; Index >= NumInstances; --Index) { SurplusIndices.Add(Index); }
+	ISMComponent->RemoveInstances(SurplusIndices);
+}
   
 // TRANSFORM UTILITIES
 FTransform UDungeonSpawnerHelpers::LocalToWorldTransform(const FTransform& LocalTransform, const FVector& WorldOffset)
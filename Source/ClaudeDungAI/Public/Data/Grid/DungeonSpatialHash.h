@@ -0,0 +1,95 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * DungeonSpatialHash - Uniform bucket grid of integer rectangles on the dungeon cell grid
+ * Each rectangle is listed in every bucket it touches; queries only visit the buckets under the query rectangle.
+ * Insertion and overlap tests are O(rect area / bucket area), independent of how many rectangles are stored.
+ * Every entry carries a caller tag (room index, corridor marker, ...) so queries can skip related entries.
+ */
+struct CLAUDEDUNGAI_API FDungeonSpatialHash
+{
+public:
+	explicit FDungeonSpatialHash(int32 InBucketSize = 32) { Reset(InBucketSize); }
+
+	/* Drop every entry and change the bucket edge length (in cells) */
+	void Reset(int32 InBucketSize);
+
+	/* Store a rectangle (Min inclusive, Max exclusive); returns its entry id */
+	int32 Add(const FIntRect& Rect, int32 Tag);
+
+	/* Visit each entry overlapping Rect once; Func(EntryId, Rect, Tag) returns false to stop early */
+	template<typename FuncType>
+	void ForEachOverlapping(const FIntRect& Rect, FuncType&& Func) const
+	{
+		if (Rect.Min.X >= Rect.Max.X || Rect.Min.Y >= Rect.Max.Y) return;
+
+		++QueryStamp;
+		const FIntPoint MinBucket = ToBucket(Rect.Min);
+		const FIntPoint MaxBucket = ToBucket(Rect.Max - FIntPoint(1, 1));
+		for (int32 BX = MinBucket.X; BX <= MaxBucket.X; ++BX)
+		{
+			for (int32 BY = MinBucket.Y; BY <= MaxBucket.Y; ++BY)
+			{
+				const TArray<int32, TInlineAllocator<4>>* Bucket = Buckets.Find(FIntPoint(BX, BY));
+				if (!Bucket) continue;
+
+				for (int32 EntryId : *Bucket)
+				{
+					// Entries spanning several buckets are seen once per query
+					if (EntryStamps[EntryId] == QueryStamp) continue;
+					EntryStamps[EntryId] = QueryStamp;
+
+					if (!Overlaps(Entries[EntryId], Rect)) continue;
+					if (!Func(EntryId, Entries[EntryId], Tags[EntryId])) return;
+				}
+			}
+		}
+	}
+
+	/* True if any entry overlaps Rect and ShouldTest(Tag) accepts it */
+	template<typename FilterType>
+	bool AnyOverlapping(const FIntRect& Rect, FilterType&& ShouldTest) const
+	{
+		bool bFound = false;
+		ForEachOverlapping(Rect, [&](int32, const FIntRect&, int32 Tag)
+		{
+			bFound = ShouldTest(Tag);
+			return !bFound;
+		});
+		return bFound;
+	}
+
+	int32 Num() const { return Entries.Num(); }
+	const FIntRect& GetRect(int32 EntryId) const { return Entries[EntryId]; }
+	int32 GetTag(int32 EntryId) const { return Tags[EntryId]; }
+
+	static bool Overlaps(const FIntRect& A, const FIntRect& B)
+	{
+		return A.Min.X < B.Max.X && B.Min.X < A.Max.X && A.Min.Y < B.Max.Y && B.Min.Y < A.Max.Y;
+	}
+
+private:
+	/* Bucket holding a cell (floor division, so negative coordinates bucket correctly) */
+	FIntPoint ToBucket(FIntPoint Cell) const
+	{
+		return FIntPoint(FMath::FloorToInt((float)Cell.X / BucketSize), FMath::FloorToInt((float)Cell.Y / BucketSize));
+	}
+
+	// Bucket edge length in cells
+	int32 BucketSize;
+
+	// Stored rectangles and their caller tags (parallel arrays, indexed by entry id)
+	TArray<FIntRect> Entries;
+	TArray<int32> Tags;
+
+	// Entry ids per occupied bucket
+	TMap<FIntPoint, TArray<int32, TInlineAllocator<4>>> Buckets;
+
+	// Query stamp each entry was last visited with (de-duplicates multi-bucket entries)
+	mutable TArray<uint32> EntryStamps;
+	mutable uint32 QueryStamp;
+};
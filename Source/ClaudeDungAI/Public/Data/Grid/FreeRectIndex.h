@@ -0,0 +1,50 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+
+struct FGridOccupancy;
+
+/**
+ * FreeRectIndex - List of maximal empty rectangles over a room grid
+ * Built once from an FGridOccupancy, then kept current by Occupy() on each placement (MaxRects-style split + prune).
+ * Fill passes ask for candidate anchors of a footprint and only visit free space instead of rescanning the grid.
+ * Anything that frees cells invalidates the index; the next Build() starts over from the occupancy mask.
+ */
+struct CLAUDEDUNGAI_API FFreeRectIndex
+{
+public:
+	FFreeRectIndex() : GridSize(FIntPoint::ZeroValue), bValid(false) {}
+
+	/* Rebuild the list of maximal empty rectangles from the mask (O(grid area)) */
+	void Build(const FGridOccupancy& Occupancy);
+
+	/* Drop all rectangles; index must be rebuilt before use */
+	void Invalidate();
+
+	bool IsValid() const { return bValid; }
+
+	/* Split every free rectangle touched by a newly occupied area (no-op when invalid) */
+	void Occupy(FIntPoint StartCoord, FIntPoint Size);
+
+	/* Each anchor where Size fits inside some free rectangle, once, in rectangle order (caller holds the FMemMark) */
+	void GatherAnchors(FIntPoint Size, TArray<FIntPoint, TMemStackAllocator<>>& OutAnchors) const;
+
+	/* Number of free rectangles currently tracked */
+	int32 Num() const { return Rects.Num(); }
+
+	/* Free rectangles (Min inclusive, Max exclusive) */
+	const TArray<FIntRect>& GetRects() const { return Rects; }
+
+private:
+	// Grid dimensions the index was built for
+	FIntPoint GridSize;
+
+	// Maximal empty rectangles (no entry contains another)
+	TArray<FIntRect> Rects;
+
+	// Rects reflect the current occupancy
+	bool bValid;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Data/Room/CeilingData.h"
+#include "Data/Grid/RoomMeshPalette.h"
 #include "Engine/StaticMesh.h"
 #include "GridData.generated.h"
 
@@ -130,6 +131,38 @@ struct FWallModule
 	float PlacementWeight = 1.0f;
 };
 
+/* Struct to track placed mesh information */
+USTRUCT()
+struct FPlacedMeshInfo
+{
+	GENERATED_BODY()
+
+	// Grid position (top-left cell)
+	UPROPERTY()
+	FIntPoint GridPosition;
+
+	// Size in cells
+	UPROPERTY()
+	FIntPoint Size;
+
+	// Rotation angle (0, 90, 180, 270)
+	UPROPERTY()
+	int32 Rotation;
+
+	// Mesh id in the room's FRoomMeshPalette
+	UPROPERTY()
+	uint16 MeshId;
+
+	FPlacedMeshInfo() : GridPosition(FIntPoint:: ZeroValue), Size(FIntPoint::ZeroValue), Rotation(0), MeshId(FRoomMeshPalette::InvalidId) {}
+
+	/* Component-space transform: centered on the whole footprint, rotated about Z */
+	FTransform GetLocalTransform(float InCellSize) const
+	{
+		const FVector LocalPos((GridPosition.X + Size.X * 0.5f) * InCellSize, (GridPosition.Y + Size.Y * 0.5f) * InCellSize, 0.0f);
+		return FTransform(FRotator(0, Rotation, 0), LocalPos, FVector::OneVector);
+	}
+};
+
 /* Tracks a placed corner piece (single mesh, no stacking) */
 USTRUCT(BlueprintType)
 struct FPlacedCornerInfo
@@ -140,9 +173,9 @@ struct FPlacedCornerInfo
 	UPROPERTY()
 	ECornerPosition Corner;
 
-	// Corner mesh used
+	// Corner mesh id in the room's FRoomMeshPalette
 	UPROPERTY()
-	TSoftObjectPtr<UStaticMesh> CornerMesh;
+	uint16 CornerMeshId;
 
 	// Corner transform (local/component space, relative to room origin)
 	UPROPERTY()
@@ -150,6 +183,7 @@ struct FPlacedCornerInfo
 
 	FPlacedCornerInfo()
 		: Corner(ECornerPosition:: SouthWest)
+		, CornerMeshId(FRoomMeshPalette::InvalidId)
 	{}
 };
 
@@ -192,9 +226,18 @@ struct FPlacedWallInfo
 	UPROPERTY()
 	int32 SpanLength;
 
-	// Wall module used
+	// Palette ids of the module's layers (InvalidId = layer not placed)
 	UPROPERTY()
-	FWallModule WallModule;
+	uint16 BaseMeshId;
+
+	UPROPERTY()
+	uint16 Middle1MeshId;
+
+	UPROPERTY()
+	uint16 Middle2MeshId;
+
+	UPROPERTY()
+	uint16 TopMeshId;
 
 	// World transforms for each mesh layer
 	UPROPERTY()
@@ -213,6 +256,10 @@ struct FPlacedWallInfo
 		: Edge(EWallEdge::North)
 		, StartCell(0)
 		, SpanLength(0)
+		, BaseMeshId(FRoomMeshPalette::InvalidId)
+		, Middle1MeshId(FRoomMeshPalette::InvalidId)
+		, Middle2MeshId(FRoomMeshPalette::InvalidId)
+		, TopMeshId(FRoomMeshPalette::InvalidId)
 	{}
 };
 
@@ -351,3 +398,25 @@ struct FForcedCeilingPlacement
 	TArray<int32> AllowedRotations;
 };
 
+/* Information about a placed ceiling tile */
+USTRUCT(BlueprintType)
+struct FPlacedCeilingInfo
+{
+	GENERATED_BODY()
+
+	/* Grid coordinate (top-left cell) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ceiling")
+	FIntPoint GridCoordinate = FIntPoint(0, 0);
+
+	/* Tile size in cells (e.g., 4x4, 2x2, 1x1) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ceiling")
+	FIntPoint TileSize = FIntPoint(1, 1);
+
+	/* Mesh id in the room's FRoomMeshPalette */
+	UPROPERTY(VisibleAnywhere, Category = "Ceiling")
+	uint16 MeshId = FRoomMeshPalette::InvalidId;
+
+	/* World transform (component-space, relative to room) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ceiling")
+	FTransform Transform = FTransform::Identity;
+};
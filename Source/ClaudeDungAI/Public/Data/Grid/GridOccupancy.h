@@ -0,0 +1,79 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * GridOccupancy - Bit-packed occupancy mask for a room grid
+ * One bit per cell (1 = occupied), row-major, each row padded to whole 64-bit words.
+ * Rooms up to 64 cells wide use a single word per row, so a rectangle test is one mask-and-compare per row.
+ * This is a fast-path mirror only; FRoomGenerationCore::GridState stays the authoritative typed view.
+ *
+ * An optional summed-area table (integral image of occupied cells) answers "any occupied cell in rect?" with four reads.
+ * Owners rebuild it before a run of area tests: GenerateFloor once after its forced and preset phases, each ceiling
+ * sweep, and the corridor router's blocked mask. Marking cells occupied keeps it usable: a stale table can only
+ * under-count, so a non-zero count is still a definite rejection (cells marked since the rebuild fall through to
+ * the bit test). Freeing cells invalidates it.
+ */
+struct CLAUDEDUNGAI_API FGridOccupancy
+{
+public:
+	FGridOccupancy() : GridSize(FIntPoint::ZeroValue), WordsPerRow(0), bSummedAreaValid(false) {}
+
+	/* Allocate mask for grid size with all cells free */
+	void Init(FIntPoint InGridSize);
+
+	/* Mark all cells free (keeps allocation) */
+	void Reset();
+
+	/* Release storage */
+	void Empty();
+
+	bool IsInitialized() const { return Words.Num() > 0; }
+	FIntPoint GetGridSize() const { return GridSize; }
+
+	/* Cells outside the grid are reported as occupied */
+	bool IsCellOccupied(FIntPoint Cell) const;
+	void SetCell(FIntPoint Cell, bool bOccupied);
+
+	/* True if every cell of the rectangle is inside the grid and free */
+	bool IsRectFree(FIntPoint StartCoord, FIntPoint Size) const;
+
+	/* Set or clear a rectangle (clipped to grid bounds) */
+	void SetRect(FIntPoint StartCoord, FIntPoint Size, bool bOccupied);
+
+	/* Number of occupied cells */
+	int32 CountOccupied() const;
+
+	/* Rebuild the summed-area table from the current bits (O(grid area)) */
+	void RebuildSummedAreaTable();
+
+	/* True if the summed-area table can be used for rejection tests */
+	bool HasSummedAreaTable() const { return bSummedAreaValid; }
+
+private:
+	/* Mask with BitCount bits set starting at BitOffset (BitOffset + BitCount <= 64) */
+	static uint64 MakeSpanMask(int32 BitOffset, int32 BitCount);
+
+	/* Occupied cells in rect as of the last rebuild (caller checks bounds) */
+	int32 SummedAreaCount(FIntPoint StartCoord, FIntPoint Size) const;
+
+	/* Bitset-only rectangle test (caller checks bounds) */
+	bool IsRectFreeBits(FIntPoint StartCoord, FIntPoint Size) const;
+
+	// Grid dimensions in cells
+	FIntPoint GridSize;
+
+	// Number of 64-bit words per grid row
+	int32 WordsPerRow;
+
+	// Packed bits (row-major: Word = Y * WordsPerRow + X / 64)
+	TArray<uint64> Words;
+
+	// Integral image of occupied cells, (GridSize.X + 1) * (GridSize.Y + 1) entries with a zero border
+	TArray<int32> SummedArea;
+
+	// Summed-area table reflects every occupied cell it reports (see class comment)
+	bool bSummedAreaValid;
+};
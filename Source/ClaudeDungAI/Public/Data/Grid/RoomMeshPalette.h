@@ -0,0 +1,65 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPtr.h"
+
+class UStaticMesh;
+
+/* Index of a mesh in a room's FRoomMeshPalette */
+using FRoomMeshId = uint16;
+
+/**
+ * RoomMeshPalette - Interns every mesh a room places to a 16-bit id
+ * Placement records carry the id instead of a soft pointer (or a whole pool entry), and the spawner groups
+ * instances by indexing an array with it. Ids are never reused while the palette lives, so records written by
+ * phases generated at different times stay valid together.
+ */
+struct CLAUDEDUNGAI_API FRoomMeshPalette
+{
+public:
+	static constexpr FRoomMeshId InvalidId = MAX_uint16;
+
+	/* Id for Mesh, added on first use (InvalidId for a null mesh or a full palette) */
+	FRoomMeshId Intern(const TSoftObjectPtr<UStaticMesh>& Mesh);
+
+	/* Id already assigned to Mesh, or InvalidId */
+	FRoomMeshId Find(const TSoftObjectPtr<UStaticMesh>& Mesh) const;
+
+	/* Mesh for Id (null soft pointer for an invalid id) */
+	const TSoftObjectPtr<UStaticMesh>& GetMesh(FRoomMeshId Id) const;
+
+	bool IsValidId(FRoomMeshId Id) const { return Meshes.IsValidIndex(Id); }
+	int32 Num() const { return Meshes.Num(); }
+
+	/* Forget every mesh (only safe once no placement record refers to the palette) */
+	void Reset();
+
+private:
+	// Id -> mesh
+	TArray<TSoftObjectPtr<UStaticMesh>> Meshes;
+
+	// Mesh -> id
+	TMap<FSoftObjectPath, FRoomMeshId> IdsByPath;
+};
+
+/* Room-space transforms of one placement category in structure-of-arrays form
+ * Transforms[MeshId] is one contiguous array per palette mesh, ready to hand to AddInstances as is */
+struct FMeshInstanceBuffers
+{
+	TArray<TArray<FTransform>> Transforms;
+
+	/* Empty every per-mesh array (allocations kept) and size the outer array to the palette */
+	void Reset(int32 NumMeshes)
+	{
+		for (TArray<FTransform>& MeshTransforms : Transforms) { MeshTransforms.Reset(); }
+		Transforms.SetNum(NumMeshes);
+	}
+
+	/* Queue one instance (invalid ids, i.e. layers that were not placed, are ignored) */
+	void Add(FRoomMeshId MeshId, const FTransform& LocalTransform)
+	{
+		if (Transforms.IsValidIndex(MeshId)) Transforms[MeshId].Add(LocalTransform);
+	}
+};
@@ -77,4 +77,11 @@ public:
 
 	/* Get region at specific grid coordinate (returns nullptr if no region found) */
 	const FPresetRegion* GetRegionAtCoordinate(FIntPoint GridCoordinate, FIntPoint GridSize) const;
+
+	/* Raster value for cells outside every region */
+	static constexpr uint8 NoRegion = MAX_uint8;
+
+	/* Resolve every cell once: OutRaster[Y * GridSize.X + X] = index into Regions of the region GetRegionAtCoordinate
+	 * would return, or NoRegion. Regions past index 254 cannot be stored and are skipped with a warning. */
+	void BuildRegionRaster(FIntPoint GridSize, TArray<uint8>& OutRaster) const;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Utilities/Helpers/WeightedAliasTable.h"
 #include "CeilingData.generated.h"
 
 // Struct for ceiling tile definitions (supports different sizes for efficient coverage)
@@ -50,4 +51,30 @@ public:
 	// Rotation offset for all ceiling tiles (0, 180, 0) to flip floor tiles upside down for ceiling
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ceiling Settings")
 	FRotator CeilingRotation = FRotator(0.0f, 180.0f, 0.0f);
+
+#pragma region Cached Samplers
+	/* Weighted samplers over each tile pool (build cache on first use) */
+	const FWeightedAliasTable& GetLargeTileSampler() const { EnsureSamplers(); return LargeTileSampler; }
+	const FWeightedAliasTable& GetMediumTileSampler() const { EnsureSamplers(); return MediumTileSampler; }
+	const FWeightedAliasTable& GetSmallTileSampler() const { EnsureSamplers(); return SmallTileSampler; }
+
+	/* Drop cached samplers; rebuilt on next use */
+	void InvalidateSamplers() const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+#pragma endregion
+
+private:
+	/* Build all pool samplers if stale */
+	void EnsureSamplers() const;
+
+	// Alias tables over each pool's PlacementWeight
+	mutable FWeightedAliasTable LargeTileSampler;
+	mutable FWeightedAliasTable MediumTileSampler;
+	mutable FWeightedAliasTable SmallTileSampler;
+
+	// True once the samplers reflect the tile pools
+	mutable bool bSamplersBuilt = false;
 };
@@ -4,10 +4,21 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Utilities/Helpers/WeightedAliasTable.h"
 #include "FloorData.generated.h"
 
 struct FMeshPlacementInfo;
 
+// Cached sampler over the FloorTilePool entries that fit one oriented footprint
+struct FFloorFootprintBucket
+{
+	// Indices into FloorTilePool whose footprint (or its 90° rotation) matches
+	TArray<int32> TileIndices;
+
+	// Weighted sampler over TileIndices
+	FWeightedAliasTable Sampler;
+};
+
 UCLASS()
 class CLAUDEDUNGAI_API UFloorData : public UDataAsset
 {
@@ -27,6 +38,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Floor Tiles")
 	TArray<FMeshPlacementInfo> FloorTilePool;
 
+	// Pack the floor in a single row-major sweep instead of one sweep per tile size.
+	// Each free cell gets the largest footprint from FloorTilePool that fits there;
+	// only footprints actually present in the pool are tried.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Floor Tiles")
+	bool bUseSinglePassPacker = false;
+
 	// --- Floor Clutter / Detail Meshes ---
 	
 	// A separate pool for smaller details or clutter placed randomly on top of the main tiles.
@@ -37,4 +54,31 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Floor Clutter")
 	float ClutterPlacementChance = 0.25f;
 
+#pragma region Cached Samplers
+	/* Footprint of a pool entry in cells (explicit GridFootprint, otherwise 1x1) */
+	static FIntPoint GetTileFootprint(const FMeshPlacementInfo& MeshInfo);
+
+	/* Bucket for an oriented footprint, or nullptr if no tile fits it (builds cache on first use) */
+	const FFloorFootprintBucket* FindFootprintBucket(FIntPoint Size) const;
+
+	/* All buckets keyed by oriented footprint (builds cache on first use) */
+	const TMap<FIntPoint, FFloorFootprintBucket>& GetFootprintBuckets() const;
+
+	/* Drop cached samplers; rebuilt on next use */
+	void InvalidateSamplers() const;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+#pragma endregion
+
+private:
+	/* Build footprint buckets and alias tables from FloorTilePool */
+	void BuildSamplers() const;
+
+	// Per-footprint samplers (built lazily on the game thread, before generation)
+	mutable TMap<FIntPoint, FFloorFootprintBucket> FootprintBuckets;
+
+	// True once FootprintBuckets reflects FloorTilePool
+	mutable bool bSamplersBuilt = false;
 };
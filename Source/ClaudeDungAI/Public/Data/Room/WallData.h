@@ -4,10 +4,22 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "Utilities/Helpers/WeightedAliasTable.h"
+#include "Utilities/Helpers/WallRunPacker.h"
 #include "WallData.generated.h"
 
 struct FWallModule;
 
+// Cached sampler over the AvailableWallModules entries that share one footprint
+struct FWallFootprintBucket
+{
+	// Indices into AvailableWallModules with this Y_AxisFootprint
+	TArray<int32> ModuleIndices;
+
+	// Weighted sampler over ModuleIndices
+	FWeightedAliasTable Sampler;
+};
+
 UCLASS()
 class CLAUDEDUNGAI_API UWallData : public UDataAsset
 {
@@ -18,6 +30,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wall Modules")
 	TArray<FWallModule> AvailableWallModules;
 
+	// Cover each free run between doorways/forced walls exactly with the fewest modules (DP) instead of
+	// greedy largest-first; PlacementWeight picks between modules of the same footprint
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wall Modules")
+	bool bUseOptimalPacker = false;
+
 	// The default static mesh to use for the floor in the room (e.g., a simple square tile)
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wall Defaults")
 	TSoftObjectPtr<UStaticMesh> DefaultCornerMesh; 
@@ -103,4 +120,49 @@ public:
 	// Rotation offset for columns (if needed)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wall Decorations", meta = (EditCondition = "bEnableWallColumns"))
 	FRotator ColumnRotationOffset = FRotator::ZeroRotator;
+
+#pragma region Cached Samplers
+	/* Weighted sampler over AvailableWallModules (builds cache on first use) */
+	const FWeightedAliasTable& GetModuleSampler() const;
+
+	/* Per-footprint samplers keyed by Y_AxisFootprint (builds cache on first use) */
+	const TMap<int32, FWallFootprintBucket>& GetFootprintBuckets() const;
+
+	/* Run packer over the module footprints, memoized up to at least MaxRunLength
+	 * The memo lives on the asset, so every room using this style shares it (game thread only) */
+	const FWallRunPacker& GetRunPacker(int32 MaxRunLength) const;
+
+	/* Drop cached samplers; rebuilt on next use */
+	void InvalidateSamplers() const;
+
+	/* Local transform of SocketName on Mesh (FallbackOffset if the mesh or socket is missing)
+	 * FindSocket runs once per (mesh, socket); every segment and room using this style reuses the result (game thread only) */
+	FTransform GetSocketTransform(UStaticMesh* Mesh, FName SocketName, const FVector& FallbackOffset) const;
+
+	/* Drop cached socket transforms (e.g. after a module mesh's sockets were edited) */
+	void InvalidateSocketCache() const { SocketTransformCache.Reset(); }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+#pragma endregion
+
+private:
+	/* Build the module sampler, footprint buckets and packer footprint set from AvailableWallModules */
+	void BuildSamplers() const;
+
+	// Alias table over AvailableWallModules[i].PlacementWeight
+	mutable FWeightedAliasTable ModuleSampler;
+
+	// Per-footprint samplers
+	mutable TMap<int32, FWallFootprintBucket> FootprintBuckets;
+
+	// DP packing table over the footprints in FootprintBuckets (grows on demand)
+	mutable FWallRunPacker RunPacker;
+
+	// True once ModuleSampler, FootprintBuckets and RunPacker reflect AvailableWallModules
+	mutable bool bSamplersBuilt = false;
+
+	// (mesh, socket) -> socket transform relative to the mesh; unset when the mesh has no such socket
+	mutable TMap<TPair<TObjectKey<UStaticMesh>, FName>, TOptional<FTransform>> SocketTransformCache;
 };
@@ -0,0 +1,125 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridOccupancy.h"
+#include "Data/Grid/RoomMeshPalette.h"
+
+struct FDungeonLayout;
+class UStaticMesh;
+
+/* One corridor between the two doorways of a layout connection */
+struct FDungeonCorridor
+{
+	// Index into FDungeonLayout::Connections
+	int32 ConnectionIndex = INDEX_NONE;
+
+	// Corridor width in cells (the connection's doorway width)
+	int32 Width = 0;
+
+	// Found by the path search (false = straight strip between facing doorways)
+	bool bSearched = false;
+
+	// Dungeon cells the corridor floor covers, each once
+	TArray<FIntPoint> Cells;
+};
+
+/**
+ * DungeonCorridorRouter - Routes corridors between the matched doorways of a dungeon layout
+ * Room footprints (interior + wall ring) are stamped into one bitset over the layout bounds. For a corridor of width W
+ * the search runs on a clearance bitset derived from it (cell free = the W x W square anchored there is free), so a
+ * wide corridor is routed as a single point. Facing, aligned doorways get a straight strip without searching;
+ * everything else goes through A* with jump-point search (8-connected, no corner cutting), and the jump points are
+ * expanded into a 4-connected run of squares. Search buffers are stamped rather than cleared, so each route only
+ * costs the cells it touches. Plain C++ that reads only the layout copy it is given; safe on a worker thread.
+ */
+class CLAUDEDUNGAI_API FDungeonCorridorRouter
+{
+public:
+	FDungeonCorridorRouter();
+
+	/* Block every room footprint of the layout on a grid covering its bounds plus Margin cells on each side
+	 * (the layout must outlive the router) */
+	void Build(const FDungeonLayout& InLayout, int32 Margin = 8);
+
+	/* Route every connection; corridors with no path are logged and skipped. Returns the number routed. */
+	int32 RouteAll();
+
+	/* Route one connection into OutCorridor and add its cells to the corridor mask; false if no path was found */
+	bool RouteConnection(int32 ConnectionIndex, FDungeonCorridor& OutCorridor);
+
+	/* Corridors produced by RouteAll */
+	const TArray<FDungeonCorridor>& GetCorridors() const { return Corridors; }
+
+	/* Give up on a search after this many node expansions (keeps one bad connection from stalling the rest) */
+	void SetMaxExpansions(int32 InMaxExpansions) { MaxExpansions = FMath::Max(InMaxExpansions, 1); }
+
+	/** Emit one floor tile per corridor cell and one wall per open corridor side through the mesh palette
+	 * Transforms are relative to dungeon cell (0, 0), the same space rooms are offset into by their GridOrigin.
+	 * Sides facing another corridor cell or a doorway opening get no wall. */
+	void EmitPlacements(const TSoftObjectPtr<UStaticMesh>& FloorMesh, const TSoftObjectPtr<UStaticMesh>& WallMesh,
+		FRoomMeshPalette& Palette, FMeshInstanceBuffers& OutFloorInstances, FMeshInstanceBuffers& OutWallInstances) const;
+
+private:
+#pragma region Internal Data
+	// Layout being routed
+	const FDungeonLayout* Layout;
+
+	// Dungeon cell of router grid cell (0, 0)
+	FIntPoint GridOrigin;
+	FIntPoint GridSize;
+
+	// Room footprints (set = blocked)
+	FGridOccupancy BlockedMask;
+
+	// Per corridor width: set = the W x W square anchored at that cell hits a footprint (built on first use)
+	TMap<int32, FGridOccupancy> ClearanceMasks;
+
+	// Corridor floor cells of every route so far, and the same cells as a list in routing order
+	FGridOccupancy CorridorMask;
+	TArray<FIntPoint> CorridorCells;
+
+	// Doorway opening cells of every connection (never walled off)
+	FGridOccupancy DoorwayMask;
+
+	TArray<FDungeonCorridor> Corridors;
+
+	int32 MaxExpansions;
+
+	// A* node state per grid cell, valid only where SeenStamps matches the current search
+	TArray<float> GScores;
+	TArray<int32> Parents;
+	TArray<uint32> SeenStamps;
+	TArray<uint32> ClosedStamps;
+
+	// Route stamp per cell once it is in the current corridor's Cells (keeps overlapping squares from repeating)
+	TArray<uint32> CellStamps;
+
+	// Incremented once per routed connection
+	uint32 SearchStamp;
+#pragma endregion
+
+#pragma region Internal Helpers
+	/* Clearance mask for a corridor width (builds it from BlockedMask on first use) */
+	const FGridOccupancy& GetClearanceMask(int32 Width);
+
+	/* A* with jump-point search from Start to Goal anchors on a clearance mask; OutJumpPoints runs start to goal */
+	bool FindPath(const FGridOccupancy& Clearance, FIntPoint Start, FIntPoint Goal, TArray<FIntPoint>& OutJumpPoints);
+
+	/* Walk from Cell in Direction until a jump point (or Goal); false if the walk runs into a blocked cell */
+	bool Jump(const FGridOccupancy& Clearance, FIntPoint Cell, FIntPoint Direction, FIntPoint Goal, FIntPoint& OutJumpPoint) const;
+
+	/* Directions worth searching from Cell given the direction it was reached in (all eight for the start) */
+	void GetPrunedDirections(const FGridOccupancy& Clearance, FIntPoint Cell, FIntPoint Direction, TArray<FIntPoint, TInlineAllocator<8>>& OutDirections) const;
+
+	/* Add a W x W square of corridor floor anchored at Anchor */
+	void StampSquare(FIntPoint Anchor, int32 Width, FDungeonCorridor& Corridor);
+
+	/* Add one corridor floor cell (grid coordinates) */
+	void StampCell(FIntPoint Cell, FDungeonCorridor& Corridor);
+
+	int32 ToIndex(FIntPoint Cell) const { return Cell.Y * GridSize.X + Cell.X; }
+	FIntPoint ToCell(int32 Index) const { return FIntPoint(Index % GridSize.X, Index / GridSize.X); }
+#pragma endregion
+};
@@ -3,14 +3,217 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
 #include "UObject/Object.h"
 #include "DungeonGenerator.generated.h"
 
+class URoomData;
+struct FDungeonSpatialHash;
+
+/* Room type the dungeon layout can draw from */
+USTRUCT(BlueprintType)
+struct FDungeonRoomTemplate
+{
+	GENERATED_BODY()
+
+	/* Room configuration every room of this template is generated from */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout")
+	URoomData* RoomData = nullptr;
+
+	/* Smallest interior size in cells (X, Y) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout", meta = (ClampMin = "4"))
+	FIntPoint MinGridSize = FIntPoint(8, 8);
+
+	/* Largest interior size in cells (X, Y) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout", meta = (ClampMin = "4"))
+	FIntPoint MaxGridSize = FIntPoint(16, 16);
+
+	/* Relative chance of picking this template */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout", meta = (ClampMin = "0.0"))
+	float Weight = 1.0f;
+};
+
+/* Dungeon layout parameters */
+USTRUCT(BlueprintType)
+struct FDungeonLayoutSettings
+{
+	GENERATED_BODY()
+
+	/* Room types to place (the first room is drawn from these too) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout")
+	TArray<FDungeonRoomTemplate> RoomTemplates;
+
+	/* Number of rooms to place */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout", meta = (ClampMin = "1"))
+	int32 NumRooms = 20;
+
+	/* Cells of corridor between the facing walls of two connected rooms */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout|Corridors", meta = (ClampMin = "1"))
+	int32 MinCorridorLength = 2;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout|Corridors", meta = (ClampMin = "1"))
+	int32 MaxCorridorLength = 6;
+
+	/* Empty cells kept around every room footprint (walls included) against unrelated rooms and corridors */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout", meta = (ClampMin = "0"))
+	int32 RoomPadding = 1;
+
+	/* Chance that two neighbouring rooms with facing free walls get an extra connection (makes loops) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout|Corridors", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float LoopChance = 0.15f;
+
+	/* Placement attempts per room before the layout gives up on it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout|Advanced", meta = (ClampMin = "1"))
+	int32 MaxPlacementAttempts = 32;
+
+	/* Spatial hash bucket edge length in cells (roughly the largest room size works well) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Layout|Advanced", meta = (ClampMin = "4"))
+	int32 SpatialHashBucketSize = 32;
+};
+
+/* One placed room (dungeon grid coordinates; the wall ring sits one cell outside the interior) */
+USTRUCT(BlueprintType)
+struct FDungeonRoomNode
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	URoomData* RoomData = nullptr;
+
+	/* Dungeon cell of the room's interior cell (0, 0) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	FIntPoint GridOrigin = FIntPoint::ZeroValue;
+
+	/* Interior size in cells */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+
+	/* Room seed (derived from the layout seed and room index) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	int32 Seed = 0;
+
+	/* Connections from the first room */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	int32 Depth = 0;
+
+	/* Doorways in room-local edge/cell terms, one per connection */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	TArray<FDoorwayLayoutInfo> Doorways;
+
+	/* Indices into FDungeonLayout::Connections */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	TArray<int32> Connections;
+
+	/* Interior plus wall ring (Min inclusive, Max exclusive) */
+	FIntRect GetFootprint() const { return FIntRect(GridOrigin - FIntPoint(1, 1), GridOrigin + GridSize + FIntPoint(1, 1)); }
+};
+
+/* Graph edge: a doorway of one room facing a doorway of another across a corridor */
+USTRUCT(BlueprintType)
+struct FDungeonConnection
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	int32 RoomA = INDEX_NONE;
+
+	/* Index into RoomA's Doorways */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	int32 DoorwayA = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	int32 RoomB = INDEX_NONE;
+
+	/* Index into RoomB's Doorways */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	int32 DoorwayB = INDEX_NONE;
+
+	/* Extra edge added after the spanning tree */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	bool bIsLoop = false;
+};
+
+/* Generated room graph */
+USTRUCT(BlueprintType)
+struct FDungeonLayout
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	TArray<FDungeonRoomNode> Rooms;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	TArray<FDungeonConnection> Connections;
+
+	/* Cells covered by all room footprints and corridor reservations (Min inclusive, Max exclusive) */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	FIntRect Bounds;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Dungeon Layout")
+	int32 Seed = 0;
+};
+
 /**
- * 
+ * DungeonGenerator - Places rooms of varied RoomData and size on a dungeon-scale cell grid
+ * Grows a spanning tree outward from the first room: each new room is attached across a free wall of a placed room,
+ * with the two doorways aligned so a straight corridor joins them. Overlap tests go through a uniform spatial hash,
+ * so every attempt costs the same however many rooms are already placed. Loop connections are added afterwards
+ * between neighbours whose free walls face each other. Pure layout: no assets are loaded and nothing is spawned.
  */
-UCLASS()
+UCLASS(BlueprintType)
 class CLAUDEDUNGAI_API UDungeonGenerator : public UObject
 {
 	GENERATED_BODY()
+
+public:
+#pragma region Layout Generation
+	/* Build a new room graph; same settings + same seed = same layout.
+	 * Returns false if no room could be placed (rooms that did not fit are logged and skipped). */
+	bool GenerateLayout(const FDungeonLayoutSettings& Settings, int32 Seed);
+
+	/* Last generated layout */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generator")
+	const FDungeonLayout& GetLayout() const { return Layout; }
+
+	UFUNCTION(BlueprintCallable, Category = "Dungeon Generator")
+	void ClearLayout();
+#pragma endregion
+
+#pragma region Coordinate Conversion
+	/* Seed for the room at RoomIndex of a layout generated with LayoutSeed */
+	static int32 DeriveRoomSeed(int32 LayoutSeed, int32 RoomIndex);
+
+	/* Dungeon cell of a doorway's ring cell (Offset 0 .. WidthInCells-1 along the edge) */
+	static FIntPoint GetDoorwayDungeonCell(const FDungeonRoomNode& Room, const FDoorwayLayoutInfo& Doorway, int32 Offset);
+
+	/* Dungeon cell one step outward from a ring cell on the given edge */
+	static FIntPoint GetEdgeOutwardStep(EWallEdge Edge);
+
+	/* Edge facing the given one */
+	static EWallEdge GetOppositeEdge(EWallEdge Edge);
+#pragma endregion
+
+private:
+#pragma region Internal Helpers
+	/* Try to attach one new room across Edge of ParentIndex; returns the new room index or INDEX_NONE */
+	int32 TryAttachRoom(int32 ParentIndex, EWallEdge Edge, const FDungeonRoomTemplate& Template, const FDungeonLayoutSettings& Settings,
+		FDungeonSpatialHash& SpatialHash, FRandomStream& Stream);
+
+	/* Link neighbours whose free walls face each other across a clear straight corridor */
+	int32 AddLoopConnections(const FDungeonLayoutSettings& Settings, FDungeonSpatialHash& SpatialHash, FRandomStream& Stream);
+
+	/* Append a doorway pair + connection and mark both edges used */
+	void AddConnection(int32 RoomA, EWallEdge EdgeA, int32 RoomB, int32 LateralStart, int32 Width, bool bIsLoop);
+
+	/* Doorway width two rooms can share (smaller of the two standard widths) */
+	static int32 GetSharedDoorwayWidth(const FDungeonRoomNode& A, const FDungeonRoomNode& B);
+#pragma endregion
+
+#pragma region Internal Data
+	UPROPERTY()
+	FDungeonLayout Layout;
+
+	// Per room: bit (1 << EWallEdge) set once that wall carries a doorway (one connection per wall)
+	TArray<uint8> UsedEdgeMasks;
+#pragma endregion
 };
@@ -0,0 +1,305 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+#include "Data/Grid/GridOccupancy.h"
+#include "Data/Grid/FreeRectIndex.h"
+#include "Generators/Room/RoomGenerationSnapshot.h"
+#include "Misc/MemStack.h"
+
+// Temporary array of a generation pass: memory comes from the running thread's FMemStack (so parallel jobs never
+// share it) and is released in one shot when the enclosing FMemMark goes out of scope
+template <typename ElementType>
+using TRoomScratchArray = TArray<ElementType, TMemStackAllocator<>>;
+
+// Base wall segment tracked between the base pass and the Middle/Top stacking passes
+struct FGeneratorWallSegment
+{
+	EWallEdge Edge = EWallEdge::North;
+	int32 StartCell = 0;
+	int32 SegmentLength = 0;
+	FTransform BaseTransform;
+	const FRoomSnapshotWallModule* WallModule = nullptr;  // Points into SourceSnapshot for Middle/Top
+
+	// Snapshot WallModule lives in; held so a later RefreshSnapshot cannot free it before the Middle/Top passes run
+	TSharedPtr<const FRoomGenerationSnapshot> SourceSnapshot;
+};
+
+/**
+ * RoomGenerationCore - Plain C++ room generation (grid, floor, walls, corners, doorways, ceiling)
+ * Reads only an immutable FRoomGenerationSnapshot and owns all of its mutable state, so one instance
+ * can run on a worker thread while others run elsewhere. Nothing here loads assets or touches UObjects.
+ * URoomGenerator wraps one of these for the editor/game-thread API.
+ */
+class CLAUDEDUNGAI_API FRoomGenerationCore
+{
+public:
+	FRoomGenerationCore();
+
+#pragma region Initialization
+	/* Set grid size and seed; generation phases need a snapshot before they do anything */
+	void Initialize(FIntPoint InGridSize, int32 InSeed = 0);
+	bool IsInitialized() const { return bIsInitialized; }
+
+	/* Swap in the data the next phases read (snapshot must outlive any running phase) */
+	void SetSnapshot(TSharedPtr<const FRoomGenerationSnapshot> InSnapshot);
+	const FRoomGenerationSnapshot* GetSnapshot() const { return Snapshot.Get(); }
+
+	/* Change the room seed and re-derive all phase streams */
+	void SetSeed(int32 InSeed);
+	int32 GetSeed() const { return RoomSeed; }
+
+	/* Stream reserved for clutter placement (independent of the other phases) */
+	const FRandomStream& GetClutterStream() const { return ClutterStream; }
+
+	/* Run every layout phase in dependency order: grid, floor, walls (doorways first), corners, ceiling */
+	bool GenerateAll();
+
+	/* Meshes referenced by the placement records' mesh ids (grows for the core's lifetime) */
+	const FRoomMeshPalette& GetMeshPalette() const { return MeshPalette; }
+#pragma endregion
+
+#pragma region Instance Buffers
+	/* When set, GenerateAll also packs the SoA instance buffers before returning (i.e. on the worker for async jobs),
+	 * so the spawner hands them to AddInstances without repacking */
+	void SetEmitInstanceBuffers(bool bEnable) { bEmitInstanceBuffers = bEnable; }
+	bool IsEmittingInstanceBuffers() const { return bEmitInstanceBuffers; }
+
+	/* Room-space transforms per mesh id for one category; repacked from the placement records only if they changed */
+	const FMeshInstanceBuffers& GetFloorInstances() const;
+	const FMeshInstanceBuffers& GetWallInstances() const;
+	const FMeshInstanceBuffers& GetCornerInstances() const;
+	const FMeshInstanceBuffers& GetCeilingInstances() const;
+
+	/* Repack every category whose placement records changed */
+	void PackInstanceBuffers() const;
+#pragma endregion
+
+#pragma region Room Grid Management
+	void CreateGrid();
+	void ClearGrid();
+	void ResetGridCellStates();
+	const TArray<EGridCellType>& GetGridState() const { return GridState; }
+	FIntPoint GetGridSize() const { return GridSize; }
+	float GetCellSize() const { return CellSize; }
+	EGridCellType GetCellState(FIntPoint GridCoord) const;
+	bool SetCellState(FIntPoint GridCoord, EGridCellType NewState);
+	bool IsValidGridCoordinate(FIntPoint GridCoord) const;
+	bool IsAreaAvailable(FIntPoint StartCoord, FIntPoint Size) const;
+	bool MarkArea(FIntPoint StartCoord, FIntPoint Size, EGridCellType CellType);
+	bool ClearArea(FIntPoint StartCoord, FIntPoint Size);
+#pragma endregion
+
+#pragma region RoomPreset Layout Management
+	bool IsUsingPresetLayout() const;
+
+	/* Highest-priority preset region containing the cell (nullptr if none or not using a preset) */
+	const FPresetRegion* GetRegionAtCoordinate(FIntPoint GridCoordinate) const;
+#pragma endregion
+
+#pragma region Floor Generation
+	bool GenerateFloor();
+	const TArray<FPlacedMeshInfo>& GetPlacedFloorMeshes() const { return PlacedFloorMeshes; }
+	void ClearPlacedFloorMeshes();
+	void GetFloorStatistics(int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles) const;
+	int32 ExecuteForcedPlacements();
+	int32 FillRemainingGaps(int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+	TArray<FIntPoint> ExpandForcedEmptyRegions() const;
+	void MarkForcedEmptyCells(TConstArrayView<FIntPoint> EmptyCells);
+#pragma endregion
+
+#pragma region Wall Generation
+	bool GenerateWalls();
+	const TArray<FPlacedWallInfo>& GetPlacedWalls() const { return PlacedWallMeshes; }
+	int32 ExecuteForcedWallPlacements();
+	bool IsCellRangeOccupied(EWallEdge Edge, int32 StartCell, int32 Length) const;
+	void ClearPlacedWalls();
+	void SpawnMiddleWallLayers();
+	void SpawnTopWallLayer();
+#pragma endregion
+
+#pragma region Corner Generation
+	bool GenerateCorners();
+	const TArray<FPlacedCornerInfo>& GetPlacedCorners() const { return PlacedCornerMeshes; }
+	void ClearPlacedCorners();
+#pragma endregion
+
+#pragma region Doorway Generation
+	bool GenerateDoorways();
+	void MarkDoorwayCells();
+	bool IsCellPartOfDoorway(FIntPoint Cell) const;
+
+	/* True if any cell of [StartCell, StartCell + Length) on the edge belongs to a doorway (one mask test) */
+	bool DoesEdgeSpanOverlapDoorway(EWallEdge Edge, int32 StartCell, int32 Length) const;
+	const TArray<FPlacedDoorwayInfo>& GetPlacedDoorways() const { return PlacedDoorwayMeshes; }
+	void ClearPlacedDoorways();
+
+	/* Use these doorways instead of the snapshot's forced/automatic ones (a dungeon layout decides where rooms connect);
+	 * GenerateDoorways then only computes their transforms. Cleared by ClearPlacedDoorways. */
+	void SetDoorwayLayouts(TArray<FDoorwayLayoutInfo> InLayouts);
+#pragma endregion
+
+#pragma region Ceiling Generation
+	bool GenerateCeiling();
+	int32 ExecuteForcedCeilingPlacements(FGridOccupancy& CeilingOccupied);
+	const TArray<FPlacedCeilingInfo>& GetPlacedCeilingTiles() const { return PlacedCeilingTiles; }
+	void ClearPlacedCeiling() { PlacedCeilingTiles.Empty(); bCeilingInstancesDirty = true; }
+#pragma endregion
+
+#pragma region Coordinate Conversion
+	FVector GridToLocalPosition(FIntPoint GridCoord) const;
+	FIntPoint LocalToGridPosition(FVector LocalPos) const;
+	static FIntPoint GetRotatedFootprint(FIntPoint OriginalFootprint, int32 Rotation);
+#pragma endregion
+
+#pragma region Room Statistics
+	int32 GetCellCountByType(EGridCellType CellType) const;
+	float GetOccupancyPercentage() const;
+	int32 GetTotalCellCount() const { return GridSize.X * GridSize.Y; }
+#pragma endregion
+
+private:
+#pragma region Internal Data
+	// Resolved room configuration (shared, never mutated)
+	TSharedPtr<const FRoomGenerationSnapshot> Snapshot;
+
+	// Grid dimensions in cells
+	FIntPoint GridSize;
+
+	// Cell size in cm (from CELL_SIZE constant)
+	float CellSize;
+
+	// Initialization flag
+	bool bIsInitialized;
+
+	// Room seed all phase streams are derived from
+	int32 RoomSeed;
+
+	// Independent per-phase streams; each phase resets its own stream on entry so it can be
+	// regenerated (or run on another thread) without disturbing the others
+	FRandomStream FloorStream;
+	FRandomStream WallStream;
+	FRandomStream DoorwayStream;
+	FRandomStream CeilingStream;
+	FRandomStream ClutterStream;
+
+	// Grid state array (row-major order: Index = Y * GridSize.X + X)
+	TArray<EGridCellType> GridState;
+
+	// Bit-packed mirror of GridState (set = non-empty), used for fast area tests
+	FGridOccupancy OccupancyMask;
+
+	// Maximal empty rectangles of OccupancyMask, updated on placement and rebuilt lazily by fill passes
+	FFreeRectIndex FreeRectIndex;
+
+	// Placement output
+	TArray<FPlacedMeshInfo> PlacedFloorMeshes;
+	TArray<FPlacedWallInfo> PlacedWallMeshes;
+	TArray<FPlacedCornerInfo> PlacedCornerMeshes;
+	TArray<FPlacedDoorwayInfo> PlacedDoorwayMeshes;
+	TArray<FPlacedCeilingInfo> PlacedCeilingTiles;
+
+	// Mesh ids used by the placement output; never reset, so records from separately regenerated phases agree
+	FRoomMeshPalette MeshPalette;
+
+	// Pack instance buffers at the end of GenerateAll
+	bool bEmitInstanceBuffers;
+
+	// SoA views of the placement output, rebuilt lazily when the matching dirty flag is set
+	mutable FMeshInstanceBuffers FloorInstances;
+	mutable FMeshInstanceBuffers WallInstances;
+	mutable FMeshInstanceBuffers CornerInstances;
+	mutable FMeshInstanceBuffers CeilingInstances;
+	mutable bool bFloorInstancesDirty;
+	mutable bool bWallInstancesDirty;
+	mutable bool bCornerInstancesDirty;
+	mutable bool bCeilingInstancesDirty;
+
+	// Cells GenerateCeiling must leave empty (set on region cores for cells their region does not own)
+	FGridOccupancy ReservedCeilingCells;
+
+	// Tracked base wall segments for Middle/Top spawning
+	TArray<FGeneratorWallSegment> PlacedBaseWallSegments;
+
+	// One single-row mask per wall edge (bit = edge cell covered by a tracked base segment), kept in step by TrackBaseWallSegment
+	FGridOccupancy WallEdgeMasks[4];
+
+	// Statistics tracking
+	int32 LargeTilesPlaced;
+	int32 MediumTilesPlaced;
+	int32 SmallTilesPlaced;
+	int32 FillerTilesPlaced;
+
+	// Cached doorway layouts (persistent until ClearPlacedDoorways)
+	TArray<FDoorwayLayoutInfo> CachedDoorwayLayouts;
+
+	// One single-row mask per wall edge (bit = edge cell covered by a doorway), rebuilt by MarkDoorwayCells
+	FGridOccupancy DoorwayEdgeMasks[4];
+
+	// Helper to calculate transforms from layout
+	FPlacedDoorwayInfo CalculateDoorwayTransforms(const FDoorwayLayoutInfo& Layout) const;
+#pragma endregion
+
+#pragma region Internal Floor Generation Functions
+	/* Fill grid with tiles of one oriented footprint, drawing from the snapshot's footprint bucket */
+	void FillWithTileSize(FIntPoint TargetSize, int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+
+	/* Fill grid in one row-major sweep over the free cells, placing the largest pool footprint that fits at each free cell */
+	int32 FillSinglePass(int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+
+	/* Select a mesh from the floor pool using the bucket's alias table (nullptr if bucket is empty) */
+	const FMeshPlacementInfo* SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool, const FFloorFootprintBucket& Bucket) const;
+
+	/* Mark area and record the placement */
+	bool TryPlaceMesh(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation = 0);
+
+	/* Footprint size in cells */
+	FIntPoint CalculateFootprint(const FMeshPlacementInfo& MeshInfo) const;
+
+	/* ExpandForcedEmptyRegions into a caller-owned array (phase scratch inside GenerateFloor; defined in the .cpp) */
+	template <typename AllocatorType>
+	void ExpandForcedEmptyRegions(TArray<FIntPoint, AllocatorType>& OutCells) const;
+#pragma endregion
+
+#pragma region Internal Preset Region Generation
+	/* Core for one styled preset region: the region snapshot as its room, seeded from the room seed and region index */
+	TUniquePtr<FRoomGenerationCore> CreateRegionCore(const FRoomSnapshotRegionStyle& Style) const;
+
+	/* Pack each styled region's still-free owned cells in parallel, then merge the results in region order */
+	int32 GeneratePresetRegionFloors();
+
+	/* Same for ceilings; region tiles are marked in CeilingOccupied so the default passes only fill the remainder */
+	int32 GeneratePresetRegionCeilings(FGridOccupancy& CeilingOccupied);
+#pragma endregion
+
+#pragma region Internal Helpers
+	int32 GridCoordToIndex(FIntPoint GridCoord) const;
+	FIntPoint IndexToGridCoord(int32 Index) const;
+
+	/* Fill one edge with wall modules using greedy bin packing (or the DP packer when the style asks for it) */
+	void FillWallEdge(EWallEdge Edge);
+
+	/* Fill each free run of one edge with the snapshot's DP packing (fewest holes, then fewest modules) */
+	void FillWallEdgeOptimal(EWallEdge Edge);
+
+	/* Track a base wall module placed at StartCell on the edge */
+	void PlaceBaseWallModule(EWallEdge Edge, int32 StartCell, const FRoomSnapshotWallModule& Resolved, const FRotator& WallRotation);
+
+	/* Record a base wall segment and mark its cells in the edge mask */
+	void TrackBaseWallSegment(const FGeneratorWallSegment& Segment);
+
+	/* Drop all tracked base segments and clear the wall edge masks */
+	void ResetBaseWallSegments();
+
+	/* Size a set of per-edge masks to their edge lengths with every cell free */
+	void InitEdgeMasks(FGridOccupancy (&EdgeMasks)[4]) const;
+
+	/* True if [StartCell, StartCell + Length), clipped to the edge, touches a set bit (uninitialized mask = none) */
+	static bool DoesEdgeMaskOverlap(const FGridOccupancy& EdgeMask, int32 StartCell, int32 Length);
+
+	/* Slot of an edge in the per-edge arrays (INDEX_NONE for EWallEdge::None) */
+	static int32 GetEdgeSlot(EWallEdge Edge) { return Edge == EWallEdge::None ? INDEX_NONE : static_cast<int32>(Edge) - 1; }
+#pragma endregion
+};
@@ -0,0 +1,200 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Grid/GridData.h"
+#include "Data/Presets/RoomPreset.h"
+#include "Data/Room/CeilingData.h"
+#include "Data/Room/FloorData.h"
+#include "Data/Room/WallData.h"
+#include "Utilities/Helpers/WeightedAliasTable.h"
+
+class URoomData;
+class UDoorData;
+struct FRoomGenerationSnapshot;
+
+/* Wall module plus the mesh-dependent values the generator needs, resolved on the game thread */
+struct FRoomSnapshotWallModule
+{
+	// Module as authored (soft references are carried through to placement records untouched)
+	FWallModule Module;
+
+	// Which layer meshes resolved to a loaded asset
+	bool bBaseMeshLoaded = false;
+	bool bMiddleMesh1Loaded = false;
+	bool bMiddleMesh2Loaded = false;
+	bool bTopMeshLoaded = false;
+
+	// "TopBackCenter" socket of each layer, relative to that layer (WallHeight fallback when missing)
+	FTransform BaseTopSocket = FTransform::Identity;
+	FTransform Middle1TopSocket = FTransform::Identity;
+	FTransform Middle2TopSocket = FTransform::Identity;
+};
+
+/* Values read from a UDoorData during doorway layout */
+struct FRoomSnapshotDoorStyle
+{
+	int32 TotalDoorwayWidth = 0;
+	int32 FrameFootprintY = 0;
+	EDoorwaySideFill SideFillType = EDoorwaySideFill::None;
+	FRotator FrameRotationOffset = FRotator::ZeroRotator;
+
+	FDoorPositionOffsets NorthEdgeOffsets;
+	FDoorPositionOffsets SouthEdgeOffsets;
+	FDoorPositionOffsets EastEdgeOffsets;
+	FDoorPositionOffsets WestEdgeOffsets;
+
+	/* Same mapping as UDoorData::GetOffsetsForEdge */
+	FDoorPositionOffsets GetOffsetsForEdge(EWallEdge Edge) const;
+};
+
+/* Preset region with a style of its own, generated as a small room of its own (possibly on another thread) */
+struct FRoomSnapshotRegionStyle
+{
+	// Index into PresetRegions (and value of its cells in PresetRegionRaster)
+	int32 RegionIndex = INDEX_NONE;
+
+	// Room cell the region snapshot's (0,0) maps to; its GridSize is the region clamped to the room
+	FIntPoint Origin = FIntPoint::ZeroValue;
+
+	// Floor and/or ceiling style of the region (bHasFloorStyle / bHasCeilingStyle say which)
+	TSharedPtr<const FRoomGenerationSnapshot> Snapshot;
+};
+
+/**
+ * RoomGenerationSnapshot - Immutable, pre-resolved copy of everything room generation reads from URoomData
+ * Built on the game thread (this is the only place soft references are loaded); afterwards it holds no
+ * UObject it dereferences, so FRoomGenerationCore can run against it on any thread.
+ * UDoorData pointers are kept only as identity keys and are copied into placement records for the spawner.
+ */
+struct CLAUDEDUNGAI_API FRoomGenerationSnapshot
+{
+public:
+	/* Resolve RoomData and its style assets (game thread only) */
+	bool Build(URoomData* RoomData, FIntPoint InGridSize);
+
+	/* Style values for a door asset, or nullptr if it was not referenced by RoomData */
+	const FRoomSnapshotDoorStyle* FindDoorStyle(const UDoorData* DoorData) const { return DoorStyles.Find(DoorData); }
+
+	FIntPoint GridSize = FIntPoint::ZeroValue;
+	float CellSize = CELL_SIZE;
+
+#pragma region Preset Layout
+	bool bUsePresetLayout = false;
+	TArray<FPresetRegion> PresetRegions;
+
+	// One entry per grid cell (row-major): index into PresetRegions with FillPriority already applied, or URoomPreset::NoRegion
+	TArray<uint8> PresetRegionRaster;
+
+	/* Winning preset region for an in-grid cell (one array read), or nullptr */
+	const FPresetRegion* GetPresetRegionAt(FIntPoint GridCoordinate) const
+	{
+		const int32 CellIndex = GridCoordinate.Y * GridSize.X + GridCoordinate.X;
+		if (!PresetRegionRaster.IsValidIndex(CellIndex)) return nullptr;
+
+		const uint8 RegionIndex = PresetRegionRaster[CellIndex];
+		return RegionIndex == URoomPreset::NoRegion ? nullptr : &PresetRegions[RegionIndex];
+	}
+
+	// Regions whose RegionFloorStyle or RegionCeilingStyle resolved; cells outside them use the default style below
+	TArray<FRoomSnapshotRegionStyle> PresetRegionStyles;
+#pragma endregion
+
+#pragma region Floor
+	bool bHasFloorStyle = false;
+	bool bUseSinglePassPacker = false;
+	TArray<FMeshPlacementInfo> FloorTilePool;
+
+	// Copy of UFloorData's cached buckets (indices into FloorTilePool)
+	TMap<FIntPoint, FFloorFootprintBucket> FloorFootprintBuckets;
+
+	TMap<FIntPoint, FMeshPlacementInfo> ForcedFloorPlacements;
+	TArray<FForcedEmptyRegion> ForcedEmptyRegions;
+	TArray<FIntPoint> ForcedEmptyFloorCells;
+#pragma endregion
+
+#pragma region Walls
+	bool bHasWallStyle = false;
+	TArray<FRoomSnapshotWallModule> WallModules;
+
+	// Copy of UWallData's cached module sampler (indices into WallModules)
+	FWeightedAliasTable WallModuleSampler;
+
+	// DP wall packing (UWallData::bUseOptimalPacker): per-footprint samplers and the packing table,
+	// copied from UWallData's shared memo after it was extended to the longest edge of this room
+	bool bUseOptimalWallPacker = false;
+	TMap<int32, FWallFootprintBucket> WallFootprintBuckets;
+	FWallRunPacker WallRunPacker;
+
+	float NorthWallOffsetX = 0.0f;
+	float SouthWallOffsetX = 0.0f;
+	float EastWallOffsetY = 0.0f;
+	float WestWallOffsetY = 0.0f;
+	float WallHeight = 100.0f;
+
+	// Forced walls and their resolved modules (parallel arrays)
+	TArray<FForcedWallPlacement> ForcedWallPlacements;
+	TArray<FRoomSnapshotWallModule> ForcedWallModules;
+#pragma endregion
+
+#pragma region Corners
+	TSoftObjectPtr<UStaticMesh> DefaultCornerMesh;
+	bool bCornerMeshLoaded = false;
+
+	FVector SouthWestCornerOffset = FVector::ZeroVector;
+	FVector SouthEastCornerOffset = FVector::ZeroVector;
+	FVector NorthEastCornerOffset = FVector::ZeroVector;
+	FVector NorthWestCornerOffset = FVector::ZeroVector;
+	FRotator SouthWestCornerRotation = FRotator::ZeroRotator;
+	FRotator SouthEastCornerRotation = FRotator::ZeroRotator;
+	FRotator NorthEastCornerRotation = FRotator::ZeroRotator;
+	FRotator NorthWestCornerRotation = FRotator::ZeroRotator;
+#pragma endregion
+
+#pragma region Doorways
+	TArray<FFixedDoorLocation> ForcedDoorways;
+	UDoorData* DefaultDoorData = nullptr;
+	bool bGenerateStandardDoorway = false;
+	bool bSetStandardDoorwayEdge = false;
+	EWallEdge StandardDoorwayEdge = EWallEdge::North;
+	bool bMultipleDoorways = false;
+	int32 NumAutomaticDoorways = 2;
+	int32 StandardDoorwayWidth = 4;
+
+	// Every door asset RoomData references (default + forced)
+	TMap<const UDoorData*, FRoomSnapshotDoorStyle> DoorStyles;
+#pragma endregion
+
+#pragma region Ceiling
+	bool bHasCeilingStyle = false;
+	TArray<FCeilingTile> LargeTilePool;
+	TArray<FCeilingTile> MediumTilePool;
+	TArray<FCeilingTile> SmallTilePool;
+	FWeightedAliasTable LargeTileSampler;
+	FWeightedAliasTable MediumTileSampler;
+	FWeightedAliasTable SmallTileSampler;
+	float CeilingHeight = 0.0f;
+	FRotator CeilingRotation = FRotator::ZeroRotator;
+
+	// Forced ceiling tiles and whether each tile mesh loaded (parallel arrays)
+	TArray<FForcedCeilingPlacement> ForcedCeilingPlacements;
+	TArray<bool> ForcedCeilingMeshLoaded;
+#pragma endregion
+
+private:
+	/* Copy a floor style's pool and cached buckets (clears them for null) */
+	void ResolveFloorStyle(UFloorData* FloorData);
+
+	/* Copy a ceiling style's pools, cached samplers and placement settings (clears them for null) */
+	void ResolveCeilingStyle(UCeilingData* CeilingData);
+
+	/* Resolve the preset's regions into PresetRegionStyles (one region snapshot per styled region) */
+	void ResolvePresetRegionStyles();
+
+	/* Load a module's layer meshes and capture their stacking sockets (through WallData's socket cache when available) */
+	FRoomSnapshotWallModule ResolveWallModule(const FWallModule& Module, const FString& ContextName, const UWallData* WallData) const;
+
+	/* Record the style values of a door asset (no-op for null or already recorded) */
+	void AddDoorStyle(const UDoorData* DoorData);
+};
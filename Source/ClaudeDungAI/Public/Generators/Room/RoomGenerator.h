@@ -5,88 +5,83 @@
 #include "CoreMinimal.h"
 #include "Data/Grid/GridData.h"
 #include "Data/Room/RoomData.h"
+#include "Engine/StreamableManager.h"
 #include "RoomGenerator.generated.h"
 
-/* Struct to track placed mesh information */
-USTRUCT()
-struct FPlacedMeshInfo
-{
-	GENERATED_BODY()
+class FRoomGenerationCore;
+struct FGridOccupancy;
+struct FRoomGenerationSnapshot;
 
-	// Grid position (top-left cell)
-	UPROPERTY()
-	FIntPoint GridPosition;
+// Fired on the game thread when GenerateAllAsync finishes (results are already swapped in)
+DECLARE_DELEGATE_OneParam(FOnRoomLayoutGenerated, bool /*bSuccess*/);
 
-	// Size in cells
-	UPROPERTY()
-	FIntPoint Size;
+// Fired on the game thread when PreloadAssetsAsync finishes (false if any referenced asset failed to load)
+DECLARE_DELEGATE_OneParam(FOnRoomAssetsPreloaded, bool /*bAllLoaded*/);
 
-	// Rotation angle (0, 90, 180, 270)
-	UPROPERTY()
-	int32 Rotation;
+/* RoomGenerator - Game-thread wrapper around FRoomGenerationCore
+ * Resolves RoomData into an immutable snapshot (the only place assets are loaded), then forwards to the core.
+ * GenerateAllAsync runs the whole layout on a worker task and swaps the result back in on the game thread. */
+UCLASS()
+class CLAUDEDUNGAI_API URoomGenerator : public UObject
+{
+	GENERATED_BODY()
 
-	// Mesh placement info from data asset
-	UPROPERTY()
-	FMeshPlacementInfo MeshInfo;
+public:
+	URoomGenerator();
 
-	// World transform for spawning
-	UPROPERTY()
-	FTransform WorldTransform;
+#pragma region Initialization
+	/* Initialize the room generator with room data
+	 * Seed drives every random choice; same seed + same RoomData = same room */
+	bool Initialize(URoomData* InRoomData, FIntPoint InGridSize, int32 InSeed = 0);
+	UFUNCTION(BlueprintPure, Category = "Room Generator")
+	bool IsInitialized() const { return bIsInitialized; }
 
-	FPlacedMeshInfo() : GridPosition(FIntPoint:: ZeroValue), Size(FIntPoint::ZeroValue), Rotation(0) {}
-};
+	/* Change the room seed and re-derive all phase streams */
+	void SetSeed(int32 InSeed);
 
-// Wall segment tracking structure (matches MasterRoom's FWallSegmentInfo)
-USTRUCT()
-struct FGeneratorWallSegment
-{
-	GENERATED_BODY()
+	UFUNCTION(BlueprintPure, Category = "Room Generator")
+	int32 GetSeed() const { return RoomSeed; }
 
-	EWallEdge Edge;
-	int32 StartCell;
-	int32 SegmentLength;
-	FTransform BaseTransform;
-	UStaticMesh* BaseMesh;
-	const FWallModule* WallModule;  // Reference to module for Middle/Top
+	/* Stream reserved for clutter placement (independent of the other phases) */
+	const FRandomStream& GetClutterStream() const;
+#pragma endregion
 
-	FGeneratorWallSegment() : Edge(EWallEdge::North), StartCell(0), SegmentLength(0), BaseMesh(nullptr), WallModule(nullptr) {}
-};
+#pragma region Background Generation
+	/* Stream in every style asset and mesh RoomData can reach, one batched request per dependency level
+	 * (styles, then preset region styles, then all meshes). Later snapshot builds find everything resident.
+	 * Replaces the previous preload's handles once it completes. Returns false if there is no RoomData or a preload
+	 * is already running. */
+	bool PreloadAssetsAsync(FOnRoomAssetsPreloaded OnComplete);
 
-/* Information about a placed ceiling tile */
-USTRUCT(BlueprintType)
-struct FPlacedCeilingInfo
-{
-	GENERATED_BODY()
+	/* True while a PreloadAssetsAsync request is in flight */
+	UFUNCTION(BlueprintPure, Category = "Room Generator")
+	bool IsPreloadingAssets() const { return bPreloadPending; }
 
-	/* Grid coordinate (top-left cell) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ceiling")
-	FIntPoint GridCoordinate = FIntPoint(0, 0);
+	/* Drop the preload handles; assets stay loaded only while something else references them */
+	void ReleasePreloadedAssets();
 
-	/* Tile size in cells (e.g., 4x4, 2x2, 1x1) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ceiling")
-	FIntPoint TileSize = FIntPoint(1, 1);
+	/* Preload RoomData's assets, snapshot it, then create the grid and generate floor, walls, doorways, corners
+	 * and ceiling on a worker task. Returns false if not initialized or a generation is already running. */
+	bool GenerateAllAsync(FOnRoomLayoutGenerated OnComplete);
 
-	/* Static mesh to use */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ceiling")
-	TSoftObjectPtr<UStaticMesh> Mesh;
+	/* True while a GenerateAllAsync job is in flight */
+	UFUNCTION(BlueprintPure, Category = "Room Generator")
+	bool IsGeneratingAsync() const { return bAsyncGenerationPending; }
 
-	/* World transform (component-space, relative to room) */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ceiling")
-	FTransform Transform = FTransform::Identity;
-};
+	/* Plain generation core (valid for the generator's lifetime) */
+	FRoomGenerationCore& GetCore() const { return *Core; }
 
-/* RoomGenerator - Pure logic class for room generation Handles grid creation, mesh placement algorithms, and room data processing */
-UCLASS()
-class CLAUDEDUNGAI_API URoomGenerator : public UObject
-{
-	GENERATED_BODY()
+	/* Meshes the placement records' mesh ids refer to */
+	const FRoomMeshPalette& GetMeshPalette() const;
 
-public:
-#pragma region Initialization
-	/* Initialize the room generator with room data */
-	bool Initialize(URoomData* InRoomData, FIntPoint InGridSize);
-	UFUNCTION(BlueprintPure, Category = "Room Generator")
-	bool IsInitialized() const { return bIsInitialized; }
+	/* Have GenerateAll/GenerateAllAsync pack the SoA instance buffers on the generating thread */
+	void SetEmitInstanceBuffers(bool bEnable);
+
+	/* Room-space transforms per palette mesh id, one contiguous array per mesh (repacked only after the layout changed) */
+	const FMeshInstanceBuffers& GetFloorInstances() const;
+	const FMeshInstanceBuffers& GetWallInstances() const;
+	const FMeshInstanceBuffers& GetCornerInstances() const;
+	const FMeshInstanceBuffers& GetCeilingInstances() const;
 #pragma endregion
 	
 #pragma region Room Grid Management
@@ -96,7 +91,7 @@ public:
 	void ClearGrid();
 	UFUNCTION(BlueprintCallable, Category = "Room Generator")
 	void ResetGridCellStates();
-	const TArray<EGridCellType>& GetGridState() const { return GridState; }
+	const TArray<EGridCellType>& GetGridState() const;
 	FIntPoint GetGridSize() const { return GridSize; }
 	float GetCellSize() const { return CellSize; }
 	EGridCellType GetCellState(FIntPoint GridCoord) const;
@@ -131,7 +126,7 @@ public:
 	virtual bool GenerateFloor();
 
 	/* Get list of placed floor meshes */
-	const TArray<FPlacedMeshInfo>& GetPlacedFloorMeshes() const { return PlacedFloorMeshes; }
+	const TArray<FPlacedMeshInfo>& GetPlacedFloorMeshes() const;
 
 	/* Clear all placed floor meshes */
 	void ClearPlacedFloorMeshes();
@@ -144,8 +139,7 @@ public:
 	int32 ExecuteForcedPlacements();
 
 	/* Fill remaining empty cells with meshes from the pool */
-	int32 FillRemainingGaps(const TArray<FMeshPlacementInfo>& TilePool, int32& OutLargeTiles,
-	int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles); 
+	int32 FillRemainingGaps(int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
 	
 	/**
 	 * Expand forced empty regions into individual cell list
@@ -162,7 +156,7 @@ public:
 	bool GenerateWalls();
 
 	/* Get list of placed walls */
-	const TArray<FPlacedWallInfo>& GetPlacedWalls() const { return PlacedWallMeshes; }
+	const TArray<FPlacedWallInfo>& GetPlacedWalls() const;
 
 	int32 ExecuteForcedWallPlacements();
 
@@ -185,7 +179,7 @@ public:
 	bool GenerateCorners();
 
 	/* Get list of placed corners */
-	const TArray<FPlacedCornerInfo>& GetPlacedCorners() const { return PlacedCornerMeshes; }
+	const TArray<FPlacedCornerInfo>& GetPlacedCorners() const;
 
 	/* Clear all placed corners */
 	void ClearPlacedCorners();
@@ -204,7 +198,7 @@ public:
 	bool IsCellPartOfDoorway(FIntPoint Cell) const;
 
 	/* Get list of placed doorways */
-	const TArray<FPlacedDoorwayInfo>& GetPlacedDoorways() const { return PlacedDoorwayMeshes; }
+	const TArray<FPlacedDoorwayInfo>& GetPlacedDoorways() const;
 
 	/* Clear all placed doorways */
 	void ClearPlacedDoorways();
@@ -217,14 +211,14 @@ public:
 	bool GenerateCeiling();
 
 	/* Execute forced ceiling placements from RoomData */
-	int32 ExecuteForcedCeilingPlacements(TArray<bool>& CeilingOccupied);
+	int32 ExecuteForcedCeilingPlacements(FGridOccupancy& CeilingOccupied);
 	
 	/* Get placed ceiling tiles (for spawner) */
 	UFUNCTION(BlueprintPure, Category = "Room Generation")
-	const TArray<FPlacedCeilingInfo>& GetPlacedCeilingTiles() const { return PlacedCeilingTiles; }
+	const TArray<FPlacedCeilingInfo>& GetPlacedCeilingTiles() const;
 
 	/* Clear ceiling data */
-	void ClearPlacedCeiling() { PlacedCeilingTiles.Empty(); }
+	void ClearPlacedCeiling();
 #pragma endregion
 	
 #pragma region Coordinate Conversion
@@ -265,95 +259,40 @@ private:
 
 	// Initialization flag
 	bool bIsInitialized;
-	
-	// Grid state array (row-major order: Index = Y * GridSize.X + X)
-	UPROPERTY()
-	TArray<EGridCellType> GridState;
-	
-	// Placed floor meshes
-	UPROPERTY()
-	TArray<FPlacedMeshInfo> PlacedFloorMeshes;
-
-	// Placed walls
-	UPROPERTY()
-	TArray<FPlacedWallInfo> PlacedWallMeshes;
-	// Placed corners
-	UPROPERTY()
-	TArray<FPlacedCornerInfo> PlacedCornerMeshes;
-
-	// Tracked base wall segments for Middle/Top spawning
-	UPROPERTY()
-	TArray<FGeneratorWallSegment> PlacedBaseWallSegments;
-	
-	// Placed doorways
-	UPROPERTY()
-	TArray<FPlacedDoorwayInfo> PlacedDoorwayMeshes;
-	
-	/* Placed ceiling tiles (output of GenerateCeiling) */
-	UPROPERTY()
-	TArray<FPlacedCeilingInfo> PlacedCeilingTiles;
-	
-	// Statistics tracking
-	int32 LargeTilesPlaced;
-	int32 MediumTilesPlaced;
-	int32 SmallTilesPlaced;
-	int32 FillerTilesPlaced;
 
-	// Cached doorway layouts (persistent until ClearRoomGrid)
-	UPROPERTY()
-	TArray<FDoorwayLayoutInfo> CachedDoorwayLayouts;
+	// Room seed all phase streams are derived from
+	int32 RoomSeed;
 
-	// Helper to calculate transforms from layout
-	FPlacedDoorwayInfo CalculateDoorwayTransforms(const FDoorwayLayoutInfo& Layout);
-#pragma endregion
+	// True while a GenerateAllAsync job owns a core of its own
+	bool bAsyncGenerationPending;
 
-#pragma region Internal Floor Generation Functions
-	// ============================================================================
-	// INTERNAL FLOOR GENERATION HELPERS
-	// ============================================================================
+	// Generation state and output; replaced wholesale when an async job completes
+	TSharedPtr<FRoomGenerationCore> Core;
 
-	/**
-	 * Fill grid with tiles of specific size
-	 * @param TilePool - Pool of meshes to choose from
-	 * @param TargetSize - Target size to match (for filtering)
-	 */
-	void FillWithTileSize(const TArray<FMeshPlacementInfo>& TilePool, FIntPoint TargetSize, 
-	int32& OutLargeTiles, int32& OutMediumTiles, int32& OutSmallTiles, int32& OutFillerTiles);
+	// True while PreloadAssetsAsync is waiting on the streamable manager
+	bool bPreloadPending;
 
-	/**
-	 * Select a mesh from pool using weighted random selection
-	 * @param Pool - Pool of meshes with placement weights
-	 * @return Selected mesh info
-	 */
-	FMeshPlacementInfo SelectWeightedMesh(const TArray<FMeshPlacementInfo>& Pool);
+	// Handles keeping preloaded style assets and meshes resident
+	TArray<TSharedPtr<FStreamableHandle>> PreloadHandles;
 
-	/**
-	 * Try to place a mesh at specified location
-	 * @param StartCoord - Grid coordinate to place mesh
-	 * @param Size - Size of mesh in cells
-	 * @param MeshInfo - Mesh placement info
-	 * @param Rotation - Rotation angle
-	 * @return True if placement successful
-	 */
-	bool TryPlaceMesh(FIntPoint StartCoord, FIntPoint Size, const FMeshPlacementInfo& MeshInfo, int32 Rotation = 0);
-
-	/**
-	 * Calculate footprint size in cells from mesh bounds
-	 * @param MeshInfo - Mesh placement info
-	 * @return Footprint size in cells
-	 */
-	FIntPoint CalculateFootprint(const FMeshPlacementInfo& MeshInfo) const;
+	// Style paths already requested this preload (a missing asset must not be re-requested forever)
+	TSet<FSoftObjectPath> RequestedStylePaths;
 #pragma endregion
 
 #pragma region Internal Helpers
-	/* Convert 2D grid coordinate to 1D array index */
-	int32 GridCoordToIndex(FIntPoint GridCoord) const;
+	/* Resolve RoomData into a fresh snapshot (game thread; loads soft references) */
+	TSharedPtr<const FRoomGenerationSnapshot> BuildSnapshot() const;
+
+	/* Rebuild the snapshot and hand it to the core; every generation entry point calls this first */
+	bool RefreshSnapshot();
 
-	/* Convert 1D array index to 2D grid coordinate */
-	FIntPoint IndexToGridCoord(int32 Index) const;
+	/* Request whichever style assets are still unloaded; repeats until the set is closed, then moves on to meshes */
+	void RequestStylePreload(FOnRoomAssetsPreloaded OnComplete);
 
-	/* Fill one edge with wall modules using greedy bin packing */
-	void FillWallEdge(EWallEdge Edge);
+	/* Request every mesh reachable from the (now loaded) style assets in a single batch */
+	void RequestMeshPreload(FOnRoomAssetsPreloaded OnComplete);
+
+	/* Snapshot RoomData and run GenerateAll on a worker task (called once the preload has finished) */
+	void LaunchGenerationJob(FOnRoomLayoutGenerated OnComplete);
 #pragma endregion
-	
-};
\ No newline at end of file
+};
@@ -4,8 +4,29 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Generators/Dungeon/DungeonGenerator.h"
+#include "Utilities/Spawners/DungeonSpawnerHelpers.h"
+#include "Spawners/Room/RoomSpawnScheduler.h"
 #include "DungeonSpawner.generated.h"
 
+class ADoorwayActor;
+class URoomGenerator;
+class UInstancedStaticMeshComponent;
+struct FPlacedDoorwayInfo;
+struct FDungeonRoomBuildResult;
+struct FDungeonCorridorBuildResult;
+
+// Fired on the game thread once GenerateDungeonAsync has spawned the dungeon (false if no room could be built)
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnDungeonSpawnComplete, bool, bSuccess);
+
+/**
+ * DungeonSpawner - Generates and spawns a whole dungeon
+ * UDungeonGenerator lays out the room graph; every room then runs its own FRoomGenerationCore job on the task graph
+ * (own seed, own grid and placement state, shared read-only snapshot), and the results are merged on the game thread
+ * into one set of instanced components per mesh. Corridors between the rooms' doorways are routed on another task
+ * alongside the rooms and merged the same way. In game worlds the merged dungeon is spawned through
+ * URoomSpawnScheduler under its frame budget.
+ */
 UCLASS()
 class CLAUDEDUNGAI_API ADungeonSpawner : public AActor
 {
@@ -15,11 +36,192 @@ public:
 	// Sets default values for this actor's properties
 	ADungeonSpawner();
 
+#pragma region Dungeon Generation Properties
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration")
+	FDungeonLayoutSettings LayoutSettings;
+
+	// Roll a new seed for each generate; the rolled value is written back to DungeonSeed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration")
+	bool bUseRandomSeed = true;
+
+	// Seed of the layout; every room's seed is derived from it (same seed + same settings = same dungeon)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration")
+	int32 DungeonSeed = 0;
+
+	// Generate the dungeon with GenerateDungeonAsync on BeginPlay
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration")
+	bool bGenerateOnBeginPlay = false;
+#pragma endregion
+
+#pragma region Instancing Properties
+	/* Spawn hierarchical instanced components (per-cluster culling); every room shares them, so this is on by default */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Instancing")
+	bool bUseHierarchicalInstancing = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Instancing")
+	FISMCategorySettings FloorInstanceSettings;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Instancing")
+	FISMCategorySettings WallInstanceSettings;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Instancing")
+	FISMCategorySettings CornerInstanceSettings;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Instancing")
+	FISMCategorySettings CeilingInstanceSettings;
+
+	/* Spawn the merged dungeon through the world's URoomSpawnScheduler (frame budgeted) instead of in one tick
+	 * Only applies in game worlds; editor worlds always spawn immediately */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Instancing")
+	bool bTimeSliceSpawning = true;
+
+	/* Instances written per ISM call while time slicing (smaller = finer budget control, more calls) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Instancing", meta = (ClampMin = "1", EditCondition = "bTimeSliceSpawning"))
+	int32 SpawnBatchSize = 64;
+
+	/* Route corridors between connected doorways (FDungeonCorridorRouter) and spawn their floor and walls */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Corridors")
+	bool bRouteCorridors = true;
+
+	/* One-cell floor tile placed on every corridor cell */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Corridors", meta = (EditCondition = "bRouteCorridors"))
+	TSoftObjectPtr<UStaticMesh> CorridorFloorMesh;
+
+	/* One-cell wall placed on every open corridor side (faces into the corridor like a room's edge walls) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dungeon Configuration|Corridors", meta = (EditCondition = "bRouteCorridors"))
+	TSoftObjectPtr<UStaticMesh> CorridorWallMesh;
+
+	/* Blueprint class to use for doorway actors (defaults to ADoorwayActor) */
+	UPROPERTY(EditAnywhere, Category = "Dungeon Configuration|Doorways")
+	TSubclassOf<ADoorwayActor> DoorwayActorClass;
+#pragma endregion
+
+#pragma region Runtime Generation
+	/* Lay out the dungeon, stream in every RoomData's assets, build all rooms concurrently on worker tasks, then spawn
+	 * the merged instances and doorway actors on the game thread. Returns false if a generation is already running
+	 * or the layout is empty. */
+	UFUNCTION(BlueprintCallable, Category = "Dungeon Generation")
+	bool GenerateDungeonAsync(int32 Seed, const FOnDungeonSpawnComplete& OnComplete);
+
+	/* True while a GenerateDungeonAsync request is preloading, building rooms or still spawning */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation")
+	bool IsGeneratingDungeon() const { return bGenerationPending || SpawnStage != ERoomSpawnStage::Done; }
+
+	/* Destroy spawned instances and doorway actors and drop the layout (an in-flight generation is discarded) */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Dungeon Generation")
+	void ClearDungeon();
+
+	/* Room graph of the last generation */
+	UFUNCTION(BlueprintPure, Category = "Dungeon Generation")
+	UDungeonGenerator* GetDungeonGenerator() const { return DungeonGenerator; }
+
+	/* Spawn queued work until Deadline (FPlatformTime::Seconds), at least one unit; true once the dungeon is complete
+	 * Called by URoomSpawnScheduler */
+	bool SpawnNextBatch(double Deadline);
+#pragma endregion
+
+#pragma region Editor Functions
+#if WITH_EDITOR
+	/* Generate and spawn the dungeon in the editor (seeded like BeginPlay: random or DungeonSeed) */
+	UFUNCTION(CallInEditor, Category = "Dungeon Generation")
+	void GenerateDungeon();
+#endif
+#pragma endregion
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+private:
+#pragma region Internal Data
+	UPROPERTY()
+	UDungeonGenerator* DungeonGenerator;
+
+	/* One generator per distinct RoomData, used for its batched asset preload (holds the handles) */
+	UPROPERTY()
+	TMap<URoomData*, URoomGenerator*> PreloadGenerators;
+
+	/* Merged instanced components, one per mesh and category across all rooms */
+	UPROPERTY()
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*> FloorMeshComponents;
+
+	UPROPERTY()
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*> WallMeshComponents;
+
+	UPROPERTY()
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*> CornerMeshComponents;
+
+	UPROPERTY()
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*> CeilingMeshComponents;
+
+	UPROPERTY()
+	TArray<ADoorwayActor*> SpawnedDoorwayActors;
+
+	// Incremented per request (and on clear); completions carrying an older id are dropped
+	int32 GenerationId;
+
+	// True from GenerateDungeonAsync until the rooms are spawned
+	bool bGenerationPending;
+
+	// RoomData preloads still outstanding for the current request
+	int32 PendingPreloads;
+
+	// FPlatformTime::Seconds() when the current request started
+	double GenerationStartTime;
+
+	// Merged output of the last generation, drained by SpawnNextBatch (or in one go when not time slicing)
+	FRoomMeshPalette SpawnPalette;
+	FMeshInstanceBuffers SpawnInstances[4];
+
+	// Room results the doorway actors come from (rooms that failed to generate are skipped)
+	TSharedPtr<TArray<FDungeonRoomBuildResult>> SpawnRoomResults;
+
+	// Time-sliced spawn cursor (SpawnStage == Done when nothing is pending)
+	ERoomSpawnStage SpawnStage;
+	bool bSpawnStageStarted;
+	int32 SpawnMeshId;
+	int32 SpawnInstanceIndex;
+	int32 SpawnRoomIndex;
+	int32 SpawnDoorwayIndex;
+	int32 SpawnedInstanceCount;
+	int32 SpawnedDoorwayCount;
+	bool bSpawnSucceeded;
+	FOnDungeonSpawnComplete PendingSpawnComplete;
+#pragma endregion
+
+#pragma region Internal Helpers
+	/* Counts down the preloads; the last one launches the room jobs */
+	void HandleRoomAssetsPreloaded(bool bAllLoaded, int32 RequestId, FOnDungeonSpawnComplete OnComplete);
+
+	/* Snapshot each distinct (RoomData, size) once, then launch one generation task per room plus the corridor task (game thread) */
+	void LaunchRoomJobs(int32 RequestId, FOnDungeonSpawnComplete OnComplete);
+
+	/* Merge every built room's and corridor instances, then spawn them and the doorway actors (now or through the scheduler) */
+	void HandleRoomsGenerated(int32 RequestId, TSharedRef<TArray<FDungeonRoomBuildResult>> Results,
+		TSharedRef<FDungeonCorridorBuildResult> CorridorResult, FOnDungeonSpawnComplete OnComplete);
+
+	/* Spawn one doorway actor; RoomOffset moves the room-space frame transform into spawner space */
+	bool SpawnDoorwayActor(const FPlacedDoorwayInfo& PlacedDoor, const FVector& RoomOffset);
+
+	void DestroyDoorwayActors();
+
+	/* Spawn every doorway actor of the rooms that built successfully; returns the number spawned */
+	int32 SpawnAllDoorwayActors();
+
+	/* Log the spawn, fire the pending completion and drop the merged buffers */
+	void CompleteDungeonSpawn();
+
+	/* Drop queued spawn work (its completion fires with false) */
+	void CancelTimeSlicedSpawn();
+
+	/* Move the spawn cursor to the start of the next stage */
+	void AdvanceSpawnStage();
+
+	/* Release the merged buffers and room results held for spawning */
+	void ResetSpawnState();
+
+	/* Drop the preload handles of every RoomData */
+	void ReleasePreloadedAssets();
+#pragma endregion
 };
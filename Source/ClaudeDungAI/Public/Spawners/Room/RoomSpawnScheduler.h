@@ -0,0 +1,55 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RoomSpawnScheduler.generated.h"
+
+class ARoomSpawner;
+class ADungeonSpawner;
+
+// Order time-sliced spawning works through a generated layout (floor and walls first, ceiling last)
+enum class ERoomSpawnStage : uint8 { Floor, Walls, Doorways, Corners, Ceiling, Done };
+
+/**
+ * RoomSpawnScheduler - Drains pending room spawns under a per-frame time budget
+ * Every ARoomSpawner (and ADungeonSpawner, for its merged rooms) with time-sliced spawning enqueues itself once its
+ * layout is generated. Each frame the queue is worked front to back (oldest request finishes first) until
+ * FrameBudgetMs is spent. Only the spawner at the head is guaranteed a unit per frame, so the queue always advances
+ * and a frame overshoots the budget by one instance batch or one actor at most; spawners behind it wait their turn.
+ */
+UCLASS(Config = Game)
+class CLAUDEDUNGAI_API URoomSpawnScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/* Wall-clock milliseconds per frame shared by every queued room */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Room Spawning", meta = (ClampMin = "0.1"))
+	float FrameBudgetMs = 2.0f;
+
+	/* Queue a spawner whose layout is ready (no-op if already queued) */
+	void Enqueue(ARoomSpawner* Spawner);
+	void Enqueue(ADungeonSpawner* Spawner);
+
+	/* Drop a spawner from the queue; whatever it already spawned stays */
+	void Cancel(ARoomSpawner* Spawner);
+	void Cancel(ADungeonSpawner* Spawner);
+
+	/* True while the spawner still has work queued */
+	bool IsQueued(const AActor* Spawner) const;
+
+	/* Queued spawners (a dungeon counts once) */
+	UFUNCTION(BlueprintPure, Category = "Room Spawning")
+	int32 GetNumQueuedRooms() const { return Queue.Num(); }
+
+	//~ FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override { return Queue.Num() > 0; }
+	virtual TStatId GetStatId() const override;
+
+private:
+	// Room or dungeon spawners with work left, oldest first
+	TArray<TWeakObjectPtr<AActor>> Queue;
+};
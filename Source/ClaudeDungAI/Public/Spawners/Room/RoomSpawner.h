@@ -7,16 +7,26 @@
 #include "Generators/Room/RoomGenerator.h"
 #include "Utilities/Debugging/DebugHelpers.h"
 #include "Data/Room/RoomData.h"
+#include "Utilities/Spawners/DungeonSpawnerHelpers.h"
+#include "Spawners/Room/RoomSpawnScheduler.h"
 #include "RoomSpawner.generated.h"
 
 class ADoorwayActor;
 class UWallData;
 class UTextRenderComponent;
 class UInstancedStaticMeshComponent;
+struct FPlacedDoorwayInfo;
+
+// Fired on the game thread once GenerateRoomAsync has spawned the room (false if generation failed)
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnRoomSpawnComplete, bool, bSuccess);
+
+// Broadcast after each time-sliced spawn step with the fraction of instances and actors spawned so far
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRoomSpawnProgress, float, Progress);
+
 /**
  * RoomSpawner - Actor responsible for spawning and visualizing rooms in the level
  * Holds RoomGenerator for logic and DebugHelpers for visualization
- * Provides CallInEditor functions for designer workflow
+ * Provides CallInEditor functions for designer workflow, and GenerateRoomAsync for packaged builds
  */
 UCLASS()
 class CLAUDEDUNGAI_API ARoomSpawner : public AActor
@@ -41,6 +51,69 @@ public:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration", meta = (ClampMin = "4", ClampMax = "50"))
 	FIntPoint RoomGridSize = FIntPoint(10, 10);
+
+	// Roll a new seed each time the grid is (re)created; the rolled value is written back to RoomSeed
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration")
+	bool bUseRandomSeed = true;
+
+	// Seed for every random choice in the room (same seed + same RoomData = same room)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration")
+	int32 RoomSeed = 0;
+
+	// Generate the room with GenerateRoomAsync on BeginPlay (seeded like the editor path: random or RoomSeed)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration")
+	bool bGenerateOnBeginPlay = false;
+#pragma endregion
+
+#pragma region Instancing Properties
+	/* Spawn hierarchical instanced components (per-cluster culling) instead of plain ISMs
+	 * Worth it once a level holds many rooms; changing it recreates components on the next generate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Instancing")
+	bool bUseHierarchicalInstancing = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Instancing")
+	FISMCategorySettings FloorInstanceSettings;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Instancing")
+	FISMCategorySettings WallInstanceSettings;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Instancing")
+	FISMCategorySettings CornerInstanceSettings;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Instancing")
+	FISMCategorySettings CeilingInstanceSettings;
+
+	/* Let GenerateRoomAsync spawn through the world's URoomSpawnScheduler (frame budgeted) instead of in one tick
+	 * Only applies in game worlds; editor worlds always spawn immediately */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Instancing")
+	bool bTimeSliceSpawning = true;
+
+	/* Instances written per ISM call while time slicing (smaller = finer budget control, more calls) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Room Configuration|Instancing", meta = (ClampMin = "1", EditCondition = "bTimeSliceSpawning"))
+	int32 SpawnBatchSize = 64;
+
+	UPROPERTY(BlueprintAssignable, Category = "Room Generation")
+	FOnRoomSpawnProgress OnSpawnProgress;
+#pragma endregion
+
+#pragma region Runtime Generation
+	/* Generate and spawn the whole room without editor code: assets stream in, the layout (grid, floor, doorways,
+	 * walls, corners, ceiling) is built on a worker task, then instances and doorway actors are spawned on the
+	 * game thread. No debug visualization is drawn. Returns false if a generation is already running. */
+	UFUNCTION(BlueprintCallable, Category = "Room Generation")
+	bool GenerateRoomAsync(int32 Seed, const FOnRoomSpawnComplete& OnComplete);
+
+	/* True while a GenerateRoomAsync request is generating or still spawning */
+	UFUNCTION(BlueprintPure, Category = "Room Generation")
+	bool IsGeneratingRoom() const;
+
+	/* Fraction of the current layout's instances and doorway actors spawned (1 when nothing is pending) */
+	UFUNCTION(BlueprintPure, Category = "Room Generation")
+	float GetSpawnProgress() const;
+
+	/* Spawn queued work until Deadline (FPlatformTime::Seconds), at least one unit; true once the room is complete
+	 * Called by URoomSpawnScheduler */
+	bool SpawnNextBatch(double Deadline);
 #pragma endregion
 
 #pragma region Editor Functions
@@ -127,6 +200,10 @@ public:
 	/* Check if room is generated */
 	bool IsRoomGenerated() const { return bIsGenerated; }
 
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
 
 	// Room generator instance (logic layer)
@@ -165,9 +242,40 @@ private:
 	TSubclassOf<ADoorwayActor> DoorwayActorClass;
 	
 	// Helper functions
-	void SpawnWallSegment(const FPlacedWallInfo& PlacedWall, const FVector& RoomOrigin);
+
+	/* Spawn one doorway actor per placed doorway; returns the number spawned */
+	int32 SpawnDoorwayActors(int32& OutSkipped);
+
+	/* Spawn and initialize the actor for one placed doorway (false if skipped) */
+	bool SpawnDoorwayActor(const FPlacedDoorwayInfo& PlacedDoor);
+
+	/* Destroy every spawned doorway actor */
+	void DestroyDoorwayActors();
+
+	/* GenerateRoomAsync completion: spawn the new layout (now or through the scheduler) and report back */
+	void HandleRoomLayoutGenerated(bool bSuccess, FOnRoomSpawnComplete OnComplete);
+
+	/* Mark the room spawned and fire OnComplete */
+	void CompleteRoomSpawn(FOnRoomSpawnComplete OnComplete);
+
+	/* Drop queued spawn work (its completion fires with false) */
+	void CancelTimeSlicedSpawn();
+
+	/* Move the spawn cursor to the start of the next stage */
+	void AdvanceSpawnStage();
+
+	// Time-sliced spawn cursor (SpawnStage == Done when nothing is pending)
+	ERoomSpawnStage SpawnStage;
+	bool bSpawnStageStarted;
+	int32 SpawnMeshId;
+	int32 SpawnInstanceIndex;
+	int32 SpawnDoorwayIndex;
+	int32 SpawnUnitsDone;
+	int32 SpawnUnitsTotal;
+	FOnRoomSpawnComplete PendingSpawnComplete;
 	
 #pragma region Debug Functions
+#if WITH_EDITOR
 	/* Update visualization based on current grid state */
 	void UpdateVisualization();
 
@@ -176,5 +284,6 @@ private:
 
 	/* Log floor statistics to output */
 	void LogFloorStatistics();
+#endif
 #pragma endregion
 };
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "Data/Grid/GridData.h"
 #include "DungeonGenerationHelpers.generated.h"
 
+class URoomData;
+
 /**
  * DungeonGenerationHelpers - Static utility functions for dungeon generation
  * 
@@ -31,6 +33,12 @@ class CLAUDEDUNGAI_API UDungeonGenerationHelpers : public UBlueprintFunctionLibr
 	 */
 	UFUNCTION(BlueprintPure, Category = "Dungeon Generation|Grid")
 	static TArray<FIntPoint> GetEdgeCellIndices(EWallEdge Edge, FIntPoint GridSize);
+
+	/* Number of cells along an edge (GetEdgeCellIndices(...).Num() without building the array) */
+	static int32 GetEdgeLength(EWallEdge Edge, FIntPoint GridSize);
+
+	/* Cell at Index along an edge (GetEdgeCellIndices(...)[Index] without building the array) */
+	static FIntPoint GetEdgeCell(EWallEdge Edge, int32 Index, FIntPoint GridSize);
 	
 
 	/**
@@ -131,6 +139,26 @@ class CLAUDEDUNGAI_API UDungeonGenerationHelpers : public UBlueprintFunctionLibr
 		const FString& ContextName,
 		bool bLogWarning = true);
 
+	// ========================================================================
+	// ASSET PRELOADING
+	// ========================================================================
+
+	/**
+	 * Collect the style data assets a room references (floor, wall, door, ceiling, preset and preset region styles)
+	 * Region styles are only reachable once the preset itself is loaded, so callers may need a second pass
+	 * @param RoomData - Room to walk
+	 * @param OutPaths - Unique soft paths (appended)
+	 */
+	static void CollectRoomStyleAssetPaths(const URoomData* RoomData, TArray<FSoftObjectPath>& OutPaths);
+
+	/**
+	 * Collect every mesh a room can place (tiles, wall layers, corners, door frames and side fills, clutter)
+	 * Walks loaded style assets only; anything still on disk is skipped
+	 * @param RoomData - Room to walk
+	 * @param OutPaths - Unique soft paths (appended)
+	 */
+	static void CollectRoomMeshPaths(const URoomData* RoomData, TArray<FSoftObjectPath>& OutPaths);
+
 	// ========================================================================
 	// SOCKET OPERATIONS
 	// ========================================================================
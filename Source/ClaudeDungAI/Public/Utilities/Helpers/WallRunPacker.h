@@ -0,0 +1,44 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/MemStack.h"
+
+/**
+ * WallRunPacker - Dynamic-programming cover of a straight run of wall cells by module footprints
+ * For every run length it stores the packing with the fewest uncovered cells and, among those, the fewest pieces
+ * (an exact cover with the fewest modules whenever one exists). Ties go to the larger footprint.
+ * The table depends only on the footprint set, so one packer answers every run length up to its memo size;
+ * EnsureLength extends it incrementally and keeps everything already solved.
+ */
+struct CLAUDEDUNGAI_API FWallRunPacker
+{
+public:
+	/* Set the footprint set (non-positive and duplicate values are ignored) and drop the memo */
+	void Build(TConstArrayView<int32> InFootprints);
+
+	/* Drop footprints and memo */
+	void Reset();
+
+	bool IsEmpty() const { return Footprints.Num() == 0; }
+
+	/* Longest run length currently memoized */
+	int32 GetMaxLength() const { return Choice.Num() - 1; }
+
+	/* Extend the memo to cover runs up to MaxLength */
+	void EnsureLength(int32 MaxLength);
+
+	/* Pieces for a run, in placement order (footprint, or 0 for one uncovered cell); returns the uncovered cell count
+	 * Runs longer than the memo are solved on a temporary extension (the memo itself is never mutated here) */
+	int32 Solve(int32 RunLength, TArray<int32, TMemStackAllocator<>>& OutPieces) const;
+
+private:
+	// Distinct positive footprints, largest first
+	TArray<int32> Footprints;
+
+	// Per run length: uncovered cells and piece count of the best packing, and the first piece of it (0 = gap)
+	TArray<int32> Holes;
+	TArray<int32> Pieces;
+	TArray<int32> Choice;
+};
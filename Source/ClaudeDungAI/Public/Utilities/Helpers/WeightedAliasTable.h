@@ -0,0 +1,50 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * WeightedAliasTable - Vose alias table for O(1) weighted random draws
+ * Built once per pool (O(n)), then every draw is one random number, one compare and at most one extra read.
+ * Draws return an index into the pool the table was built from, so callers never copy pool entries.
+ * Negative weights count as zero; a pool whose weights are all zero samples uniformly.
+ */
+struct CLAUDEDUNGAI_API FWeightedAliasTable
+{
+public:
+	/* Build from raw weights */
+	void Build(TConstArrayView<float> Weights);
+
+	/* Build from a pool, reading each entry's weight through GetWeight */
+	template<typename T, typename FuncType>
+	void BuildFromPool(const TArray<T>& Pool, FuncType GetWeight)
+	{
+		TArray<float, TInlineAllocator<32>> Weights;
+		Weights.Reserve(Pool.Num());
+		for (const T& Item : Pool) { Weights.Add(GetWeight(Item)); }
+		Build(Weights);
+	}
+
+	/* Drop the table */
+	void Reset();
+
+	int32 Num() const { return Probability.Num(); }
+	bool IsEmpty() const { return Probability.Num() == 0; }
+
+	/* Draw an index using the given stream (INDEX_NONE if empty) */
+	int32 Sample(const FRandomStream& Stream) const { return SampleFromUnit(Stream.FRand()); }
+
+	/* Draw an index using the global random generator (INDEX_NONE if empty) */
+	int32 Sample() const { return SampleFromUnit(FMath::FRand()); }
+
+	/* Draw an index from a uniform value in [0, 1) */
+	int32 SampleFromUnit(float Unit) const;
+
+private:
+	// Chance of keeping column i (scaled so the average column is 1)
+	TArray<float> Probability;
+
+	// Column to use instead of i when the keep test fails
+	TArray<int32> Alias;
+};
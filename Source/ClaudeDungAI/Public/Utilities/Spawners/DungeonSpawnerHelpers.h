@@ -5,8 +5,35 @@
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Components/InstancedStaticMeshComponent.h"
+#include "Data/Grid/RoomMeshPalette.h"
 #include "DungeonSpawnerHelpers.generated.h"
 
+
+/* Rendering/collision settings applied to every instanced component of one category (floor, wall, corner, ceiling) */
+USTRUCT(BlueprintType)
+struct FISMCategorySettings
+{
+	GENERATED_BODY()
+
+	/* Distance at which instances start fading out (0 = never) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Culling", meta = (ClampMin = "0"))
+	int32 StartCullDistance = 0;
+
+	/* Distance at which instances are fully culled (0 = never) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Culling", meta = (ClampMin = "0"))
+	int32 EndCullDistance = 0;
+
+	/* Scale applied to the mesh's LOD screen sizes for these instances (below 1 switches to lower LODs sooner) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "LOD", meta = (ClampMin = "0.001"))
+	float LODDistanceScale = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Rendering")
+	bool bCastShadows = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Collision")
+	TEnumAsByte<ECollisionEnabled::Type> CollisionEnabled = ECollisionEnabled::QueryAndPhysics;
+};
+
 /**
  * DungeonSpawnerHelpers - Static utility functions for mesh spawning
  * This library contains spawning-specific helper functions used across spawner systems.
@@ -26,10 +53,15 @@ public:
 	 * @param ComponentMap - Map tracking mesh → ISM component associations
 	 * @param ComponentNamePrefix - Prefix for component name (e.g., "FloorISM_", "WallISM_")
 	 * @param bLogWarnings - Whether to log warnings on failure
+	 * @param bHierarchical - Create a UHierarchicalInstancedStaticMeshComponent (per-cluster culling) instead of a plain ISM
+	 * @param Settings - Culling/LOD/shadow/collision settings applied to a newly created component
 	 * @return ISM component or nullptr if mesh failed to load */
 	static UInstancedStaticMeshComponent* GetOrCreateISMComponent( AActor* Owner,const TSoftObjectPtr<UStaticMesh>& MeshAsset,
 	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap,const FString& ComponentNamePrefix,
-	bool bLogWarnings = true);
+	bool bLogWarnings = true, bool bHierarchical = false, const FISMCategorySettings& Settings = FISMCategorySettings());
+
+	/* Apply category settings to an existing component (cheap; safe to call on every regenerate) */
+	static void ApplyISMCategorySettings(UInstancedStaticMeshComponent* ISMComponent, const FISMCategorySettings& Settings);
 
 	/*Clear all ISM components in a component map Destroys components and clears the map */
 	static void ClearISMComponentMap(TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap);
@@ -44,13 +76,50 @@ public:
 	static int32 SpawnMeshInstance( UInstancedStaticMeshComponent* ISMComponent, const FTransform& LocalTransform,
 	const FVector& WorldOffset);
 
-	/** Spawn multiple mesh instances from an array
+	/** Spawn multiple mesh instances from an array with a single AddInstances call (one render state update)
 	 * @param ISMComponent - Component to add instances to
 	 * @param LocalTransforms - Array of transforms in component/room space
 	 * @param WorldOffset - World offset to apply (typically actor location)
 	 * @return Number of instances successfully spawned */
 	static int32 SpawnMeshInstances(UInstancedStaticMeshComponent* ISMComponent, const TArray<FTransform>& LocalTransforms,
 	const FVector& WorldOffset);
+
+	/** Rewrite a component's instances in place: existing instances are moved, surplus ones removed, missing ones added
+	 * @param ISMComponent - Component to update
+	 * @param LocalTransforms - Full set of transforms the component should end up with (component/room space)
+	 * @param WorldOffset - World offset to apply (typically actor location)
+	 * @return Number of instances the component now holds */
+	static int32 UpdateMeshInstances(UInstancedStaticMeshComponent* ISMComponent, const TArray<FTransform>& LocalTransforms,
+	const FVector& WorldOffset);
+
+	/** Make a component map hold exactly the given instance buffers, reusing components whose mesh is still used
+	 * Components whose mesh no longer appears are destroyed; new meshes get a component created on demand
+	 * @param Owner - Actor that owns the components
+	 * @param Palette - Palette the buffers' mesh ids index into (consulted once per distinct mesh)
+	 * @param Buffers - Room-space transforms grouped by mesh id
+	 * @param ComponentMap - Map tracking mesh → ISM component associations
+	 * @param ComponentNamePrefix - Prefix for component names (e.g., "FloorISM_")
+	 * @param WorldOffset - World offset to apply (typically actor location)
+	 * @param bHierarchical - Component class to use; kept components of the other class are recreated
+	 * @param Settings - Culling/LOD/shadow/collision settings (re-applied to kept components too)
+	 * @return Number of instances successfully spawned */
+	static int32 SyncMeshInstanceBatches(AActor* Owner, const FRoomMeshPalette& Palette, const FMeshInstanceBuffers& Buffers,
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, const FString& ComponentNamePrefix,
+	const FVector& WorldOffset, bool bHierarchical = false, const FISMCategorySettings& Settings = FISMCategorySettings());
+
+	/* Destroy the components of a map whose mesh has no instances in Buffers or whose class does not match bHierarchical
+	 * (first step of SyncMeshInstanceBatches; time-sliced spawning runs it once per category) */
+	static void ReleaseUnusedISMComponents(const FRoomMeshPalette& Palette, const FMeshInstanceBuffers& Buffers,
+	TMap<TSoftObjectPtr<UStaticMesh>, UInstancedStaticMeshComponent*>& ComponentMap, bool bHierarchical);
+
+	/** Rewrite instances [StartIndex, StartIndex + Count) of a component from the same slice of LocalTransforms
+	 * Indices the component already has are moved in place, the rest are appended (one call each)
+	 * @return Number of instances written */
+	static int32 UpdateMeshInstanceRange(UInstancedStaticMeshComponent* ISMComponent, const TArray<FTransform>& LocalTransforms,
+	int32 StartIndex, int32 Count, const FVector& WorldOffset);
+
+	/* Remove instances past NumInstances from the back (finishes a sequence of UpdateMeshInstanceRange calls) */
+	static void TrimMeshInstances(UInstancedStaticMeshComponent* ISMComponent, int32 NumInstances);
   
 	// TRANSFORM UTILITIES
 	/** Convert local (component-space) transform to world transform